@@ -0,0 +1,532 @@
+#include "app.h"
+#include "bench.h"
+
+#include <nikola/nikola.h>
+
+#include <atomic>
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The sizes of the synthetic entity worlds to be updated.
+const nikola::sizei BENCH_WORLD_SIZES[] = {1024, 16384};
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// App
+struct nikola::App {
+  nikola::Window* window;
+
+  nikola::FilePath res_path;
+  nikola::FilePath output_path = "bench_results.json";
+
+  nikola::ResourceGroupID res_group_id;
+  nikola::ResourceID mesh_id, material_id;
+  nikola::ResourceID skeleton_id, animation_id;
+
+  // The first NBR file found of every resource type (if any)
+  nikola::HashMap<nikola::u16, nikola::FilePath> nbr_files;
+};
+/// App
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static const char* resource_type_name(const nikola::u16 type) {
+  switch(type) {
+    case nikola::RESOURCE_TYPE_TEXTURE:
+      return "texture";
+    case nikola::RESOURCE_TYPE_CUBEMAP:
+      return "cubemap";
+    case nikola::RESOURCE_TYPE_SHADER:
+      return "shader";
+    case nikola::RESOURCE_TYPE_MODEL:
+      return "model";
+    case nikola::RESOURCE_TYPE_SKELETON:
+      return "skeleton";
+    case nikola::RESOURCE_TYPE_ANIMATION:
+      return "animation";
+    case nikola::RESOURCE_TYPE_FONT:
+      return "font";
+    case nikola::RESOURCE_TYPE_AUDIO_BUFFER:
+      return "audio_buffer";
+    default:
+      return "invalid";
+  }
+}
+
+static void parse_args(nikola::App* app, const nikola::Args& args) {
+  app->res_path = nikola::filepath_append(nikola::filesystem_current_path(), "res");
+
+  for(nikola::sizei i = 1; i < args.size(); i++) {
+    if(args[i] == "--out" && (i + 1) < args.size()) {
+      app->output_path = args[++i];
+    }
+    else if(args[i] == "--res" && (i + 1) < args.size()) {
+      app->res_path = args[++i];
+    }
+  }
+}
+
+static void find_nbr_files(nikola::App* app) {
+  if(!nikola::filesystem_exists(app->res_path)) {
+    NIKOLA_LOG_WARN("Could not find the resources directory at \'%s\'. File benchmarks will be skipped", app->res_path.c_str());
+    return;
+  }
+
+  nikola::filesystem_directory_recurse_iterate(app->res_path, [&](const nikola::FilePath& base, const nikola::FilePath& path, void* user_data) {
+    if(nikola::filepath_is_dir(path) || nikola::filepath_extension(path) != ".nbr") {
+      return;
+    }
+
+    nikola::File file;
+    if(!nikola::file_open(&file, path.c_str(), (nikola::i32)(nikola::FILE_OPEN_READ | nikola::FILE_OPEN_BINARY))) {
+      return;
+    }
+
+    nikola::NBRHeader header;
+    nikola::file_read_bytes(file, &header);
+    nikola::file_close(file);
+
+    if(app->nbr_files.find(header.resource_type) == app->nbr_files.end()) {
+      app->nbr_files[header.resource_type] = path;
+    }
+  });
+}
+
+static void init_resources(nikola::App* app) {
+  app->res_group_id = nikola::resources_create_group("bench_res", app->res_path);
+
+  app->mesh_id     = nikola::resources_push_mesh(app->res_group_id, nikola::GEOMETRY_CUBE);
+  app->material_id = nikola::resources_push_material(app->res_group_id, nikola::MaterialDesc{});
+
+  // Animations are only benchmarked if there are any found
+
+  auto skeleton  = app->nbr_files.find(nikola::RESOURCE_TYPE_SKELETON);
+  auto animation = app->nbr_files.find(nikola::RESOURCE_TYPE_ANIMATION);
+
+  if(skeleton != app->nbr_files.end() && animation != app->nbr_files.end()) {
+    app->skeleton_id  = nikola::resources_push_skeleton(app->res_group_id, skeleton->second);
+    app->animation_id = nikola::resources_push_animation(app->res_group_id, animation->second);
+  }
+}
+
+static void free_valid(void* ptr) {
+  // Some NBR arrays are never allocated if they're empty
+  
+  if(ptr) {
+    nikola::memory_free(ptr);
+  }
+}
+
+static void free_nbr(const nikola::u16 type, void* nbr) {
+  switch(type) {
+    case nikola::RESOURCE_TYPE_TEXTURE:
+      free_valid(((nikola::NBRTexture*)nbr)->pixels);
+      break;
+    case nikola::RESOURCE_TYPE_CUBEMAP: {
+      nikola::NBRCubemap* cubemap = (nikola::NBRCubemap*)nbr;
+      for(nikola::sizei i = 0; i < cubemap->faces_count; i++) {
+        free_valid(cubemap->pixels[i]);
+      }
+    } break;
+    case nikola::RESOURCE_TYPE_SHADER: {
+      nikola::NBRShader* shader = (nikola::NBRShader*)nbr;
+      free_valid(shader->vertex_source);
+      free_valid(shader->pixel_source);
+      free_valid(shader->compute_source);
+    } break;
+    case nikola::RESOURCE_TYPE_MODEL: {
+      nikola::NBRModel* model = (nikola::NBRModel*)nbr;
+      for(nikola::sizei i = 0; i < model->meshes_count; i++) {
+        free_valid(model->meshes[i].vertices);
+        free_valid(model->meshes[i].indices);
+      }
+      for(nikola::sizei i = 0; i < model->textures_count; i++) {
+        free_valid(model->textures[i].pixels);
+      }
+
+      free_valid(model->meshes);
+      free_valid(model->materials);
+      free_valid(model->textures);
+    } break;
+    case nikola::RESOURCE_TYPE_SKELETON: {
+      nikola::NBRSkeleton* skeleton = (nikola::NBRSkeleton*)nbr;
+      for(nikola::sizei i = 0; i < skeleton->joints_count; i++) {
+        free_valid(skeleton->joints[i].children);
+      }
+
+      free_valid(skeleton->joints);
+    } break;
+    case nikola::RESOURCE_TYPE_ANIMATION: {
+      nikola::NBRAnimation* anim = (nikola::NBRAnimation*)nbr;
+      for(nikola::sizei i = 0; i < anim->tracks_count; i++) {
+        free_valid(anim->tracks[i].position_samples);
+        free_valid(anim->tracks[i].rotation_samples);
+        free_valid(anim->tracks[i].scale_samples);
+      }
+
+      free_valid(anim->tracks);
+    } break;
+    case nikola::RESOURCE_TYPE_FONT: {
+      nikola::NBRFont* font = (nikola::NBRFont*)nbr;
+      for(nikola::sizei i = 0; i < font->glyphs_count; i++) {
+        free_valid(font->glyphs[i].pixels);
+      }
+
+      free_valid(font->glyphs);
+    } break;
+    case nikola::RESOURCE_TYPE_AUDIO_BUFFER:
+      free_valid(((nikola::NBRAudio*)nbr)->samples);
+      break;
+    default:
+      break;
+  }
+}
+
+template<typename T>
+static void read_nbr_file(const nikola::FilePath& path, const nikola::u16 type) {
+  nikola::File file;
+  nikola::file_open(&file, path.c_str(), (nikola::i32)(nikola::FILE_OPEN_READ | nikola::FILE_OPEN_BINARY));
+
+  nikola::NBRHeader header;
+  nikola::file_read_bytes(file, &header);
+
+  T nbr = {};
+  nikola::file_read_bytes(file, &nbr);
+  nikola::file_close(file);
+
+  free_nbr(type, &nbr);
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Benchmarks
+
+static void bench_memory() {
+  const nikola::sizei sizes[] = {64, KiB(4), MiB(1)};
+
+  for(auto& size : sizes) {
+    bench_run("memory_allocate/" + std::to_string(size), 10000, [size](const nikola::sizei) {
+      void* ptr = nikola::memory_allocate(size);
+      nikola::memory_free(ptr);
+    });
+  }
+}
+
+static void bench_resources(nikola::App* app) {
+  bench_run("resources_get_mesh", 100000, [app](const nikola::sizei) {
+    nikola::Mesh* mesh = nikola::resources_get_mesh(app->mesh_id);
+    NIKOLA_ASSERT(mesh, "Invalid mesh");
+  });
+
+  bench_run("resources_get_material", 100000, [app](const nikola::sizei) {
+    nikola::Material* material = nikola::resources_get_material(app->material_id);
+    NIKOLA_ASSERT(material, "Invalid material");
+  });
+}
+
+static void bench_shader_context(nikola::App* app) {
+  nikola::GfxShaderDesc shader_desc = {
+    .vertex_source = R"(
+      #version 460 core
+
+      layout (location = 0) in vec3 a_position;
+
+      uniform mat4 u_model;
+
+      void main() {
+        gl_Position = u_model * vec4(a_position, 1.0);
+      }
+    )",
+
+    .pixel_source = R"(
+      #version 460 core
+
+      layout (location = 0) out vec4 frag_color;
+
+      uniform vec4 u_color;
+      uniform float u_values[16];
+
+      void main() {
+        frag_color = u_color * u_values[0];
+      }
+    )",
+  };
+
+  nikola::ResourceID shader_id  = nikola::resources_push_shader(app->res_group_id, shader_desc);
+  nikola::ResourceID context_id = nikola::resources_push_shader_context(app->res_group_id, shader_id);
+  nikola::ShaderContext* ctx    = nikola::resources_get_shader_context(context_id);
+
+  nikola::ShaderUniformID model_uniform = nikola::shader_context_cache_uniform(ctx, "u_model");
+  nikola::Mat4 model                    = nikola::Mat4(1.0f);
+
+  bench_run("shader_context_set_uniform/id_mat4", 100000, [&](const nikola::sizei) {
+    nikola::shader_context_set_uniform(ctx, model_uniform, model);
+  });
+
+  bench_run("shader_context_set_uniform/name_vec4", 100000, [&](const nikola::sizei) {
+    nikola::shader_context_set_uniform(ctx, "u_color", nikola::Vec4(1.0f));
+  });
+
+  nikola::f32 values[16] = {};
+  bench_run("shader_context_set_uniform_array/name_f32x16", 100000, [&](const nikola::sizei) {
+    nikola::shader_context_set_uniform_array(ctx, "u_values", values, 16);
+  });
+}
+
+static void bench_transforms() {
+  nikola::DynamicArray<nikola::Transform> transforms(4096);
+
+  bench_run("transform_apply", transforms.size(), [&](const nikola::sizei i) {
+    nikola::Transform& transform = transforms[i];
+
+    transform.position.x += 0.01f;
+    nikola::transform_apply(transform);
+  });
+
+  bench_run("transform_apply_batch/" + std::to_string(transforms.size()), 1000, [&](const nikola::sizei) {
+    nikola::transform_apply_batch(transforms.data(), transforms.size());
+  });
+
+  // Culling
+
+  nikola::Mat4 view_projection = nikola::mat4_perspective(nikola::DEG2RAD * 45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+  nikola::Frustum frustum      = nikola::frustum_create(view_projection);
+
+  nikola::DynamicArray<nikola::Vec4> spheres(4096);
+  nikola::DynamicArray<nikola::AABB> boxes(4096);
+  bool results[4096];
+
+  for(nikola::sizei i = 0; i < spheres.size(); i++) {
+    nikola::Vec3 position = nikola::Vec3((nikola::f32)(i % 64) - 32.0f, 0.0f, -(nikola::f32)(i / 64));
+
+    spheres[i] = nikola::Vec4(position, 0.5f);
+    boxes[i]   = nikola::AABB{.min = position - nikola::Vec3(0.5f), .max = position + nikola::Vec3(0.5f)};
+  }
+
+  bench_run("frustum_test_spheres/" + std::to_string(spheres.size()), 1000, [&](const nikola::sizei) {
+    nikola::frustum_test_spheres(frustum, spheres.data(), spheres.size(), results);
+  });
+
+  bench_run("frustum_test_aabbs/" + std::to_string(boxes.size()), 1000, [&](const nikola::sizei) {
+    nikola::frustum_test_aabbs(frustum, boxes.data(), boxes.size(), results);
+  });
+}
+
+static void bench_particles(nikola::App* app) {
+  nikola::ParticleEmitterDesc desc = {
+    .position    = nikola::Vec3(0.0f),
+    .velocity    = nikola::Vec3(0.0f, 1.0f, 0.0f),
+    .mesh_id     = app->mesh_id,
+    .material_id = app->material_id,
+    .lifetime    = 1000.0f,
+    .count       = nikola::PARTICLES_MAX,
+  };
+
+  // Way too big for the stack
+  nikola::ParticleEmitter* emitter = new nikola::ParticleEmitter{};
+
+  nikola::particle_emitter_create(emitter, desc);
+  nikola::particle_emitter_emit(*emitter);
+
+  bench_run("particle_emitter_update/" + std::to_string(nikola::PARTICLES_MAX), 1000, [emitter](const nikola::sizei) {
+    nikola::particle_emitter_update(*emitter, 1.0 / 60.0);
+  });
+
+  nikola::particle_emitter_destroy(*emitter);
+  delete emitter;
+}
+
+static void bench_animations(nikola::App* app) {
+  if(!RESOURCE_IS_VALID(app->skeleton_id) || !RESOURCE_IS_VALID(app->animation_id)) {
+    bench_skip("animation_sampler_update", "no skeleton or animation NBR files found");
+    return;
+  }
+
+  nikola::AnimationSampler* sampler = nikola::animation_sampler_create(app->skeleton_id, app->animation_id);
+
+  bench_run("animation_sampler_update", 10000, [sampler](const nikola::sizei) {
+    nikola::animation_sampler_update(sampler, 1.0f / 60.0f);
+  });
+
+  nikola::animation_sampler_destroy(sampler);
+}
+
+static void bench_entity_world(nikola::App* app) {
+  bool has_animations = RESOURCE_IS_VALID(app->skeleton_id) && RESOURCE_IS_VALID(app->animation_id);
+
+  for(auto& size : BENCH_WORLD_SIZES) {
+    nikola::EntityWorld world;
+
+    // Every entity gets a timer, while every 64th entity gets
+    // a particle emitter and an animation sampler (if possible).
+
+    for(nikola::sizei i = 0; i < size; i++) {
+      nikola::Vec3 position = nikola::Vec3((nikola::f32)(i % 128), 0.0f, (nikola::f32)(i / 128));
+      nikola::EntityID entt = nikola::entity_world_create_entity(world, position);
+
+      nikola::entity_add_timer(world, entt, 1.0f, false);
+
+      if((i % 64) != 0) {
+        continue;
+      }
+
+      nikola::ParticleEmitterDesc emitter_desc = {
+        .velocity    = nikola::Vec3(0.0f, 1.0f, 0.0f),
+        .mesh_id     = app->mesh_id,
+        .material_id = app->material_id,
+        .count       = 64,
+      };
+      nikola::entity_add_particle_emitter(world, entt, emitter_desc);
+
+      if(has_animations) {
+        nikola::entity_add_animation_sampler(world, entt, app->skeleton_id, app->animation_id);
+      }
+    }
+
+    bench_run("entity_world_update/" + std::to_string(size), 100, [&world](const nikola::sizei) {
+      nikola::entity_world_update(world, 1.0 / 60.0);
+    });
+
+    nikola::entity_world_clear(world);
+  }
+}
+
+static void bench_nbr_files(nikola::App* app) {
+  const nikola::u16 types[] = {
+    nikola::RESOURCE_TYPE_TEXTURE,
+    nikola::RESOURCE_TYPE_CUBEMAP,
+    nikola::RESOURCE_TYPE_SHADER,
+    nikola::RESOURCE_TYPE_MODEL,
+    nikola::RESOURCE_TYPE_SKELETON,
+    nikola::RESOURCE_TYPE_ANIMATION,
+    nikola::RESOURCE_TYPE_FONT,
+    nikola::RESOURCE_TYPE_AUDIO_BUFFER,
+  };
+
+  for(auto& type : types) {
+    nikola::String name = nikola::String("file_read_bytes/") + resource_type_name(type);
+
+    auto entry = app->nbr_files.find(type);
+    if(entry == app->nbr_files.end()) {
+      bench_skip(name, "no NBR file of this type found");
+      continue;
+    }
+
+    const nikola::FilePath& path = entry->second;
+
+    bench_run(name, 16, [&path, type](const nikola::sizei) {
+      switch(type) {
+        case nikola::RESOURCE_TYPE_TEXTURE:
+          read_nbr_file<nikola::NBRTexture>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_CUBEMAP:
+          read_nbr_file<nikola::NBRCubemap>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_SHADER:
+          read_nbr_file<nikola::NBRShader>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_MODEL:
+          read_nbr_file<nikola::NBRModel>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_SKELETON:
+          read_nbr_file<nikola::NBRSkeleton>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_ANIMATION:
+          read_nbr_file<nikola::NBRAnimation>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_FONT:
+          read_nbr_file<nikola::NBRFont>(path, type);
+          break;
+        case nikola::RESOURCE_TYPE_AUDIO_BUFFER:
+          read_nbr_file<nikola::NBRAudio>(path, type);
+          break;
+      }
+    });
+  }
+}
+
+static void bench_thread_pool() {
+  const nikola::sizei tasks_count = 256;
+
+  // Leave a core for the main thread, but always have at least one worker
+
+  nikola::sizei cores_count = (nikola::sizei)std::thread::hardware_concurrency();
+  nikola::sizei workers     = (cores_count > 1) ? (cores_count - 1) : 1;
+
+  nikola::ThreadPool pool;
+  nikola::thread_pool_create(&pool, "bench_pool", workers);
+
+  // Each iteration pushes a batch of tiny tasks and waits for
+  // all of them to finish, measuring the full round-trip.
+
+  std::atomic<nikola::sizei> done_count = 0;
+  bench_run("thread_pool_push_task/" + std::to_string(tasks_count), 100, [&](const nikola::sizei) {
+    done_count = 0;
+
+    for(nikola::sizei i = 0; i < tasks_count; i++) {
+      nikola::thread_pool_push_task(pool, [&done_count]() {
+        done_count.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+
+    while(done_count.load(std::memory_order_relaxed) < tasks_count) {
+      std::this_thread::yield();
+    }
+  });
+
+  nikola::thread_pool_destroy(pool);
+}
+
+/// Benchmarks
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// App functions
+
+nikola::App* app_init(const nikola::Args& args, nikola::Window* window) {
+  // App init
+  nikola::App* app = new nikola::App{};
+
+  // Window init
+  app->window = window;
+
+  // Resources init
+
+  parse_args(app, args);
+  find_nbr_files(app);
+  init_resources(app);
+
+  // Run all of the benchmarks
+
+  bench_memory();
+  bench_resources(app);
+  bench_shader_context(app);
+  bench_transforms();
+  bench_particles(app);
+  bench_animations(app);
+  bench_entity_world(app);
+  bench_nbr_files(app);
+  bench_thread_pool();
+
+  bench_write_json(app->output_path);
+
+  // There's nothing else to do, so we can just quit
+  nikola::event_dispatch(nikola::Event{.type = nikola::EVENT_APP_QUIT});
+
+  return app;
+}
+
+void app_shutdown(nikola::App* app) {
+  nikola::resources_destroy_group(app->res_group_id);
+  delete app;
+}
+
+/// App functions
+/// ----------------------------------------------------------------------
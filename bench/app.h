@@ -0,0 +1,13 @@
+#pragma once
+
+#include <nikola/nikola_base.h>
+#include <nikola/nikola_app.h>
+
+/// ----------------------------------------------------------------------
+/// App functions
+
+nikola::App* app_init(const nikola::Args& args, nikola::Window* window);
+void app_shutdown(nikola::App* app);
+
+/// App functions
+/// ----------------------------------------------------------------------
@@ -0,0 +1,143 @@
+#include "bench.h"
+
+#include <nikola/nikola_timer.h>
+
+#include <cstdio>
+
+/// ----------------------------------------------------------------------
+/// Bench
+struct Bench {
+  nikola::DynamicArray<BenchResult> results;
+};
+
+static Bench s_bench;
+/// Bench
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static nikola::f64 run_sample(const nikola::sizei iterations, const BenchFn& func) {
+  nikola::PerfTimer timer;
+
+  nikola::perf_timer_start(timer);
+  for(nikola::sizei i = 0; i < iterations; i++) {
+    func(i);
+  }
+  nikola::perf_timer_stop(timer);
+
+  // Milliseconds to nanoseconds per iteration
+  return ((nikola::f64)timer.to_milliseconds * 1000000.0) / (nikola::f64)iterations;
+}
+
+static nikola::String escape_string(const nikola::String& str) {
+  nikola::String result;
+  result.reserve(str.size());
+
+  for(auto& ch : str) {
+    if(ch == '\"' || ch == '\\') {
+      result += '\\';
+    }
+
+    result += ch;
+  }
+
+  return result;
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Bench functions
+
+void bench_run(const nikola::String& name, const nikola::sizei iterations, const BenchFn& func) {
+  NIKOLA_ASSERT((iterations > 0), "Cannot run a benchmark with zero iterations");
+
+  // Warm-up the caches first
+  run_sample(iterations, func);
+
+  // Take the samples
+
+  BenchResult result = {
+    .name       = name,
+    .iterations = iterations,
+    .min_ns     = nikola::FLOAT_MAX,
+  };
+
+  for(nikola::sizei i = 0; i < BENCH_SAMPLES_COUNT; i++) {
+    nikola::f64 sample = run_sample(iterations, func);
+
+    result.mean_ns += sample;
+    result.min_ns   = sample < result.min_ns ? sample : result.min_ns;
+    result.max_ns   = sample > result.max_ns ? sample : result.max_ns;
+  }
+
+  result.mean_ns /= (nikola::f64)BENCH_SAMPLES_COUNT;
+  s_bench.results.push_back(result);
+
+  NIKOLA_LOG_INFO("%-48s %12.2f ns/iter (min = %.2f, max = %.2f)",
+                  name.c_str(), result.mean_ns, result.min_ns, result.max_ns);
+}
+
+void bench_skip(const nikola::String& name, const nikola::String& reason) {
+  s_bench.results.push_back(BenchResult {
+    .name        = name,
+    .skip_reason = reason,
+  });
+
+  NIKOLA_LOG_WARN("%-48s skipped (%s)", name.c_str(), reason.c_str());
+}
+
+const nikola::DynamicArray<BenchResult>& bench_get_results() {
+  return s_bench.results;
+}
+
+bool bench_write_json(const nikola::FilePath& path) {
+  nikola::File file;
+  if(!nikola::file_open(&file, path.c_str(), (nikola::i32)(nikola::FILE_OPEN_WRITE | nikola::FILE_OPEN_TRUNCATE))) {
+    NIKOLA_LOG_ERROR("Could not open the benchmark results file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  nikola::String json = "{\n";
+  json += "  \"samples\": " + std::to_string(BENCH_SAMPLES_COUNT) + ",\n";
+  json += "  \"benchmarks\": [\n";
+
+  char line[512];
+  for(nikola::sizei i = 0; i < s_bench.results.size(); i++) {
+    const BenchResult& result = s_bench.results[i];
+    nikola::String name       = escape_string(result.name);
+
+    if(!result.skip_reason.empty()) {
+      std::snprintf(line, sizeof(line),
+                    "    {\"name\": \"%s\", \"skipped\": true, \"reason\": \"%s\"}",
+                    name.c_str(),
+                    escape_string(result.skip_reason).c_str());
+    }
+    else {
+      std::snprintf(line, sizeof(line),
+                    "    {\"name\": \"%s\", \"iterations\": %zu, \"mean_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f}",
+                    name.c_str(),
+                    result.iterations,
+                    result.mean_ns,
+                    result.min_ns,
+                    result.max_ns);
+    }
+
+    json += line;
+    json += (i == s_bench.results.size() - 1) ? "\n" : ",\n";
+  }
+
+  json += "  ]\n";
+  json += "}\n";
+
+  nikola::file_write_bytes(file, json.data(), json.size());
+  nikola::file_close(file);
+
+  NIKOLA_LOG_INFO("Wrote %zu benchmark results to \'%s\'", s_bench.results.size(), path.c_str());
+  return true;
+}
+
+/// Bench functions
+/// ----------------------------------------------------------------------
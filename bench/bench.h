@@ -0,0 +1,62 @@
+#pragma once
+
+#include <nikola/nikola_base.h>
+#include <nikola/nikola_containers.h>
+#include <nikola/nikola_file.h>
+
+#include <functional>
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of timed samples taken for every benchmark.
+/// The mean, min, and max are all computed from these samples.
+const nikola::sizei BENCH_SAMPLES_COUNT = 10;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// BenchFn
+using BenchFn = std::function<void(const nikola::sizei iteration)>;
+/// BenchFn
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// BenchResult
+struct BenchResult {
+  nikola::String name;
+  nikola::sizei iterations = 0;
+
+  // All of the timings are in nanoseconds per iteration
+
+  nikola::f64 mean_ns = 0.0;
+  nikola::f64 min_ns  = 0.0;
+  nikola::f64 max_ns  = 0.0;
+
+  // Only valid when the benchmark could not run
+  nikola::String skip_reason;
+};
+/// BenchResult
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Bench functions
+
+/// Run `func` for `iterations` times per sample, recording the results under `name`.
+///
+/// @NOTE: A single warm-up sample is run first and is never recorded.
+void bench_run(const nikola::String& name, const nikola::sizei iterations, const BenchFn& func);
+
+/// Record the benchmark `name` as skipped for the given `reason`.
+void bench_skip(const nikola::String& name, const nikola::String& reason);
+
+/// Retrieve all of the results recorded so far.
+const nikola::DynamicArray<BenchResult>& bench_get_results();
+
+/// Write all of the results recorded so far as JSON into the file at `path`,
+/// returning `true` on success and `false` otherwise.
+bool bench_write_json(const nikola::FilePath& path);
+
+/// Bench functions
+/// ----------------------------------------------------------------------
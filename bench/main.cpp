@@ -0,0 +1,34 @@
+#include <nikola/nikola_app.h>
+
+#include "app.h"
+
+// Yeah, unfortunate...
+#if NIKOLA_PLATFORM_WINDOWS == 1
+#include <windows.h>
+#endif
+
+int main(int argc, char** argv) {
+  // @NOTE: The GPU-backed resources (shaders, meshes, materials) still need
+  // a valid context. Hence, the window. It is closed right after the benchmarks run.
+
+  int win_flags = nikola::WINDOW_FLAGS_MINIMIZE;
+
+  nikola::AppDesc app_desc {
+    .init_fn     = app_init,
+    .shutdown_fn = app_shutdown,
+
+    .window_title  = "Nikola Bench",
+    .window_width  = 320,
+    .window_height = 240,
+    .window_flags  = win_flags,
+
+    .args_values = argv,
+    .args_count  = argc,
+  };
+
+  nikola::engine_init(app_desc);
+  nikola::engine_run();
+  nikola::engine_shutdown();
+
+  return 0;
+}
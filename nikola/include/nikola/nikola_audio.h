@@ -202,6 +202,9 @@ NIKOLA_API void audio_buffer_destroy(AudioBufferID& buffer);
 NIKOLA_API AudioBufferDesc& audio_buffer_get_desc(AudioBufferID& buffer);
 
 /// Update the data and parametars of `buffer` to the information provided in `desc`.
+///
+/// @NOTE: If `desc.data` is valid, the samples will be re-uploaded, and any sources 
+/// that have `buffer` queued will be stopped and have their buffers re-queued.
 NIKOLA_API void audio_buffer_update(AudioBufferID& buffer, const AudioBufferDesc& desc);
 
 /// AudioBuffer functions
@@ -85,7 +85,7 @@ using OnCollisionEnterFn = std::function<void(EntityWorld& world, EntityID& entt
 struct PhysicsComponent {
   /// The internal handle of the physics body, 
   /// to be used with `physics_body_*` functions.
-  PhysicsBody* body; 
+  PhysicsBodyID body; 
 
   /// A collision callback to be initiated once 
   /// the body is collided.
@@ -108,6 +108,42 @@ struct CharacterComponent {
 /// CharacterComponent
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// AnimationSamplerComponent
+struct AnimationSamplerComponent {
+  /// The index of the sampler in the pools of the world. 
+  /// Use `entity_get_animation_sampler` to retrieve the sampler itself.
+  ///
+  /// @NOTE: This is an internal variable and should NOT be changed!
+  u32 _index;
+};
+/// AnimationSamplerComponent
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// AnimationBlenderComponent
+struct AnimationBlenderComponent {
+  /// The index of the blender in the pools of the world. 
+  /// Use `entity_get_animation_blender` to retrieve the blender itself.
+  ///
+  /// @NOTE: This is an internal variable and should NOT be changed!
+  u32 _index;
+};
+/// AnimationBlenderComponent
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// UIContextComponent
+struct UIContextComponent {
+  /// The index of the UI context in the pools of the world. 
+  /// Use `entity_get_ui_context` to retrieve the context itself.
+  ///
+  /// @NOTE: This is an internal variable and should NOT be changed!
+  u32 _index;
+};
+/// UIContextComponent
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// RenderableComponent
 struct RenderableComponent {
@@ -146,9 +182,53 @@ struct InstancedRenderableComponent {
 /// InstancedRenderableComponent
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// HierarchyComponent
+struct HierarchyComponent {
+  /// The parent of the entity. 
+  ///
+  /// @NOTE: This is set to `ENTITY_NULL` for the roots of the hierarchy.
+  EntityID parent = ENTITY_NULL;
+
+  /// The children of the entity as an intrusive list, 
+  /// starting from `first_child` and linked through the siblings.
+
+  EntityID first_child  = ENTITY_NULL;
+  EntityID next_sibling = ENTITY_NULL;
+  EntityID prev_sibling = ENTITY_NULL;
+
+  /// The transform of the entity relative to its `parent`. 
+  ///
+  /// @NOTE: Roots do not use this. Their `Transform` component is 
+  /// their world transform, and can be changed freely.
+  Transform local;
+
+  /// How deep the entity is in the hierarchy (`0` for roots).
+  u32 depth = 0;
+
+  /// Set whenever `local` changes, so that the world transforms 
+  /// of the entity and its subtree get recomputed on the next update.
+  bool is_dirty = true;
+
+  /// The last world matrix the subtree was updated with.
+  Mat4 world_matrix = Mat4(1.0f);
+};
+/// HierarchyComponent
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// EntityWorld functions
 
+/// Initialize the state shared between all entity worlds, like the 
+/// worker threads used to update the components in parallel.
+///
+/// @NOTE: This is called by the engine on startup. If it was never called, 
+/// `entity_world_update` will just update everything on the calling thread.
+NIKOLA_API void entity_world_init();
+
+/// Shutdown the state shared between all entity worlds, joining any worker threads.
+NIKOLA_API void entity_world_shutdown();
+
 /// Clear (and thereby destroy) the given `world` of any 
 /// entities and their components.
 NIKOLA_API void entity_world_clear(EntityWorld& world);
@@ -160,12 +240,43 @@ NIKOLA_API EntityID entity_world_create_entity(EntityWorld& world,
                                                const Quat& rotation = Quat(1.0f, 0.0f, 0.0f, 0.0f), 
                                                const Vec3& scale    = Vec3(1.0f));
 
+/// Create `count` new entities in the given `world` in one go, and save them into `out_entities`. 
+/// All the entities will share the same `position`, `rotation`, and `scale` as their transform properties.
+///
+/// @NOTE: Instead of an `EVENT_ENTITY_ADDED` for each entity, a single `EVENT_ENTITIES_ADDED` 
+/// event is dispatched for the whole batch.
+///
+/// @NOTE: The `out_entities` array _MUST_ be able to hold at least `count` entities.
+NIKOLA_API void entity_world_create_entities(EntityWorld& world,
+                                             const sizei count,
+                                             EntityID* out_entities,
+                                             const Vec3& position = Vec3(0.0f), 
+                                             const Quat& rotation = Quat(1.0f, 0.0f, 0.0f, 0.0f), 
+                                             const Vec3& scale    = Vec3(1.0f));
+
 /// Destroy the given `entt` and remove it and its components from `world`.
+///
+/// @NOTE: Any children of `entt` will be destroyed as well.
 NIKOLA_API void entity_world_destroy_entity(EntityWorld& world, EntityID& entt);
 
+/// Destroy the given `entities` array of `count` elements and remove them and their components from `world` in one go.
+///
+/// @NOTE: Any children of the given `entities` will be destroyed as well. Entities 
+/// that are not valid anymore are skipped.
+///
+/// @NOTE: Instead of an `EVENT_ENTITY_DESTROYED` for each entity, a single `EVENT_ENTITIES_DESTROYED` 
+/// event is dispatched for the whole batch (children included), right before the entities are destroyed.
+NIKOLA_API void entity_world_destroy_entities(EntityWorld& world, const EntityID* entities, const sizei count);
+
 /// Update all the components of `world` in a data-oriented manner, using 
 /// `delta_time` as the time scale. 
 ///
+/// @NOTE: The animation components are updated in parallel on the worker threads. 
+///
+/// @NOTE: The world transforms of the children in the hierarchy are only recomputed 
+/// for dirty subtrees, one depth level at a time (in parallel as well). A subtree is 
+/// dirty if its root's `Transform` changed, or if `entity_set_local_transform` was called.
+///
 /// @NOTE: This function _MUST_ be called only once per frame. 
 NIKOLA_API void entity_world_update(EntityWorld& world, const f64 delta_time);
 
@@ -181,6 +292,33 @@ NIKOLA_API void entity_world_render(const EntityWorld& world);
 /// `ui_renderer_begin` and _BEFORE_ `ui_renderer_end`.
 NIKOLA_API void entity_world_render_ui(const EntityWorld& world);
 
+/// Save a binary snapshot of the entities of `world` into the file at `path`.
+/// Returns `false` if the file could not be opened.
+///
+/// The snapshot covers the `Transform`, `RenderableComponent`, `InstancedRenderableComponent`,
+/// `HierarchyComponent`, `PhysicsComponent`, `Timer`, `ParticleEmitter`, `AudioSourceID`,
+/// `AnimationSamplerComponent`, and `AnimationBlenderComponent` components. Each component array is
+/// written in one go rather than one entity at a time.
+///
+/// @NOTE: Resources are saved by their `ResourceID`. Therefore, the same resources _MUST_
+/// be loaded in the same order before calling `entity_world_load`.
+///
+/// @NOTE: The `coll_func` of a `PhysicsComponent`, the `CharacterComponent`, and the
+/// `UIContextComponent` components are _NOT_ saved, and need to be re-added after loading.
+NIKOLA_API bool entity_world_save(const EntityWorld& world, const FilePath& path);
+
+/// Load a snapshot saved with `entity_world_save` from the file at `path` into `world`.
+/// Returns `false` if the file could not be opened or is not a valid snapshot.
+///
+/// @NOTE: The loaded entities are _appended_ to `world` with new IDs, leaving any
+/// existing entities intact. This makes it possible to stream in sections of a level.
+///
+/// @NOTE: The physics bodies of the loaded entities are created and added
+/// to the physics world in one batch.
+///
+/// @NOTE: A single `EVENT_ENTITIES_ADDED` event is dispatched for all the loaded entities.
+NIKOLA_API bool entity_world_load(EntityWorld& world, const FilePath& path);
+
 /// EntityWorld functions
 /// ----------------------------------------------------------------------
 
@@ -200,6 +338,8 @@ NIKOLA_API void entity_add_component(EntityWorld& world, EntityID& entt, Args&&.
 /// @NOTE: The position, rotation, and user data of the given `desc` will be
 /// set inside the function using the transform of `entt` and its ID respectively.
 /// However, the rest of the memebers of `desc` must be filled by the caller.
+///
+/// @NOTE: If `coll_func` is given, the contact events of the body will be turned on.
 NIKOLA_API void entity_add_physics_body(EntityWorld& world, 
                                         EntityID& entt, 
                                         PhysicsBodyDesc& desc, 
@@ -272,6 +412,9 @@ NIKOLA_API void entity_add_animation_blender(EntityWorld& world, EntityID& entt,
 /// A helper function to add a renderable component to `entt`, using the given
 /// `renderable_type` to distinguish the render command, and `renderable_id` and `material_id`
 /// to give to the render command.
+///
+/// @NOTE: Both `renderable_id` and `material_id` are acquired (see `resources_acquire`), 
+/// and only released once `entt` is destroyed.
 NIKOLA_API void entity_add_renderable(EntityWorld& world, 
                                       EntityID& entt, 
                                       const EntityRenderableType renderable_type, 
@@ -289,6 +432,25 @@ NIKOLA_API void entity_add_instanced_renderable(EntityWorld& world,
                                                 const ResourceID& renderable_id, 
                                                 const ResourceID& material_id = {});
 
+/// Attach `entt` to `parent` in the given `world`, placing it at `local` relative to `parent`. 
+/// If `entt` already had a parent, it will be detached from it first.
+///
+/// From then on, the `Transform` of `entt` will be its world transform, recomputed 
+/// by `entity_world_update`. Use `entity_set_local_transform` to move it around.
+///
+/// @NOTE: The given `parent` _cannot_ be `entt` itself or any of its descendants.
+NIKOLA_API void entity_attach(EntityWorld& world, EntityID& entt, EntityID& parent, const Transform& local = Transform{});
+
+/// Detach `entt` from its parent in the given `world`, making it the root 
+/// of its own subtree. The current world transform of `entt` is kept as is.
+NIKOLA_API void entity_detach(EntityWorld& world, EntityID& entt);
+
+/// Set the transform of `entt` relative to its parent to `local`, marking 
+/// its subtree dirty in the given `world`.
+///
+/// @NOTE: If `entt` has no parent, its `Transform` will just be set to `local` instead.
+NIKOLA_API void entity_set_local_transform(EntityWorld& world, EntityID& entt, const Transform& local);
+
 /// Retrieve a reference to a generic component `Comp` from `entt` that lives in the given `world`.
 ///
 /// @NOTE: It is often advised to first use `entity_has_component` to first check 
@@ -307,6 +469,24 @@ NIKOLA_API const Comp& entity_get_component_const(const EntityWorld& world, cons
   return world.get<Comp>(entt);
 }
 
+/// Retrieve the animation sampler of `entt` that lives in the given `world`.
+///
+/// @NOTE: The given `entt` _MUST_ have an `AnimationSamplerComponent`, 
+/// added with `entity_add_animation_sampler`.
+NIKOLA_API AnimationSampler* entity_get_animation_sampler(EntityWorld& world, EntityID& entt);
+
+/// Retrieve the animation blender of `entt` that lives in the given `world`.
+///
+/// @NOTE: The given `entt` _MUST_ have an `AnimationBlenderComponent`, 
+/// added with `entity_add_animation_blender`.
+NIKOLA_API AnimationBlender* entity_get_animation_blender(EntityWorld& world, EntityID& entt);
+
+/// Retrieve the UI context of `entt` that lives in the given `world`.
+///
+/// @NOTE: The given `entt` _MUST_ have a `UIContextComponent`, 
+/// added with `entity_add_ui_context`.
+NIKOLA_API UIContext* entity_get_ui_context(EntityWorld& world, EntityID& entt);
+
 /// Return true if the given `Comp` component type currently exists in 
 /// the given `entt` that lives in `world`.
 template<typename Comp>
@@ -90,6 +90,11 @@ enum EventType {
 
   EVENT_PHYSICS_BODY_ACTIVATED,
   EVENT_PHYSICS_BODY_DEACTIVATED,
+
+  /// @NOTE: Only bodies with contact events enabled generate these, and either of 
+  /// the bodies in `Event::collision_data` might be invalid (a character, or a 
+  /// body destroyed before `EVENT_PHYSICS_CONTACT_REMOVED` came around).
+  
   EVENT_PHYSICS_CONTACT_ADDED,
   EVENT_PHYSICS_CONTACT_REMOVED,
   EVENT_PHYSICS_CONTACT_PERSISTED,
@@ -99,6 +104,8 @@ enum EventType {
   
   EVENT_ENTITY_ADDED, 
   EVENT_ENTITY_DESTROYED,
+  EVENT_ENTITIES_ADDED, 
+  EVENT_ENTITIES_DESTROYED,
 
   EVENTS_MAX,
 };
@@ -176,11 +183,14 @@ struct Event {
   /// The physics body that was given to this event 
   /// by either `EVENT_PHYSICS_BODY_ACTIVATED` or 
   /// `EVENT_PHYSICS_BODY_DEACTIVATED`.
-  PhysicsBody* body;
+  PhysicsBodyID body;
 
   /// The collision data given to this event 
   /// by either `EVENT_PHYSICS_CONTACT_ADDED`,
   /// `EVENT_PHYSICS_CONTACT_REMOVED`, or `EVENT_PHYSICS_CONTACT_PERSISTED`.
+  ///
+  /// @NOTE: The bodies in the collision data are not guaranteed to be valid 
+  /// (see `CollisionData`). The events are dispatched once per body pair after the step.
   CollisionData collision_data;
 
   /// The ray cast result given to this event 
@@ -190,6 +200,15 @@ struct Event {
   /// The entity ID given to this event by 
   /// either `EVENT_ENTITY_ADDED` or `EVENT_ENTITY_DESTROYED`.
   u32 entt_id;
+
+  /// The array of entity IDs given to this event by 
+  /// either `EVENT_ENTITIES_ADDED` or `EVENT_ENTITIES_DESTROYED`.
+  ///
+  /// @NOTE: The array is only valid for the duration of the dispatch.
+  const u32* entt_ids;
+
+  /// The amount of entity IDs in `entt_ids`.
+  sizei entts_count;
 };
 /// Event
 ///---------------------------------------------------------------------------------------------------------------------
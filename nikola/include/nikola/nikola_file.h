@@ -20,7 +20,7 @@ struct SpotLight;
 struct FrameData;
 struct Timer;
 
-struct PhysicsBody;
+struct PhysicsBodyID;
 struct PhysicsBodyDesc;
 struct Collider;
 struct ColliderDesc;
@@ -156,6 +156,17 @@ NIKOLA_API void filewatcher_add_file(const FilePath& path, const FileWatchFunc&
 /// Add all the files at `dir` to the file watcher, with `callback` to be invoked later, passing in `user_data`. 
 NIKOLA_API void filewatcher_add_dir(const FilePath& dir, const FileWatchFunc& callback, const void* user_data);
 
+/// Dispatch any events collected by the file watcher since the last call, invoking 
+/// the appropriate callbacks on the calling thread.
+///
+/// @NOTE: Events of the same file are coalesced together and only get dispatched 
+/// once the file has not been touched for a short while. This function is called 
+/// once per frame by the engine.
+NIKOLA_API void filewatcher_update();
+
+/// Stop watching all the files and directories previously added to the file watcher.
+NIKOLA_API void filewatcher_shutdown();
+
 /// Filewatcher functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -370,10 +381,10 @@ NIKOLA_API void file_write_bytes(File& file, const AudioListenerDesc& listener_d
 /// @NOTE: This function will raise an error if `file` is not opened.
 NIKOLA_API void file_write_bytes(File& file, const Timer& timer);
 
-/// Write the contents of the given `body` into `file`.
+/// Write the contents of the given `body` (including its collider) into `file`.
 ///
 /// @NOTE: This function will raise an error if `file` is not opened.
-NIKOLA_API void file_write_bytes(File& file, const PhysicsBody* body);
+NIKOLA_API void file_write_bytes(File& file, const PhysicsBodyID& body);
 
 /// Write the given `string` into `file` as a string representation.
 ///
@@ -450,8 +461,14 @@ NIKOLA_API void file_read_bytes(File& file, Timer* timer);
 
 /// Read a `PhysicsBodyDesc` from `file` and save it into `body_desc`.
 ///
+/// @NOTE: A new `Collider` will be created from the read extents 
+/// and assigned to `body_desc->collider`.
+///
+/// @NOTE: If the stored collider type is unknown (a corrupt or newer file, for example), 
+/// the function will log an error, leave `body_desc->collider` as `nullptr`, and return `false`.
+///
 /// @NOTE: This function will raise an error if `file` is not opened.
-NIKOLA_API void file_read_bytes(File& file, PhysicsBodyDesc* body_desc);
+NIKOLA_API bool file_read_bytes(File& file, PhysicsBodyDesc* body_desc);
 
 /// Read the WHOLE `file` as a `String` and save it into `str`.
 ///
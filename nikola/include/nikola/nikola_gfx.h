@@ -48,6 +48,14 @@ const sizei RENDER_TARGETS_MAX               = 8;
 /// The maximum number of render targets to be bound at once.
 const sizei MAX_COMPUTE_WORK_GROUPS_COUNT    = 65535;
 
+/// The number of frame regions a `GFX_BUFFER_USAGE_STREAM` buffer is split into. 
+/// This is also the number of frames the CPU can get ahead of the GPU.
+const sizei STREAM_BUFFER_REGIONS_MAX        = 3;
+
+/// The number of frames a `GfxQuery` keeps in flight before its results are read back.
+/// Results are never waited on. Hence, they always arrive this many frames late (at most).
+const sizei QUERY_FRAMES_MAX                 = STREAM_BUFFER_REGIONS_MAX + 1;
+
 // Consts
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -261,6 +269,16 @@ enum GfxBufferUsage {
   /// Set the buffer to be statically read from.
   /// This will be used for reading from the buffer once or rarely.
   GFX_BUFFER_USAGE_STATIC_READ  = 4 << 3,
+
+  /// Set the buffer to be rewritten every frame.
+  /// 
+  /// The buffer will be persistently mapped and split into `STREAM_BUFFER_REGIONS_MAX` 
+  /// regions (each of `GfxBufferDesc.size` bytes). Every frame writes into its own region, 
+  /// which is guarded by a fence, so uploads never wait on the driver.
+  ///
+  /// @NOTE: Index buffers cannot be streamed, since the element 
+  /// binding of a pipeline has no offset.
+  GFX_BUFFER_USAGE_STREAM       = 4 << 4,
 };
 /// GfxBufferUsage
 ///---------------------------------------------------------------------------------------------------------------------
@@ -683,6 +701,24 @@ enum GfxMemoryBarrierType {
 /// GfxMemoryBarrierType
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQueryType
+enum GfxQueryType {
+  /// Measure the GPU time between `gfx_query_begin` and `gfx_query_end`.
+  ///
+  /// @NOTE: Only one query of this type can be active at a time. 
+  /// They cannot be nested.
+  GFX_QUERY_TIME_ELAPSED = 0,
+
+  /// Record a GPU timestamp at both `gfx_query_begin` and `gfx_query_end`, 
+  /// measuring the time in between. 
+  ///
+  /// @NOTE: Queries of this type can be freely nested.
+  GFX_QUERY_TIMESTAMP,
+};
+/// GfxQueryType
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxContext
 struct GfxContext; 
@@ -725,6 +761,12 @@ struct GfxPipeline;
 /// GfxPipeline
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQuery
+struct GfxQuery;
+/// GfxQuery
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxDepthDesc
 struct GfxDepthDesc {
@@ -909,6 +951,8 @@ struct GfxBufferDesc {
   void* data = nullptr; 
 
   /// The size of `data` in bytes.
+  ///
+  /// @NOTE: For `GFX_BUFFER_USAGE_STREAM` buffers, this is the size of _one_ frame region.
   sizei size;
   
   /// Notify the type of the buffer to the GPU.
@@ -1234,6 +1278,32 @@ struct GfxDrawCommandIndirect {
 /// GfxDrawCommandIndirect
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxContextStats
+struct GfxContextStats {
+  /// The number of state changes (binds, enables, 
+  /// state functions, etc.) that were sent to the driver.
+  u32 state_calls  = 0; 
+
+  /// The number of state changes that were skipped 
+  /// since the context was already in the requested state.
+  u32 elided_calls = 0;
+
+  /// The number of draw calls issued.
+  u32 draw_calls   = 0;
+
+  /// The (approximate) number of triangles submitted. 
+  ///
+  /// @NOTE: Indirect draws are counted when their commands get 
+  /// uploaded via `gfx_buffer_upload_data`.
+  u64 triangles      = 0;
+
+  /// The number of bytes uploaded via `gfx_buffer_upload_data`.
+  u64 uploaded_bytes = 0;
+};
+/// GfxContextStats
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Context functions 
 
@@ -1269,6 +1339,21 @@ NIKOLA_API GfxContextDesc& gfx_context_get_desc(GfxContext* gfx);
 /// Check whether the given `ext` extension is supported in the current enviornment.
 NIKOLA_API bool gfx_context_has_extension(GfxContext* gfx, const char* ext); 
 
+/// Retrieve the index of the frame region the stream buffers of `gfx` are currently written into. 
+///
+/// @NOTE: This changes at every call to `gfx_context_present`.
+NIKOLA_API const u32 gfx_context_get_stream_region(GfxContext* gfx);
+
+/// Block until the GPU is done with every command submitted to `gfx` so far.
+///
+/// @NOTE: This is a full stall. Use it sparingly.
+NIKOLA_API void gfx_context_wait_idle(GfxContext* gfx);
+
+/// Retrieve the `GfxContextStats` of the last frame presented by `gfx`. 
+///
+/// @NOTE: The stats are reset at every call to `gfx_context_present`.
+NIKOLA_API const GfxContextStats& gfx_context_get_stats(GfxContext* gfx);
+
 /// Set any `state` of the context `gfx` to `value`. 
 /// i.e, this function can turn on or off the `state` in the given `gfx` context.
 NIKOLA_API void gfx_context_set_state(GfxContext* gfx, const GfxStates state, const bool value);
@@ -1338,7 +1423,7 @@ NIKOLA_API void gfx_context_draw_instanced(GfxContext* gfx, const u32 start_elem
 /// Draw the currently bound `GfxPipeline` object of `gfx` as an indirect call, using a buffer with a 
 /// type of `GFX_BUFFER_DRAW_INDIRECT` populated with `GfxDrawCommandIndirect` objects. 
 ///
-/// The given `offset` will be used to offset into the vertex buffer or the index buffer. 
+/// The given `offset` is the offset (in bytes) of the first `GfxDrawCommandIndirect` in the buffer. 
 /// The given `count` signifies the number of `GfxDrawCommandIndirect` objects in the buffer. 
 /// The given `stride` represents the distance between each `GfxDrawCommandIndirect` object in the buffer. 
 /// By default, the `stride` parametar is set to `0` to provide a packed buffer of draw commands.
@@ -1358,6 +1443,9 @@ NIKOLA_API void gfx_context_dispatch(GfxContext* gfx, const u32 work_group_x, co
 NIKOLA_API void gfx_context_memory_barrier(GfxContext* gfx, const i32 barrier_bits); 
 
 /// Switch to the back buffer or, rather, present the back buffer to the screen. 
+///
+/// This will also move every `GFX_BUFFER_USAGE_STREAM` buffer to its next 
+/// frame region, waiting (if needed) until the GPU is done reading from it.
 /// 
 /// @NOTE: This function will be affected by vsync. 
 NIKOLA_API void gfx_context_present(GfxContext* gfx);
@@ -1401,6 +1489,12 @@ NIKOLA_API GfxFramebufferDesc& gfx_framebuffer_get_desc(GfxFramebuffer* framebuf
 /// render targets in `desc`.
 NIKOLA_API void gfx_framebuffer_update(GfxFramebuffer* framebuffer, const GfxFramebufferDesc& desc);
 
+/// Attach only the given `layer` of every array render target in `framebuffer`, 
+/// leaving any non-array targets untouched. 
+///
+/// @NOTE: Array render targets are attached at layer `0` by default.
+NIKOLA_API void gfx_framebuffer_set_layer(GfxFramebuffer* framebuffer, const u32 layer);
+
 /// Framebuffer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -1436,6 +1530,9 @@ NIKOLA_API void gfx_buffer_update(GfxBuffer* buff, const GfxBufferDesc& desc);
 
 /// Update the contents of `buff` starting at `offset` with `data` of size `size`.
 /// 
+/// If `buff` was created with `GFX_BUFFER_USAGE_STREAM`, the data will be copied 
+/// directly into the region of the current frame, and `offset` will be relative to that region.
+///
 /// @NOTE: If the `offset + size` is > `GfxBuffer.size`, this function will assert.
 NIKOLA_API void gfx_buffer_upload_data(GfxBuffer* buff, const sizei offset, const sizei size, const void* data);
 
@@ -1596,6 +1693,40 @@ NIKOLA_API GfxPipelineDesc& gfx_pipeline_get_desc(GfxPipeline* pipeline);
 /// Pipeline functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Query functions 
+
+/// Allocate using the `alloc_fn` callback and return a `GfxQuery` object of the given `type`.
+///
+/// @NOTE: The `alloc_fn` uses the default memory allocater.
+NIKOLA_API GfxQuery* gfx_query_create(GfxContext* gfx, const GfxQueryType type, const AllocateMemoryFn& alloc_fn = memory_allocate);
+
+/// Free/reclaim any memory taken by `query` using the `free_fn` callback.
+///
+/// @NOTE: The `free_fn` uses the default memory allocater.
+NIKOLA_API void gfx_query_destroy(GfxQuery* query, const FreeMemoryFn& free_fn = memory_free);
+
+/// Start measuring the GPU commands issued after this call with `query`.
+///
+/// @NOTE: Every `query` rotates between `QUERY_FRAMES_MAX` internal queries. If the oldest 
+/// one still has not finished on the GPU, this measurement will be skipped rather than stalling.
+NIKOLA_API void gfx_query_begin(GfxQuery* query);
+
+/// Stop measuring the GPU commands with `query`.
+NIKOLA_API void gfx_query_end(GfxQuery* query);
+
+/// Retrieve the latest available GPU time (in milliseconds) measured by `query`.
+///
+/// @NOTE: This function never waits on the GPU. The result is a few frames 
+/// old, and it will be `0` until the first measurement is available.
+NIKOLA_API const f64 gfx_query_get_elapsed(GfxQuery* query);
+
+/// Retrieve the `GfxQueryType` of `query`.
+NIKOLA_API const GfxQueryType gfx_query_get_type(GfxQuery* query);
+
+/// Query functions 
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Graphics ***
 /// ---------------------------------------------------------------------
 
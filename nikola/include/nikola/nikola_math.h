@@ -171,6 +171,25 @@ struct Transform {
 /// Transform
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// AABB
+struct AABB {
+  Vec3 min = Vec3(0.0f);
+  Vec3 max = Vec3(0.0f);
+};
+/// AABB
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Frustum
+struct Frustum {
+  /// The left, right, bottom, top, near, and far planes (in that order), 
+  /// with the normal in `xyz` pointing inwards and the distance in `w`.
+  Vec4 planes[6];
+};
+/// Frustum
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Vertex3D
 struct Vertex3D {
@@ -629,6 +648,59 @@ NIKOLA_API bool point_in_circle(const Vec2& point, const Vec2& position, const f
 /// Point functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Frustum functions
+
+/// Extract the planes of the frustum described by the given `view_projection` matrix.
+NIKOLA_API const Frustum frustum_create(const Mat4& view_projection);
+
+/// Check if the sphere centered at `center` with `radius` radius is (even partially) inside `frustum`.
+NIKOLA_API const bool frustum_contains_sphere(const Frustum& frustum, const Vec3& center, const f32 radius);
+
+/// Check if the given `aabb` is (even partially) inside `frustum`.
+NIKOLA_API const bool frustum_contains_aabb(const Frustum& frustum, const AABB& aabb);
+
+/// Frustum functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Batch functions
+
+// @NOTE: These functions work on whole arrays at a time using the SIMD registers, 
+// handling 4 elements at once with SSE (or 8 elements with AVX, where it helps, when built with `NIKOLA_ENABLE_AVX2`). 
+// Any leftover elements, as well as any platform without SIMD support, 
+// go through the regular single-element functions instead.
+
+/// Apply the transformation of each of the `count` transforms in `transforms`. 
+/// This has the same result as calling `transform_apply` on each one.
+NIKOLA_API void transform_apply_batch(Transform* transforms, const sizei count);
+
+/// Transform each of the `count` boxes in `boxes` by its respective matrix in `matrices`, 
+/// and save the axis-aligned bounds of the result into `out_boxes`.
+///
+/// @NOTE: The `out_boxes` array can be the same as the `boxes` array.
+NIKOLA_API void aabb_transform_batch(const AABB* boxes, const Mat4* matrices, AABB* out_boxes, const sizei count);
+
+/// Test each of the `count` spheres in `spheres` against `frustum`, saving the results into `out_results`. 
+/// Each sphere is given as its center in `xyz` and its radius in `w`.
+NIKOLA_API void frustum_test_spheres(const Frustum& frustum, const Vec4* spheres, const sizei count, bool* out_results);
+
+/// Test each of the `count` boxes in `boxes` against `frustum`, saving the results into `out_results`. 
+NIKOLA_API void frustum_test_aabbs(const Frustum& frustum, const AABB* boxes, const sizei count, bool* out_results);
+
+/// Normalize each of the `count` quaternions in `quats` in place.
+NIKOLA_API void quat_normalize_batch(Quat* quats, const sizei count);
+
+/// Spherically interpolate between each of the `count` quaternions in `starts` and its 
+/// respective quaternion in `ends` by `amount`, saving the result into `out_quats`. 
+/// This has the same result as calling `quat_slerp` on each pair.
+///
+/// @NOTE: The `out_quats` array can be the same as either the `starts` or `ends` arrays.
+NIKOLA_API void quat_slerp_batch(const Quat* starts, const Quat* ends, const f32 amount, Quat* out_quats, const sizei count);
+
+/// Batch functions
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Math ***
 /// ----------------------------------------------------------------------
 
@@ -10,6 +10,8 @@
 #include <random>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <queue>
 #include <stack>
 #include <deque>
@@ -149,9 +149,20 @@ enum GroundState {
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
-/// PhysicsBody
-struct PhysicsBody;
-/// PhysicsBody
+/// PhysicsBodyID
+struct PhysicsBodyID {
+  //
+  // @NOTE: These are internal variables and should NOT be changed!
+  //
+
+  /// The index of the body's slot in the physics world.
+  u32 _id         = PHYSICS_ID_INVALID;
+
+  /// The generation of the slot `_id` at the time of the body's creation. 
+  /// This is used to catch stale IDs of bodies that were already destroyed.
+  u32 _generation = 0;
+};
+/// PhysicsBodyID
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -176,9 +187,13 @@ using PhysicsBatchHandle = void*;
 /// CollisionData
 struct CollisionData {
   /// The physics body that were involved in the collision.
+  ///
+  /// @NOTE: Either of these might NOT be a valid body. Characters are not physics bodies, 
+  /// and a body could be destroyed before its `EVENT_PHYSICS_CONTACT_REMOVED` event 
+  /// is dispatched. Always check with `physics_body_is_valid` before using them.
   
-  PhysicsBody* body1;
-  PhysicsBody* body2; 
+  PhysicsBodyID body1;
+  PhysicsBodyID body2; 
 
   /// An offset to which all contacts are relative to.
   Vec3 base_offset      = Vec3(0.0f);
@@ -221,7 +236,7 @@ struct RayCastDesc {
 /// RayCastResult
 struct RayCastResult {
   /// The body that was hit by the ray.
-  PhysicsBody* body  = {};
+  PhysicsBodyID body = {};
 
   /// The exact point in world space of the hit point.
   Vec3 point         = Vec3(0.0f);
@@ -348,6 +363,14 @@ struct PhysicsBodyDesc {
   ///
   /// @NOTE: By default, this value is set to `false`.
   bool is_sensor = false;    
+
+  /// If this flag is set to `true`, the body will generate the 
+  /// `EVENT_PHYSICS_CONTACT_ADDED`, `EVENT_PHYSICS_CONTACT_PERSISTED`, 
+  /// and `EVENT_PHYSICS_CONTACT_REMOVED` events. A contact between two 
+  /// bodies is reported if either one of them has this flag set.
+  ///
+  /// @NOTE: By default, this value is set to `false`.
+  bool has_contact_events = false;
 };
 /// PhysicsBodyDesc
 ///---------------------------------------------------------------------------------------------------------------------
@@ -454,6 +477,9 @@ NIKOLA_API void physics_world_shutdown();
 /// which consists of collision detection followed by numerical integration.
 /// The higher the value, the more accurate the physics is, but the more performance will suffer.
 ///
+/// @NOTE: The contact events are gathered during the step, with one event per body pair 
+/// and event type, and only dispatched on the calling thread once the step is done.
+///
 /// @NOTE: The `collision_steps` parametar is set to `1` by default.
 NIKOLA_API void physics_world_step(const f32 delta_time, const i32 collision_steps = 1);
 
@@ -464,49 +490,61 @@ NIKOLA_API void physics_world_step(const f32 delta_time, const i32 collision_ste
 /// have been added. That's it.
 NIKOLA_API void physics_world_optimize_broadphase();
 
-/// Create and allocate a physics body using the information provided in the given `desc`, 
-/// returning back a valid `PhysicsBody` to be used later.
-NIKOLA_API PhysicsBody* physics_world_create_body(const PhysicsBodyDesc& desc);
+/// Create a physics body using the information provided in the given `desc`, 
+/// returning back a valid `PhysicsBodyID` to be used later.
+///
+/// @NOTE: The bodies are not allocated one by one. They are taken from a pool 
+/// of `max_bodies` (as given in `PhysicsWorldDesc`) contiguous slots, which are 
+/// given back once the body is destroyed.
+NIKOLA_API PhysicsBodyID physics_world_create_body(const PhysicsBodyDesc& desc);
 
 /// Add a previously-created physics body `body` to the physics world. The `is_active` parametar
 /// indicates whether to wake the body upon addition or not.
-NIKOLA_API void physics_world_add_body(const PhysicsBody* body, const bool is_active = true);
+NIKOLA_API void physics_world_add_body(const PhysicsBodyID& body, const bool is_active = true);
 
 /// Add a previously-created character body `character` to the physics world. The `is_active` parametar
 /// indicates whether to wake the body upon addition or not.
 NIKOLA_API void physics_world_add_character(const Character* character, const bool is_active = true);
 
 /// Combines the `physics_world_create_body` and `physics_world_add_body` functions into one for convenience.
-NIKOLA_API PhysicsBody* physics_world_create_and_add_body(const PhysicsBodyDesc& desc, const bool is_active = true);
+NIKOLA_API PhysicsBodyID physics_world_create_and_add_body(const PhysicsBodyDesc& desc, const bool is_active = true);
 
 /// Prepare `bodies` array of `count` elements to be created, and return a `PhysicsBatchHandle` to give 
 /// to either `physics_world_finalize_bodies` or `physics_world_abort_bodies`.
-NIKOLA_API PhysicsBatchHandle physics_world_prepare_bodies(PhysicsBody** bodies, const sizei count);
+NIKOLA_API PhysicsBatchHandle physics_world_prepare_bodies(PhysicsBodyID* bodies, const sizei count);
 
 /// Finalize the `batch_handle` prepare process, with the given `bodies` array of `count` elements. 
 /// In addition, `is_active` indicates whether to wake the bodies upon addition or not.
 ///
 /// @NOTE: Please make sure that the `bodies` was not modiefied in any way after the `physics_world_prepare_bodies`
 /// function call. It _MUST_ be the same. 
-NIKOLA_API void physics_world_finalize_bodies(PhysicsBody** bodies, const sizei count, PhysicsBatchHandle batch_handle, const bool is_active = true);
+NIKOLA_API void physics_world_finalize_bodies(PhysicsBodyID* bodies, const sizei count, PhysicsBatchHandle batch_handle, const bool is_active = true);
 
 /// Abort the `batch_handle` prepare process, with the given `bodies` array of `count` elements. 
 /// After this function is called the `batch_handle` will be invalidated.
-NIKOLA_API void physics_world_abort_bodies(PhysicsBody** bodies, const sizei count, PhysicsBatchHandle batch_handle);
+NIKOLA_API void physics_world_abort_bodies(PhysicsBodyID* bodies, const sizei count, PhysicsBatchHandle batch_handle);
 
 /// Remove the given `body` from the physics world.
 ///
 /// @NOTE: Make sure to call `physics_world_destroy_body` to remove 
 /// the body from the world completely.
-NIKOLA_API void physics_world_remove_body(PhysicsBody* body);
+NIKOLA_API void physics_world_remove_body(const PhysicsBodyID& body);
 
 /// Destroy the given `body`, deallocating any memory and disabling it in the world. 
+/// The `body` ID will be invalidated afterwards.
 ///
 /// @NOTE: Make sure to call `physics_world_remove_body` _before_ this function.
-NIKOLA_API void physics_world_destroy_body(PhysicsBody** body);
+NIKOLA_API void physics_world_destroy_body(PhysicsBodyID* body);
 
 /// Combines the `physics_world_destroy_body` and `physics_world_remove_body` functions into one for convenience.
-NIKOLA_API void physics_world_remove_and_destroy_body(PhysicsBody** body);
+NIKOLA_API void physics_world_remove_and_destroy_body(PhysicsBodyID* body);
+
+/// Remove and destroy the given `bodies` array of `count` elements in one batch, 
+/// invalidating each entry in `bodies`.
+///
+/// @NOTE: This is much cheaper than calling `physics_world_remove_and_destroy_body` 
+/// on each body, since the broadphase only gets updated once.
+NIKOLA_API void physics_world_remove_and_destroy_bodies(PhysicsBodyID* bodies, const sizei count);
 
 /// Remove the given `character` from the physics world.
 ///
@@ -554,121 +592,130 @@ NIKOLA_API const bool physics_world_is_paused();
 
 /// Set the position of the given `body` to `position`.
 /// The `activate` flag indicates whether to wake the body after this operation or not.
-NIKOLA_API void physics_body_set_position(PhysicsBody* body, const Vec3 position, const bool activate = true);
+NIKOLA_API void physics_body_set_position(const PhysicsBodyID& body, const Vec3 position, const bool activate = true);
 
 /// Set the rotation of the given `body` to `rotation`.
 /// The `activate` flag indicates whether to wake the body after this operation or not.
-NIKOLA_API void physics_body_set_rotation(PhysicsBody* body, const Quat rotation, const bool activate = true);
+NIKOLA_API void physics_body_set_rotation(const PhysicsBodyID& body, const Quat rotation, const bool activate = true);
 
 /// Set the rotation of the given `body` to using the `axis` and `angle`.
 /// The `activate` flag indicates whether to wake the body after this operation or not.
-NIKOLA_API void physics_body_set_rotation(PhysicsBody* body, const Vec3 axis, const f32 angle, const bool activate = true);
+NIKOLA_API void physics_body_set_rotation(const PhysicsBodyID& body, const Vec3 axis, const f32 angle, const bool activate = true);
 
 /// Set the transform of the given `body` to `transform`.
 /// The `activate` flag indicates whether to wake the body after this operation or not.
-NIKOLA_API void physics_body_set_transform(PhysicsBody* body, const Transform& transform, const bool activate = true);
+NIKOLA_API void physics_body_set_transform(const PhysicsBodyID& body, const Transform& transform, const bool activate = true);
 
 /// Set the linear velocity of the given `body` to `velocity`.
-NIKOLA_API void physics_body_set_linear_velocity(PhysicsBody* body, const Vec3 velocity);
+NIKOLA_API void physics_body_set_linear_velocity(const PhysicsBodyID& body, const Vec3 velocity);
 
 /// Set the angular velocity of the given `body` to `velocity`.
-NIKOLA_API void physics_body_set_angular_velocity(PhysicsBody* body, const Vec3 velocity);
+NIKOLA_API void physics_body_set_angular_velocity(const PhysicsBodyID& body, const Vec3 velocity);
 
 /// Set the active state of the given `body` to `active`.
-NIKOLA_API void physics_body_set_active(PhysicsBody* body, const bool active);
+NIKOLA_API void physics_body_set_active(const PhysicsBodyID& body, const bool active);
 
 /// Set the internal user data of the given `body` to `user_data`.
-NIKOLA_API void physics_body_set_user_data(PhysicsBody* body, const u64 user_data);
+NIKOLA_API void physics_body_set_user_data(const PhysicsBodyID& body, const u64 user_data);
+
+/// Enable or disable the contact events of the given `body`.
+NIKOLA_API void physics_body_set_contact_events(const PhysicsBodyID& body, const bool enabled);
 
 /// Set the object layer of the given `body` to `layer`.
-NIKOLA_API void physics_body_set_layer(PhysicsBody* body, const PhysicsObjectLayer layer);
+NIKOLA_API void physics_body_set_layer(const PhysicsBodyID& body, const PhysicsObjectLayer layer);
 
 /// Set the restitution of the given `body` to `restitution`.
-NIKOLA_API void physics_body_set_restitution(PhysicsBody* body, const f32 restitution);
+NIKOLA_API void physics_body_set_restitution(const PhysicsBodyID& body, const f32 restitution);
 
 /// Set the friction of the given `body` to `friction`.
-NIKOLA_API void physics_body_set_friction(PhysicsBody* body, const f32 friction);
+NIKOLA_API void physics_body_set_friction(const PhysicsBodyID& body, const f32 friction);
 
 /// Set the gravity factor of the given `body` to `gravity_factor`.
-NIKOLA_API void physics_body_set_gravity_factor(PhysicsBody* body, const f32 factor);
+NIKOLA_API void physics_body_set_gravity_factor(const PhysicsBodyID& body, const f32 factor);
 
 /// Set the body type of the given `body` to `type`.
-NIKOLA_API void physics_body_set_type(PhysicsBody* body, const PhysicsBodyType type);
+NIKOLA_API void physics_body_set_type(const PhysicsBodyID& body, const PhysicsBodyType type);
 
 /// Set the collider of the given `body` to `collider_id`.
 /// The `activate` flag indicates whether to wake the body after this operation or not.
 ///
 /// @NOTE: The given `collider_id` _MUST_ be valid, otherwise the function will assert.
-NIKOLA_API void physics_body_set_collider(PhysicsBody* body, const Collider* collider_id, const bool activate = true);
+NIKOLA_API void physics_body_set_collider(const PhysicsBodyID& body, const Collider* collider_id, const bool activate = true);
 
 /// Apply linear velocity `velocity` to the given `body`. 
-NIKOLA_API void physics_body_apply_linear_velocity(PhysicsBody* body, const Vec3 velocity);
+NIKOLA_API void physics_body_apply_linear_velocity(const PhysicsBodyID& body, const Vec3 velocity);
 
 /// Apply force `force` to the given `body`. 
-NIKOLA_API void physics_body_apply_force(PhysicsBody* body, const Vec3 force);
+NIKOLA_API void physics_body_apply_force(const PhysicsBodyID& body, const Vec3 force);
 
 /// Apply force `force` at `point` to the given `body`. 
-NIKOLA_API void physics_body_apply_force_at(PhysicsBody* body, const Vec3 force, const Vec3 point);
+NIKOLA_API void physics_body_apply_force_at(const PhysicsBodyID& body, const Vec3 force, const Vec3 point);
 
 /// Apply torque force `torque` to the given `body`. 
-NIKOLA_API void physics_body_apply_torque(PhysicsBody* body, const Vec3 torque);
+NIKOLA_API void physics_body_apply_torque(const PhysicsBodyID& body, const Vec3 torque);
 
 /// Apply impulse force `impulse` to the given `body`. 
-NIKOLA_API void physics_body_apply_impulse(PhysicsBody* body, const Vec3 impulse);
+NIKOLA_API void physics_body_apply_impulse(const PhysicsBodyID& body, const Vec3 impulse);
 
 /// Apply impulse force `impulse` at `point` to the given `body`. 
-NIKOLA_API void physics_body_apply_impulse_at(PhysicsBody* body, const Vec3 impulse, const Vec3 point);
+NIKOLA_API void physics_body_apply_impulse_at(const PhysicsBodyID& body, const Vec3 impulse, const Vec3 point);
 
 /// Apply angluar impulse force `impulse` to the given `body`. 
-NIKOLA_API void physics_body_apply_angular_impulse(PhysicsBody* body, const Vec3 impulse);
+NIKOLA_API void physics_body_apply_angular_impulse(const PhysicsBodyID& body, const Vec3 impulse);
 
 /// Retrieve the position of the given `body`.
-NIKOLA_API const Vec3 physics_body_get_position(const PhysicsBody* body);
+NIKOLA_API const Vec3 physics_body_get_position(const PhysicsBodyID& body);
 
 /// Retrieve the center of mass position of the given `body`.
-NIKOLA_API const Vec3 physics_body_get_com_position(const PhysicsBody* body);
+NIKOLA_API const Vec3 physics_body_get_com_position(const PhysicsBodyID& body);
 
 /// Retrieve the quaternion rotation of the given `body`.
-NIKOLA_API const Quat physics_body_get_rotation(const PhysicsBody* body);
+NIKOLA_API const Quat physics_body_get_rotation(const PhysicsBodyID& body);
 
 /// Retrieve the linear velocity of the given `body`.
-NIKOLA_API const Vec3 physics_body_get_linear_velocity(const PhysicsBody* body);
+NIKOLA_API const Vec3 physics_body_get_linear_velocity(const PhysicsBodyID& body);
 
 /// Retrieve the angular velocity of the given `body`.
-NIKOLA_API const Vec3 physics_body_get_angular_velocity(const PhysicsBody* body);
+NIKOLA_API const Vec3 physics_body_get_angular_velocity(const PhysicsBodyID& body);
 
 /// Retrieve whether the given `body` is currently active or not.
-NIKOLA_API const bool physics_body_is_active(const PhysicsBody* body);
+NIKOLA_API const bool physics_body_is_active(const PhysicsBodyID& body);
 
 /// Retrieve whether the given `body` is a sensor.
-NIKOLA_API const bool physics_body_is_sensor(const PhysicsBody* body);
+NIKOLA_API const bool physics_body_is_sensor(const PhysicsBodyID& body);
+
+/// Retrieve whether the given `body` generates contact events.
+NIKOLA_API const bool physics_body_has_contact_events(const PhysicsBodyID& body);
 
-/// Retrieve whether the given `body` is a valid entry.
-NIKOLA_API const bool physics_body_is_valid(const PhysicsBody* body);
+/// Retrieve whether the given `body` is a valid entry. 
+///
+/// @NOTE: An ID whose body was destroyed is never valid again, even if 
+/// its slot was given to another body since.
+NIKOLA_API const bool physics_body_is_valid(const PhysicsBodyID& body);
 
 /// Retrieve internal user data of the given `body`.
-NIKOLA_API const u64 physics_body_get_user_data(const PhysicsBody* body);
+NIKOLA_API const u64 physics_body_get_user_data(const PhysicsBodyID& body);
 
 /// Retrieve the object layer of the given `body`.
-NIKOLA_API const PhysicsObjectLayer physics_body_get_layer(const PhysicsBody* body);
+NIKOLA_API const PhysicsObjectLayer physics_body_get_layer(const PhysicsBodyID& body);
 
 /// Retrieve the restitution of the given `body`.
-NIKOLA_API const f32 physics_body_get_restitution(const PhysicsBody* body);
+NIKOLA_API const f32 physics_body_get_restitution(const PhysicsBodyID& body);
 
 /// Retrieve the friction of the given `body`.
-NIKOLA_API const f32 physics_body_get_friction(const PhysicsBody* body);
+NIKOLA_API const f32 physics_body_get_friction(const PhysicsBodyID& body);
 
 /// Retrieve the gravity factor of the given `body`.
-NIKOLA_API const f32 physics_body_get_gravity_factor(const PhysicsBody* body);
+NIKOLA_API const f32 physics_body_get_gravity_factor(const PhysicsBodyID& body);
 
 /// Retrieve the body type of the given `body`.
-NIKOLA_API const PhysicsBodyType physics_body_get_type(const PhysicsBody* body);
+NIKOLA_API const PhysicsBodyType physics_body_get_type(const PhysicsBodyID& body);
 
 /// Retrieve the transform of the given `body`.
-NIKOLA_API Transform physics_body_get_transform(const PhysicsBody* body);
+NIKOLA_API Transform physics_body_get_transform(const PhysicsBodyID& body);
 
 /// Retrieve the collider of the given `body`.
-NIKOLA_API Collider* physics_body_get_collider(const PhysicsBody* body);
+NIKOLA_API Collider* physics_body_get_collider(const PhysicsBodyID& body);
 
 /// Physics body functions
 ///---------------------------------------------------------------------------------------------------------------------
@@ -806,7 +853,7 @@ NIKOLA_API const Vec3 character_body_get_ground_normal(const Character* characte
 NIKOLA_API const Vec3 character_body_get_ground_velocity(const Character* character);
 
 /// Retrieve the body ID of the ground body touching `character`.
-NIKOLA_API const PhysicsBody* character_body_get_ground_body(const Character* character);
+NIKOLA_API PhysicsBodyID character_body_get_ground_body(const Character* character);
 
 /// Cast a ray using the information provided in `cast_ray` and check if it collides with 
 /// the given `character`.
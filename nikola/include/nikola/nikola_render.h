@@ -32,9 +32,6 @@ const sizei POINT_LIGHTS_MAX              = 16;
 /// The maximum amount of particles tha can be emitted per emitter.
 const sizei PARTICLES_MAX                 = 1024;
 
-/// The maximum amount of animations a blending operation can have.
-const sizei ANIMATION_BLENDS_MAX          = 3;
-
 /// The maximum amount of corners a camera's frustum can have.
 const sizei CAMERA_FRUSTUM_CORNERS_MAX    = 8;
 
@@ -53,9 +50,21 @@ const sizei SHADER_LIGHT_BUFFER_INDEX     = 3;
 /// The index of the animation uniform buffer within all shaders.
 const sizei SHADER_ANIMATION_BUFFER_INDEX = 4;
 
+/// The index of the joint offsets buffer within all shaders.
+const sizei SHADER_JOINT_OFFSETS_BUFFER_INDEX = 6;
+
+/// A value to indicate an invalid uniform in a `ShaderContext`.
+const u16 SHADER_UNIFORM_INVALID          = ((u16)-1);
+
 /// Consts
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ShaderUniformID 
+typedef u16 ShaderUniformID;
+/// ShaderUniformID 
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// RenderPassID
 enum RenderPassID {
@@ -181,9 +190,10 @@ struct RenderQueueEntry {
   DynamicArray<f32> vertices; 
   DynamicArray<u32> indices; 
   DynamicArray<Mat4> transforms; 
+  DynamicArray<Vec4> bounds; // The world-space bounding sphere (`xyz` = center, `w` = radius) of each transform.
   DynamicArray<MaterialInterface> materials;
-  DynamicArray<Array<Mat4, JOINTS_MAX>> animations;
-  DynamicArray<i32> animation_remap_table;
+  DynamicArray<Mat4> joints; // The skinning palettes of every animation, packed back-to-back.
+  DynamicArray<i32> joint_offsets; // The offset into `joints` of each transform's palette.
   DynamicArray<GfxDrawCommandIndirect> commands; 
 
   /// Pipeline
@@ -195,8 +205,9 @@ struct RenderQueueEntry {
 
   GfxBuffer* transform_buffer = nullptr; 
   GfxBuffer* material_buffer  = nullptr; 
-  GfxBuffer* animation_buffer = nullptr; 
-  GfxBuffer* command_buffer   = nullptr;
+  GfxBuffer* animation_buffer     = nullptr; 
+  GfxBuffer* joint_offsets_buffer = nullptr; 
+  GfxBuffer* command_buffer       = nullptr;
 
   /// Misc.
 
@@ -281,6 +292,12 @@ struct RenderPass {
   RenderPass* previous; 
   RenderPass* next;
   
+  /// The GPU timer of the pass, wrapping both the 
+  /// `prepare_func` and the `sumbit_func` every frame.
+  ///
+  /// @NOTE: Use `gfx_query_get_elapsed` to retrieve the results.
+  GfxQuery* gpu_timer = nullptr;
+
   /// State handling
   String debug_name;
 };
@@ -448,6 +465,13 @@ struct Mesh {
   /// @NOTE: This is `0` by default, representing 
   /// the default material.
   sizei material_index = 0;
+
+  /// The local bounding sphere of this mesh, with 
+  /// the center in `xyz` and the radius in `w`.
+  ///
+  /// @NOTE: This is computed once when the mesh is 
+  /// loaded or reloaded by the resource manager.
+  Vec4 bounds = Vec4(0.0f);
 };
 /// Mesh 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -508,6 +532,30 @@ struct Material {
 /// Material 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ShaderUniform
+struct ShaderUniform {
+  /// The location of the uniform in the shader.
+  i32 location = -1;
+
+  /// The type and the amount of elements last written to the uniform.
+  
+  GfxLayoutType type = GFX_LAYOUT_FLOAT1;
+  sizei count        = 0;
+
+  /// The offset and the size (in bytes) of the uniform's 
+  /// value in the shadow buffer of the context.
+  
+  sizei offset = 0; 
+  sizei size   = 0;
+
+  /// Indicates whether the uniform's value was changed 
+  /// but not yet uploaded to the shader.
+  bool is_dirty = false;
+};
+/// ShaderUniform
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShaderContext
 struct ShaderContext {
@@ -516,8 +564,14 @@ struct ShaderContext {
 
   /// A cache of uniforms where the key is the name of 
   /// the uniform in the shader and the value is the 
-  /// uniform's location in the shader.
-  HashMap<String, i32> uniforms_cache;
+  /// uniform's ID in the `uniforms` array.
+  HashMap<String, ShaderUniformID> uniforms_cache;
+
+  /// All the cached uniforms of the context.
+  DynamicArray<ShaderUniform> uniforms;
+
+  /// A CPU-side copy of the values of all the uniforms in the context.
+  DynamicArray<u8> uniforms_buffer;
 };
 /// ShaderContext
 ///---------------------------------------------------------------------------------------------------------------------
@@ -578,6 +632,109 @@ struct Font {
 /// Font 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// AnimationLOD
+enum AnimationLOD {
+  /// The pose gets evaluated on every update.
+  ANIMATION_LOD_FULL = 0, 
+  
+  /// The pose gets evaluated at half the rate (30Hz), accumulating the time in between.
+  ANIMATION_LOD_HALF,
+  
+  /// The pose gets evaluated at a quarter of the rate (15Hz), accumulating the time in between.
+  ANIMATION_LOD_QUARTER,
+
+  /// The pose does not get evaluated at all, keeping the last 
+  /// skinning palette. The time of the animation still advances, however.
+  ///
+  /// @NOTE: This is ideal for offscreen or very distant characters.
+  ANIMATION_LOD_FROZEN,
+};
+/// AnimationLOD
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// AnimationBlendMode
+enum AnimationBlendMode {
+  /// The layer gets blended with the other normal layers, 
+  /// relative to its weight.
+  ANIMATION_BLEND_NORMAL = 0,
+
+  /// The layer gets added on top of the blended normal layers, 
+  /// scaled by its weight. 
+  ///
+  /// @NOTE: The animation of an additive layer is expected to be 
+  /// authored as a delta from the skeleton's rest pose (a breathing or 
+  /// a flinching animation, for example).
+  ANIMATION_BLEND_ADDITIVE,
+};
+/// AnimationBlendMode
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// AnimationIKType
+enum AnimationIKType {
+  /// Rotate a chain of 3 joints (a hip, a knee, and an ankle, for example) 
+  /// so that the end joint reaches the target.
+  ANIMATION_IK_TWO_BONE = 0,
+  
+  /// Rotate a single joint (a head or a spine, for example) so that 
+  /// its forward axis points towards the target.
+  ANIMATION_IK_AIM,
+};
+/// AnimationIKType
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// AnimationIKTarget
+struct AnimationIKTarget {
+  /// The type of the solver to use.
+  AnimationIKType type     = ANIMATION_IK_TWO_BONE;
+
+  /// The names of the joints to be affected. 
+  ///
+  /// @NOTE: An `ANIMATION_IK_AIM` target only uses the `end_joint`.
+  ///
+  /// @NOTE: The joints are resolved once when the target is pushed. 
+  /// Changing the names afterwards will have no effect.
+  String start_joint; 
+  String middle_joint; 
+  String end_joint;
+
+  /// The position to reach (or aim at) in the model space of the skeleton.
+  ///
+  /// @NOTE: World-space targets must be transformed by the inverse 
+  /// of the entity's transform first.
+  Vec3 position            = Vec3(0.0f);
+
+  /// The model-space direction the middle joint (the knee or the elbow) 
+  /// should bend towards for `ANIMATION_IK_TWO_BONE`, or the model-space 
+  /// direction the `up` axis should point towards for `ANIMATION_IK_AIM`.
+  Vec3 pole_vector         = Vec3(0.0f, 1.0f, 0.0f);
+
+  /// The axis in the local space of the middle joint which the 
+  /// chain bends around. Only used by `ANIMATION_IK_TWO_BONE`.
+  Vec3 middle_axis         = Vec3(0.0f, 0.0f, 1.0f);
+
+  /// The forward and up axes in the local space of the end joint. 
+  /// Only used by `ANIMATION_IK_AIM`.
+  Vec3 forward             = Vec3(0.0f, 0.0f, 1.0f);
+  Vec3 up                  = Vec3(0.0f, 1.0f, 0.0f);
+
+  /// The amount of correction applied, from `0.0f` (no correction) 
+  /// to `1.0f` (full correction).
+  f32 weight               = 1.0f;
+
+  /// The ratio of the chain's length where the solver starts to ease 
+  /// into the target, avoiding the knee snapping when fully extended. 
+  /// Only used by `ANIMATION_IK_TWO_BONE`.
+  ///
+  /// @NOTE: A value of `1.0f` disables softening.
+  f32 soften               = 1.0f;
+};
+/// AnimationIKTarget
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// AnimationSamplerInfo
 struct AnimationSamplerInfo {
@@ -599,6 +756,12 @@ struct AnimationSamplerInfo {
   /// The index of the current animation that the 
   /// animator is playing. 
   sizei current_animation = 0;
+
+  /// The level of detail of the sampler, which dictates 
+  /// how often the pose gets evaluated.
+  ///
+  /// @NOTE: See `animation_lod_evaluate` for an easy way to set this value.
+  AnimationLOD lod        = ANIMATION_LOD_FULL;
 };
 /// AnimationSamplerInfo
 ///---------------------------------------------------------------------------------------------------------------------
@@ -618,6 +781,10 @@ struct AnimationBlenderInfo {
   /// of each blend every loop. The higher the 
   /// value, the more dominant the last blend will be.
   /// And vice versa.
+  ///
+  /// @NOTE: Only the normal, unmasked layers are driven by this value. 
+  /// Additive and masked layers keep the weight given to them 
+  /// via `animation_blender_set_animation_weight`.
   f32 blending_ratio      = 1.0f;
 
   /// Determines whether the animation should loop or not.
@@ -627,6 +794,12 @@ struct AnimationBlenderInfo {
   /// go through its samples and play. Otherwise, the animation 
   /// will be paused.
   bool is_animating       = true;
+
+  /// The level of detail of the blender, which dictates 
+  /// how often the pose gets evaluated.
+  ///
+  /// @NOTE: See `animation_lod_evaluate` for an easy way to set this value.
+  AnimationLOD lod        = ANIMATION_LOD_FULL;
 };
 /// AnimationBlenderInfo
 ///---------------------------------------------------------------------------------------------------------------------
@@ -918,6 +1091,11 @@ NIKOLA_API void ui_renderer_begin();
 /// End the rendering process of the UI renderer. 
 NIKOLA_API void ui_renderer_end();
 
+/// Retrieve the latest GPU time (in milliseconds) taken by `ui_renderer_end`.
+///
+/// @NOTE: The result is a few frames late. Check `gfx_query_get_elapsed` for more details.
+NIKOLA_API const f64 ui_renderer_get_gpu_time();
+
 /// Load the font face found at the given `path`.
 /// Returns `true` if the font was loaded successfully, or `false` otherwise.
 ///
@@ -943,6 +1121,11 @@ NIKOLA_API void batch_renderer_begin();
 /// Sumbit the results of the batch renderer to the screen.
 NIKOLA_API void batch_renderer_end();
 
+/// Retrieve the latest GPU time (in milliseconds) taken by `batch_renderer_end`.
+///
+/// @NOTE: The result is a few frames late. Check `gfx_query_get_elapsed` for more details.
+NIKOLA_API const f64 batch_renderer_get_gpu_time();
+
 /// Source the given `texture` at `src` and render into `dest`, tinted with `tint`.
 ///
 /// @NOTE: By default, `tint` is set to `Vec4(1.0f)`.
@@ -1022,8 +1205,14 @@ NIKOLA_API const bool camera_check_intersection(const Camera& cam, const Transfo
 /// ParticleEmitter functions
 
 /// Create a particle emitter `out_emitter`, using the information in `desc`.
+///
+/// @NOTE: The emitter acquires its `mesh_id` and `material_id`, keeping them from 
+/// being evicted. Call `particle_emitter_destroy` once the emitter is no longer needed.
 NIKOLA_API void particle_emitter_create(ParticleEmitter* out_emitter, const ParticleEmitterDesc& desc);
 
+/// Destroy the given `emitter`, releasing the resources it acquired in `particle_emitter_create`.
+NIKOLA_API void particle_emitter_destroy(ParticleEmitter& emitter);
+
 /// A physics update of each particle in the given `emitter` using the scale of `delta_time`. 
 NIKOLA_API void particle_emitter_update(ParticleEmitter& emitter, const f64 delta_time); 
 
@@ -1039,12 +1228,61 @@ NIKOLA_API void particle_emitter_reset(ParticleEmitter& emitter);
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShaderContext functions
 
-/// Cache the location of the uniform with the name `uniform_name` to the given `ctx`.
+/// Cache the location of the uniform with the name `uniform_name` to the given `ctx`, 
+/// returning back an ID to be used with any proceeding `shader_context_set_uniform` calls. 
+/// If the uniform was already cached, its existing ID will be returned.
 /// 
-/// @NOTE: If the uniform's name is not found within the context, the function will throw a warning. 
-NIKOLA_API void shader_context_cache_uniform(ShaderContext* ctx, const i8* uniform_name);
+/// @NOTE: If the uniform's name is not found within the context, the function will 
+/// throw a warning and return `SHADER_UNIFORM_INVALID`. 
+NIKOLA_API ShaderUniformID shader_context_cache_uniform(ShaderContext* ctx, const String& uniform_name);
+
+/// Look up the locations of all the cached uniforms in `ctx` again, and mark 
+/// every uniform with a value as dirty, so the next flush (or write) sends it again.
+///
+/// @NOTE: This _MUST_ be called whenever the shader of `ctx` gets relinked, since 
+/// relinking resets the uniforms to their defaults. The resource manager already 
+/// does this for any hot-reloaded shaders.
+NIKOLA_API void shader_context_reload(ShaderContext* ctx);
+
+/// Upload the values of any uniforms in `ctx` that were changed 
+/// since the last flush using their IDs.
+///
+/// @NOTE: This should be called once before the draw call that uses `ctx`.
+NIKOLA_API void shader_context_flush(ShaderContext* ctx);
+
+/// Set a uniform of type `i32` identified by `uniform` in `ctx` to the given `value`. 
+///
+/// @NOTE: Setting uniforms by their IDs only writes the value into the context. 
+/// The value will only be uploaded in the next `shader_context_flush`.
+///
+/// @NOTE: Passing `SHADER_UNIFORM_INVALID` as the `uniform` is allowed and simply does nothing.
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const i32 value);
+
+/// Set a uniform of type `f32` identified by `uniform` in `ctx` to the given `value`. 
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const f32 value);
+
+/// Set a uniform of type `Vec2` identified by `uniform` in `ctx` to the given `value`. 
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec2& value);
+
+/// Set a uniform of type `Vec3` identified by `uniform` in `ctx` to the given `value`. 
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec3& value);
+
+/// Set a uniform of type `Vec4` identified by `uniform` in `ctx` to the given `value`. 
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec4& value);
+
+/// Set a uniform of type `Mat4` identified by `uniform` in `ctx` to the given `value`. 
+NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Mat4& value);
+
+/// Set an array uniforms of type `i32` identified by `uniform` in `ctx` to the given `values` with `count` elements. 
+NIKOLA_API void shader_context_set_uniform_array(ShaderContext* ctx, const ShaderUniformID uniform, const i32* values, const sizei count);
+
+/// Set an array uniforms of type `f32` identified by `uniform` in `ctx` to the given `values` with `count` elements. 
+NIKOLA_API void shader_context_set_uniform_array(ShaderContext* ctx, const ShaderUniformID uniform, const f32* values, const sizei count);
 
 /// Set a uniform of type `i32` with the name `uniform_name` in `ctx` to the given `value`. 
+///
+/// @NOTE: Setting uniforms by their names uploads the value right away. Prefer 
+/// using uniform IDs for uniforms that get set every frame.
 NIKOLA_API void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const i32 value);
 
 /// Set a uniform of type `f32` with the name `uniform_name` in `ctx` to the given `value`. 
@@ -1105,9 +1343,22 @@ NIKOLA_API void skeleton_destroy(Skeleton* skele);
 /// @NOTE: This is more likely to be used in the resource manager.
 NIKOLA_API Animation* animation_create(const NBRAnimation& nbr_anim);
 
+/// Rebuild the given `anim` in place using the information in `nbr_anim`, returning 
+/// `true` on success and `false` otherwise.
+///
+/// @NOTE: Any samplers referencing `anim` will stay valid. However, the number of 
+/// tracks in `nbr_anim` _must_ match the tracks of `anim`.
+NIKOLA_API bool animation_reload(Animation* anim, const NBRAnimation& nbr_anim);
+
 /// Destroy and reclaim the memory consumed by `anim`.
 NIKOLA_API void animation_destroy(Animation* anim);
 
+/// Determine the appropriate `AnimationLOD` of a character at `position` with a 
+/// bounding sphere of `radius`, based on how much of the screen it covers in `camera`. 
+///
+/// @NOTE: Characters outside of the frustum of `camera` are always `ANIMATION_LOD_FROZEN`.
+NIKOLA_API const AnimationLOD animation_lod_evaluate(const Camera& camera, const Vec3& position, const f32 radius);
+
 /// Animation functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -1130,6 +1381,19 @@ NIKOLA_API AnimationSamplerInfo& animation_sampler_get_info(AnimationSampler* sa
 /// Retrieve a reference of the calculated skinning palette of `sampler`.
 NIKOLA_API const Array<Mat4, JOINTS_MAX>& animation_sampler_get_skinning_palette(const AnimationSampler* sampler);
 
+/// Retrieve the amount of joints (i.e the valid entries of the skinning palette) of `sampler`.
+NIKOLA_API const sizei animation_sampler_get_joints_count(const AnimationSampler* sampler);
+
+/// Push a new inverse kinematics `target` into the given `sampler`, returning back 
+/// the index of the target for any future operations.
+///
+/// @NOTE: The targets are applied in order after every pose evaluation, and 
+/// only the joints affected by each target get their model matrices recomputed.
+NIKOLA_API const sizei animation_sampler_push_ik_target(AnimationSampler* sampler, const AnimationIKTarget& target);
+
+/// Retrieve a reference of the inverse kinematics target at `index` in `sampler`. 
+NIKOLA_API AnimationIKTarget& animation_sampler_get_ik_target(AnimationSampler* sampler, const sizei index);
+
 /// Update the animation process of the given `sampler`, using the given `dt` as 
 /// a delta time for progressing. The current animation of the given `sampler` 
 /// will be chosen to be played. This can be changed from `AnimationSamplerInfo.current_animation`.
@@ -1148,20 +1412,49 @@ NIKOLA_API AnimationBlender* animation_blender_create(const ResourceID& skeleton
 NIKOLA_API void animation_blender_destroy(AnimationBlender* blender);
 
 /// Push a new animation using the `animation_id` into the given `blender` to be considered in the blending process, 
+/// using the given `mode` to decide how the new layer gets combined with the rest.
 ///
-/// @NOTE: Currently, the blending process only supports up to `ANIMATION_BLENDS_MAX`. Therefore, this function will 
-/// assert if more than `ANIMATION_BLENDS_MAX` are inserted into the blend.
-NIKOLA_API void animation_blender_push_animation(AnimationBlender* blender, const ResourceID& animation_id);
+/// @NOTE: Additive layers start with a weight of `1.0f`.
+NIKOLA_API void animation_blender_push_animation(AnimationBlender* blender, 
+                                                 const ResourceID& animation_id, 
+                                                 const AnimationBlendMode mode = ANIMATION_BLEND_NORMAL);
 
 /// Set the weight of an animation blend at `anim_index` in the given `blender` to `weight`. 
 NIKOLA_API void animation_blender_set_animation_weight(AnimationBlender* blender, const sizei anim_index, const f32 weight);
 
+/// Set the per-joint weight of the joint `joint_name` and all of its children in the 
+/// animation blend at `anim_index` in the given `blender` to `weight`. 
+///
+/// @NOTE: Once a mask is set on a blend, every joint outside of the masked hierarchies 
+/// will have a weight of `0.0f`. This makes it easy to split a character into an upper 
+/// and a lower body, for example, by masking the spine of one blend and the hips of another.
+///
+/// @NOTE: Masked blends are not driven by `AnimationBlenderInfo::blending_ratio`, and 
+/// they start with a weight of `1.0f`.
+NIKOLA_API void animation_blender_set_joint_mask(AnimationBlender* blender, 
+                                                 const sizei anim_index, 
+                                                 const String& joint_name, 
+                                                 const f32 weight);
+
 /// Retrieve a reference of the internal `AnimationBlenderInfo` of `blender`.
 NIKOLA_API AnimationBlenderInfo& animation_blender_get_info(AnimationBlender* blender);
 
+/// Push a new inverse kinematics `target` into the given `blender`, returning back 
+/// the index of the target for any future operations.
+///
+/// @NOTE: The targets are applied in order after the blended pose is evaluated, and 
+/// only the joints affected by each target get their model matrices recomputed.
+NIKOLA_API const sizei animation_blender_push_ik_target(AnimationBlender* blender, const AnimationIKTarget& target);
+
+/// Retrieve a reference of the inverse kinematics target at `index` in `blender`. 
+NIKOLA_API AnimationIKTarget& animation_blender_get_ik_target(AnimationBlender* blender, const sizei index);
+
 /// Retrieve a reference of the calculated skinning palette of `blender`.
 NIKOLA_API const Array<Mat4, JOINTS_MAX>& animation_blender_get_skinning_palette(const AnimationBlender* blender);
 
+/// Retrieve the amount of joints (i.e the valid entries of the skinning palette) of `blender`.
+NIKOLA_API const sizei animation_blender_get_joints_count(const AnimationBlender* blender);
+
 /// Start the blending process of the given `blender`, using the given `dt` as 
 /// a delta time for progressing. 
 NIKOLA_API void animation_blender_update(AnimationBlender* blender, const f32 dt);
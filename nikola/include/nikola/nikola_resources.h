@@ -560,6 +560,10 @@ struct ResourceID {
   /// resource's creation.
   u16 _id;
 
+  /// The generation of the slot `_id` at the time of the resource's creation. 
+  /// This is used to catch stale IDs of resources that were already cleared.
+  u16 _generation = 0;
+
   /// The parent resource group that will be used to 
   /// retrieve the resource later. 
   ResourceGroupID group = RESOURCE_GROUP_INVALID;
@@ -567,6 +571,24 @@ struct ResourceID {
 /// ResourceID
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ResourceMemoryInfo
+struct ResourceMemoryInfo {
+  /// The amount of CPU memory (in bytes) consumed by each resource type.
+  sizei cpu_bytes[RESOURCE_TYPES_MAX]       = {};
+  
+  /// The amount of GPU memory (in bytes) consumed by each resource type.
+  ///
+  /// @NOTE: This is only an estimate based on the descriptions of the resources. 
+  /// The driver is free to allocate more (or less) than that.
+  sizei gpu_bytes[RESOURCE_TYPES_MAX]       = {};
+  
+  /// The amount of live resources of each resource type.
+  sizei resources_count[RESOURCE_TYPES_MAX] = {};
+};
+/// ResourceMemoryInfo
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// NBR functions
 
@@ -596,12 +618,56 @@ NIKOLA_API void resource_manager_init();
 /// Free/reclaim any memory consumed by the global resource manager.
 NIKOLA_API void resource_manager_shutdown();
 
+/// Enforce the memory budgets of each resource type, evicting the least-recently 
+/// used resources that are not referenced anymore. 
+///
+/// @NOTE: This is called by the engine once per frame. 
+NIKOLA_API void resource_manager_update();
+
+/// Set the memory budget (in bytes) of all the resources of `type` across all groups to `bytes`. 
+/// A budget of `0` disables any eviction of `type`.
+///
+/// @NOTE: Only textures, meshes, and audio buffers can be evicted. 
+///
+/// @NOTE: Resources in the cache (`RESOURCE_CACHE_ID`) are never evicted.
+///
+/// @NOTE: Once a budget is set, the IDs of resources that were never acquired (see `resources_acquire`) 
+/// can go stale at any time. Either acquire them, or check them with `resources_is_valid` before use.
+NIKOLA_API void resources_set_memory_budget(const ResourceType type, const sizei bytes);
+
+/// Retrieve the memory budget (in bytes) of the resources of `type`.
+NIKOLA_API const sizei resources_get_memory_budget(const ResourceType type);
+
+/// Retrieve the memory consumed by all the resources in `group_id`.
+NIKOLA_API ResourceMemoryInfo resources_get_memory_info(const ResourceGroupID& group_id);
+
+/// Retrieve the memory consumed by all the resources across all groups.
+NIKOLA_API ResourceMemoryInfo resources_get_memory_info();
+
+/// Add a reference to the resource identified by `id`, preventing it from being evicted.
+///
+/// @NOTE: Models, materials, skyboxes, and fonts automatically acquire any resources they use. 
+/// So do particle emitters and the `entity_add_*` helpers, until the emitter or entity is destroyed.
+NIKOLA_API void resources_acquire(const ResourceID& id);
+
+/// Remove a reference previously added by `resources_acquire` to the resource identified by `id`.
+NIKOLA_API void resources_release(const ResourceID& id);
+
+/// Return true if `id` still identifies a live resource. Otherwise, `id` is either 
+/// invalid or stale (its resource was cleared or evicted). 
+NIKOLA_API bool resources_is_valid(const ResourceID& id);
+
+/// Retrieve the amount of references currently held to the resource identified by `id`.
+NIKOLA_API const u32 resources_get_ref_count(const ResourceID& id);
+
 /// Create and return a new resource group (a.k.a `unsigned short`) with `name` and `parent_dir`. 
 ///
 /// @NOTE: Any `_push` function that takes a `path` will be prefixed with the given `parent_dir`.
 NIKOLA_API ResourceGroupID resources_create_group(const String& name, const FilePath& parent_dir);
 
-/// Clear all of resources in `group_id`.
+/// Clear all of resources in `group_id`, destroying any underlying GPU objects.
+///
+/// @NOTE: Any previously-retrieved IDs from `group_id` will be considered stale afterwards.
 NIKOLA_API void resources_clear_group(const ResourceGroupID& group_id);
 
 /// Clear and destroy all of resources in `group_id`.
@@ -714,6 +780,10 @@ NIKOLA_API ResourceID& resources_get_id(const ResourceGroupID& group_id, const S
 /// Retrieve `GfxBuffer` identified by `id` in `group`. 
 ///
 /// @NOTE: This function will assert if `id` is not found in `group`.
+///
+/// @NOTE: All the `resources_get_*` functions are a direct index into the group's 
+/// resource table, and will return `nullptr` (or an empty handle) if `id` is stale 
+/// (i.e, it was cleared or evicted). Use `resources_is_valid` to check beforehand.
 NIKOLA_API GfxBuffer* resources_get_buffer(const ResourceID& id);
 
 /// Retrieve `GfxTexture` identified by `id` in `id.group`. 
@@ -21,14 +21,28 @@ using ThreadTaskFn = std::function<void()>;
 /// ThreadTaskFn
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// ThreadRangeFn
+
+/// The function callback to be invoked on a chunk of a parallel loop, 
+/// covering the indices from `begin` up to (but not including) `end`.
+using ThreadRangeFn = std::function<void(const sizei begin, const sizei end)>;
+
+/// ThreadRangeFn
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// ThreadPool 
 struct ThreadPool {
   String name; 
-  bool is_active;
+  std::atomic<bool> is_active;
 
   DynamicArray<std::thread*> workers; 
   moodycamel::ConcurrentQueue<ThreadTaskFn> tasks;
+
+  // Idle workers sleep on this until there's something to do
+  std::mutex wait_mutex;
+  std::condition_variable wait_condition;
 };
 /// ThreadPool 
 /// ----------------------------------------------------------------------
@@ -49,6 +63,14 @@ NIKOLA_API void thread_pool_push_task(ThreadPool& pool, const ThreadTaskFn& task
 /// Retrieve the approximate amount of tasks left.
 NIKOLA_API const sizei thread_pool_get_approx_size(const ThreadPool& pool);
 
+/// Split the range `[0, count)` into chunks of `chunk_size` indices, and invoke 
+/// `task` on each chunk across the worker threads of `pool`. 
+///
+/// @NOTE: The calling thread takes part in the work as well, and this function 
+/// will only return once _every_ chunk is done. If `pool` has no workers, 
+/// `task` will just be invoked on the whole range on the calling thread.
+NIKOLA_API void thread_pool_parallel_for(ThreadPool& pool, const sizei count, const sizei chunk_size, const ThreadRangeFn& task);
+
 /// ThreadPool functions
 /// ----------------------------------------------------------------------
 
@@ -41,6 +41,127 @@ NIKOLA_API String perf_timer_to_string(PerfTimer& timer);
 /// PerfTimer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler consts
+
+/// The maximum amount of frames kept in the history of the profiler. 
+/// Older frames get overwritten.
+const sizei PROFILER_FRAMES_MAX = 240;
+
+/// The maximum amount of unique zones a single frame can record.
+const sizei PROFILER_ZONES_MAX  = 48;
+
+/// Profiler consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfilerCounter
+enum ProfilerCounter {
+  /// The number of draw calls issued in the frame.
+  PROFILER_COUNTER_DRAW_CALLS = 0, 
+  
+  /// The number of state changes sent to the graphics driver in the frame.
+  PROFILER_COUNTER_STATE_CALLS, 
+  
+  /// The (approximate) number of triangles submitted in the frame.
+  PROFILER_COUNTER_TRIANGLES, 
+  
+  /// The number of bytes uploaded to GPU buffers in the frame.
+  PROFILER_COUNTER_UPLOADED_BYTES, 
+  
+  /// The number of memory allocations made in the frame.
+  PROFILER_COUNTER_ALLOCATIONS, 
+
+  PROFILER_COUNTERS_MAX,
+};
+/// ProfilerCounter
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfilerZone
+struct ProfilerZone {
+  /// The name of the zone. 
+  ///
+  /// @NOTE: The name is never copied, so it _must_ outlive the profiler 
+  /// (string literals, for example).
+  const char* name = nullptr; 
+
+  /// How deep the zone was in the stack of zones when first recorded.
+  u32 depth        = 0;
+
+  /// The number of times the zone was entered in the frame.
+  u32 calls        = 0;
+
+  /// The accumulated time (in milliseconds) spent in the zone in the frame.
+  f32 time_ms      = 0.0f;
+};
+/// ProfilerZone
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfilerFrame
+struct ProfilerFrame {
+  /// The time (in milliseconds) the whole frame took.
+  f32 time_ms = 0.0f;
+
+  /// The zones recorded in this frame, in the order they were first entered.
+  ProfilerZone zones[PROFILER_ZONES_MAX];
+  sizei zones_count = 0;
+
+  /// The values of every `ProfilerCounter` in this frame.
+  u64 counters[PROFILER_COUNTERS_MAX] = {};
+};
+/// ProfilerFrame
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler functions
+
+/// Start recording a new frame in the profiler.
+///
+/// @NOTE: Only the thread that calls this function will have its zones recorded.
+NIKOLA_API void profiler_begin_frame();
+
+/// Finish the frame currently being recorded and push it into the history.
+NIKOLA_API void profiler_end_frame();
+
+/// Enter the zone `name` in the frame currently being recorded.
+NIKOLA_API void profiler_zone_begin(const char* name);
+
+/// Leave the last zone entered in the frame currently being recorded.
+NIKOLA_API void profiler_zone_end();
+
+/// Set the value of `counter` in the frame currently being recorded to `value`.
+NIKOLA_API void profiler_set_counter(const ProfilerCounter counter, const u64 value);
+
+/// Retrieve the amount of frames currently in the history of the profiler.
+NIKOLA_API const sizei profiler_get_frames_count();
+
+/// Retrieve the frame at `index` in the history of the profiler, where 
+/// `0` is the oldest frame and `profiler_get_frames_count() - 1` is the latest.
+NIKOLA_API const ProfilerFrame& profiler_get_frame(const sizei index);
+
+/// Write the whole history of the profiler as JSON into the file at `path`, 
+/// returning `true` on success and `false` otherwise.
+NIKOLA_API bool profiler_dump(const String& path);
+
+/// Profiler functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfilerScope
+struct ProfilerScope {
+  ProfilerScope(const char* name) {
+    profiler_zone_begin(name);
+  }
+
+  ~ProfilerScope() {
+    profiler_zone_end();
+  }
+};
+/// ProfilerScope
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Macros
 
@@ -52,8 +173,11 @@ NIKOLA_API String perf_timer_to_string(PerfTimer& timer);
   #define NIKOLA_PERF_TIMER_END(timer, tag)
 #endif
 
-#define NIKOLA_PROFILE_FUNCTION()           ZoneScoped
-#define NIKOLA_PROFILE_FUNCTION_NAMED(name) ZoneScopedN(name)
+// @NOTE: Every zone is recorded into both Tracy (if a server is attached) and 
+// the in-engine profiler, which is always active.
+
+#define NIKOLA_PROFILE_FUNCTION()           ZoneScoped; nikola::ProfilerScope nikola_profiler_scope_(__func__)
+#define NIKOLA_PROFILE_FUNCTION_NAMED(name) ZoneScopedN(name); nikola::ProfilerScope nikola_profiler_scope_(name)
 
 /// Macros
 ///---------------------------------------------------------------------------------------------------------------------
@@ -222,7 +222,7 @@ NIKOLA_API void gui_edit_audio_listener(const char* name);
 NIKOLA_API void gui_edit_timer(const char* name, Timer* timer);
 
 /// Add a physics body section identified by `name` to edit the given `body`.
-NIKOLA_API void gui_edit_physics_body(const char* name, PhysicsBody* body);
+NIKOLA_API void gui_edit_physics_body(const char* name, const PhysicsBodyID& body);
 
 /// Add a character body section identified by `name` to edit the given `character`.
 NIKOLA_API void gui_edit_character_body(const char* name, Character* character);
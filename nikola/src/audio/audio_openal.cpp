@@ -184,9 +184,50 @@ void audio_buffer_update(AudioBufferID& buffer, const AudioBufferDesc& desc) {
 
   s_audio.buffers[id] = desc;
 
-  alBufferi(id, AL_FREQUENCY, desc.sample_rate);
-  alBufferi(id, AL_CHANNELS, desc.channels);
-  alBufferi(id, AL_SIZE, desc.size);
+  // Only the parametars need updating
+
+  if(!desc.data) {
+    alBufferi(id, AL_FREQUENCY, desc.sample_rate);
+    alBufferi(id, AL_CHANNELS, desc.channels);
+    alBufferi(id, AL_SIZE, desc.size);
+
+    return;
+  }
+
+  // OpenAL does not allow re-filling a buffer that is still queued on a source. 
+  // So, any sources that reference this buffer will have to let go of it first.
+
+  DynamicArray<u32> attached_sources;
+  for(auto& [source_id, source_desc] : s_audio.sources) {
+    for(sizei i = 0; i < source_desc.buffers_count; i++) {
+      if(source_desc.buffers[i].get_id() != id) {
+        continue;
+      }
+
+      alSourceStop(source_id);
+      alSourcei(source_id, AL_BUFFER, 0);
+      
+      attached_sources.push_back(source_id);
+      break;
+    }
+  }
+
+  // Re-fill the buffer with the new data
+  
+  sizei bytes; 
+  ALenum format = get_al_format(desc.format, desc.channels, &bytes); 
+
+  alBufferData(id, format, desc.data, desc.size, desc.sample_rate); 
+  check_al_error("alBufferData");
+
+  // Give the buffers back to the sources
+  
+  for(auto& source_id : attached_sources) {
+    AudioSourceID source = AudioSourceID(source_id);
+    AudioSourceDesc& source_desc = s_audio.sources[source_id];
+
+    audio_source_queue_buffers(source, source_desc.buffers, source_desc.buffers_count);
+  }
 }
 
 /// AudioBuffer functions
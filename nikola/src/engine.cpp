@@ -94,6 +94,9 @@ void engine_init(const AppDesc& desc) {
 
   physics_world_init(world_desc);
 
+  // Entity worlds init
+  entity_world_init();
+
   // Check for any command line arguments
   
   Args cli_args; 
@@ -111,35 +114,68 @@ void engine_init(const AppDesc& desc) {
 
 void engine_run() {
   while(window_is_open(s_engine.window)) {
+    profiler_begin_frame();
+
     // Poll for input events
     window_poll_events(s_engine.window);
     
     // Update 
     
     physics_world_step(1 / 60.0f, 1); 
-    CHECK_VALID_CALLBACK(s_engine.app_desc.update_fn, s_engine.app, niclock_get_delta_time());
+    {
+      NIKOLA_PROFILE_FUNCTION_NAMED("engine_run(Update)");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.update_fn, s_engine.app, niclock_get_delta_time());
+    }
 
     // Render
-    
-    CHECK_VALID_CALLBACK(s_engine.app_desc.render_fn, s_engine.app);
-    CHECK_VALID_CALLBACK(s_engine.app_desc.render_gui_fn, s_engine.app);
+   
+    {
+      NIKOLA_PROFILE_FUNCTION_NAMED("engine_run(Render)");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.render_fn, s_engine.app);
+    }
+    {
+      NIKOLA_PROFILE_FUNCTION_NAMED("engine_run(RenderGUI)");
+      CHECK_VALID_CALLBACK(s_engine.app_desc.render_gui_fn, s_engine.app);
+    }
     
     // Update the internal systems
 
-    input_update();
-    niclock_update();
+    {
+      NIKOLA_PROFILE_FUNCTION_NAMED("engine_run(Systems)");
+
+      filewatcher_update();
+      resource_manager_update();
+      input_update();
+      niclock_update();
+    }
 
     // Present
-    gfx_context_present(s_engine.gfx_context); 
+
+    {
+      NIKOLA_PROFILE_FUNCTION_NAMED("engine_run(Present)");
+      gfx_context_present(s_engine.gfx_context); 
+    }
+
+    // Save the stats of this frame
+    
+    const GfxContextStats& stats = gfx_context_get_stats(s_engine.gfx_context);
+    profiler_set_counter(PROFILER_COUNTER_DRAW_CALLS, stats.draw_calls);
+    profiler_set_counter(PROFILER_COUNTER_STATE_CALLS, stats.state_calls);
+    profiler_set_counter(PROFILER_COUNTER_TRIANGLES, stats.triangles);
+    profiler_set_counter(PROFILER_COUNTER_UPLOADED_BYTES, stats.uploaded_bytes);
+
+    profiler_end_frame();
   }
 }
 
 void engine_shutdown() {
   CHECK_VALID_CALLBACK(s_engine.app_desc.shutdown_fn, s_engine.app);
 
+  entity_world_shutdown();
   physics_world_shutdown();
   ui_renderer_shutdown();
   renderer_shutdown();
+  filewatcher_shutdown();
   resource_manager_shutdown();
   audio_device_shutdown();
 
@@ -1,18 +1,854 @@
 #include "nikola/nikola_entity.h"
 #include "nikola/nikola_event.h"
 #include "nikola/nikola_ui.h"
+#include "nikola/nikola_thread.h"
+#include "nikola/nikola_file.h"
+#include "nikola/nikola_audio.h"
+
+#include <algorithm>
 
 //////////////////////////////////////////////////////////////////////////
 
-namespace nikola { // Start of nikola
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Entity ***
+
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of animation components each worker thread takes at a time.
+const sizei ANIMATION_JOBS_CHUNK_SIZE = 8;
+
+/// The amount of hierarchy nodes each worker thread takes at a time.
+const sizei HIERARCHY_JOBS_CHUNK_SIZE = 256;
+
+/// A value present at the top of each world snapshot file to denote a valid snapshot.
+///
+/// @NOTE: The value is the ASCII code of `w`.
+const u8 SNAPSHOT_VALID_IDENTIFIER = 119;
+
+/// The currently valid version of any world snapshot file.
+const u16 SNAPSHOT_VALID_VERSION   = 1;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityJobs
+struct EntityJobs {
+  ThreadPool pool;
+
+  // The dirty hierarchy nodes of every depth level
+  DynamicArray<DynamicArray<EntityID>> hierarchy_levels;
+
+  // Scratch arrays for the batched destruction of entities
+
+  DynamicArray<EntityID> dying_entities;
+  DynamicArray<PhysicsBodyID> dying_bodies;
+};
+
+static EntityJobs s_jobs;
+/// EntityJobs
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// HandlePool
+
+// @NOTE: The animation and UI objects are opaque, and are allocated by their own modules. 
+// Instead of having the components point to them, each world keeps them in pools 
+// and the components only hold an index into those pools. The updates then walk 
+// the pools from front to back without going through the entities at all.
+//
+// Removed objects leave a `nullptr` hole behind, which is reused by the next push.
+
+template<typename T>
+struct HandlePool {
+  DynamicArray<T*> objects;
+  DynamicArray<u32> free_slots;
+};
+
+template<typename T>
+static u32 handle_pool_push(HandlePool<T>& pool, T* object) {
+  if(!pool.free_slots.empty()) {
+    u32 index = pool.free_slots.back();
+    pool.free_slots.pop_back();
+
+    pool.objects[index] = object;
+    return index;
+  }
+
+  pool.objects.push_back(object);
+  return (u32)(pool.objects.size() - 1);
+}
+
+template<typename T>
+static T* handle_pool_remove(HandlePool<T>& pool, const u32 index) {
+  NIKOLA_ASSERT((index < pool.objects.size()), "Invalid index given to handle_pool_remove");
+
+  T* object = pool.objects[index];
+  
+  pool.objects[index] = nullptr;
+  pool.free_slots.push_back(index);
+
+  return object;
+}
+/// HandlePool
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// EntityPools
+
+// @NOTE: Lives in the context of each world, created on first use (see `get_pools`).
+
+struct EntityPools {
+  HandlePool<AnimationSampler> samplers;
+  HandlePool<AnimationBlender> blenders;
+  HandlePool<UIContext> ui_contexts;
+};
+/// EntityPools
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Reference components
+
+// @NOTE: The audio and animation components are opaque handles with no way to 
+// query what they were created from. These components keep the resources 
+// around so that the handles can be re-created from a snapshot.
+
+struct AudioSourceReference {
+  ResourceID buffer_id;
+};
+
+struct AnimationSamplerReference {
+  ResourceID skeleton_id;
+  DynamicArray<ResourceID> animations;
+};
+
+struct AnimationBlenderReference {
+  ResourceID skeleton_id;
+};
+
+/// Reference components
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SnapshotWriter
+
+// @NOTE: The output archive given to `entt::snapshot`. Each storage is handed 
+// over as its size followed by one packed run of entities and components.
+
+struct SnapshotWriter {
+  File* file; 
+  const EntityWorld* world;
+
+  // The owner of the next component to be written
+  EntityID current = ENTITY_NULL;
+
+  void operator()(const u32 value);
+  void operator()(const EntityID entt);
+
+  void operator()(const Transform& transform);
+  void operator()(const RenderableComponent& comp);
+  void operator()(const InstancedRenderableComponent& comp);
+  void operator()(const HierarchyComponent& comp);
+  void operator()(const PhysicsComponent& comp);
+  void operator()(const Timer& timer);
+  void operator()(const ParticleEmitter& emitter);
+  void operator()(const AudioSourceID& source);
+  void operator()(const AnimationSamplerComponent& comp);
+  void operator()(const AnimationBlenderComponent& comp);
+};
+/// SnapshotWriter
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SnapshotReader
+
+// @NOTE: The input archive given to `entt::continuous_loader`. The loader 
+// maps every entity in the file to a freshly-created one. Any data that refers 
+// to other entities gets gathered here and remapped once everything is loaded.
+
+struct SnapshotReader {
+  File* file;
+  EntityWorld* world;
+  entt::continuous_loader* loader;
+
+  // The owner of the next component to be read (in the file's IDs)
+  EntityID current = ENTITY_NULL;
+
+  // Every entity read from the file (in the file's IDs)
+  DynamicArray<EntityID> entities;
+  bool is_reading_entities = false;
+
+  // The bodies to be added to the physics world in one batch
+  DynamicArray<PhysicsBodyID> bodies;
+  DynamicArray<EntityID> bodies_owners;
+
+  // Set if any of the components could not be read properly
+  bool has_failed = false;
+
+  void operator()(u32& value);
+  void operator()(EntityID& entt);
+
+  void operator()(Transform& transform);
+  void operator()(RenderableComponent& comp);
+  void operator()(InstancedRenderableComponent& comp);
+  void operator()(HierarchyComponent& comp);
+  void operator()(PhysicsComponent& comp);
+  void operator()(Timer& timer);
+  void operator()(ParticleEmitter& emitter);
+  void operator()(AudioSourceID& source);
+  void operator()(AnimationSamplerComponent& comp);
+  void operator()(AnimationBlenderComponent& comp);
+};
+/// SnapshotReader
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void init_groups(EntityWorld& world) {
+  // @NOTE: Groups are persistent. Once created, they live inside `world` and keep 
+  // their components packed as entities come and go. Any call after the 
+  // first one is just a lookup.
+  //
+  // A component can only be owned by one group. The `Transform` is owned by the 
+  // renderables (the largest set), while the rest own their own component and only observe it.
+
+  world.group<RenderableComponent, Transform>();
+  world.group<PhysicsComponent>(entt::get<Transform>);
+  world.group<CharacterComponent>(entt::get<Transform>);
+  world.group<AnimationSamplerComponent>(entt::get<Transform, RenderableComponent>);
+  world.group<AnimationBlenderComponent>(entt::get<Transform, RenderableComponent>);
+}
+
+static EntityPools& get_pools(EntityWorld& world) {
+  EntityPools* pools = world.ctx().find<EntityPools>();
+  if(pools) {
+    return *pools;
+  }
+
+  return world.ctx().emplace<EntityPools>();
+}
+
+static bool is_ancestor(EntityWorld& world, const EntityID ancestor, EntityID entt) {
+  while(entt != ENTITY_NULL && world.any_of<HierarchyComponent>(entt)) {
+    if(entt == ancestor) {
+      return true;
+    }
+
+    entt = world.get<HierarchyComponent>(entt).parent;
+  }
+
+  return false;
+}
+
+static void unlink_from_parent(EntityWorld& world, const EntityID entt) {
+  HierarchyComponent& node = world.get<HierarchyComponent>(entt);
+  if(node.parent == ENTITY_NULL) {
+    return;
+  }
+
+  if(node.prev_sibling != ENTITY_NULL) {
+    world.get<HierarchyComponent>(node.prev_sibling).next_sibling = node.next_sibling;
+  }
+  else {
+    world.get<HierarchyComponent>(node.parent).first_child = node.next_sibling;
+  }
+
+  if(node.next_sibling != ENTITY_NULL) {
+    world.get<HierarchyComponent>(node.next_sibling).prev_sibling = node.prev_sibling;
+  }
+
+  node.parent       = ENTITY_NULL;
+  node.next_sibling = ENTITY_NULL;
+  node.prev_sibling = ENTITY_NULL;
+}
+
+static void prune_hierarchy_node(EntityWorld& world, const EntityID entt) {
+  // Roots without any children are not part of any hierarchy anymore
+
+  const HierarchyComponent& node = world.get<HierarchyComponent>(entt);
+  if(node.parent == ENTITY_NULL && node.first_child == ENTITY_NULL) {
+    world.remove<HierarchyComponent>(entt);
+  }
+}
+
+static void set_subtree_depth(EntityWorld& world, const EntityID entt, const u32 depth) {
+  HierarchyComponent& node = world.get<HierarchyComponent>(entt);
+  node.depth    = depth;
+  node.is_dirty = true;
+
+  EntityID child = node.first_child;
+  while(child != ENTITY_NULL) {
+    set_subtree_depth(world, child, depth + 1);
+    child = world.get<HierarchyComponent>(child).next_sibling;
+  }
+}
+
+static void compose_world_transform(const Transform& parent, const Transform& local, Transform& out) {
+  out.position  = parent.position + (parent.rotation * (parent.scale * local.position));
+  out.rotation  = parent.rotation * local.rotation;
+  out.scale     = parent.scale * local.scale;
+  out.transform = parent.transform * local.transform;
+}
+
+static void update_hierarchies(EntityWorld& world) {
+  auto& nodes      = world.storage<HierarchyComponent>();
+  auto& transforms = world.storage<Transform>();
+  auto& levels     = s_jobs.hierarchy_levels;
+
+  for(auto& level : levels) {
+    level.clear();
+  }
+
+  // Gather the dirty nodes of every depth level first...
+  //
+  // @NOTE: Roots are driven by their own `Transform`, which could be changed 
+  // from anywhere (the physics bodies, for example). Hence, they are compared instead.
+
+  for(auto [entt, node] : nodes.each()) {
+    if(node.parent == ENTITY_NULL && transforms.get(entt).transform != node.world_matrix) {
+      node.is_dirty = true;
+    }
+
+    if(!node.is_dirty) {
+      continue;
+    }
+
+    if(node.depth >= levels.size()) {
+      levels.resize(node.depth + 1);
+    }
+
+    levels[node.depth].push_back(entt);
+  }
+
+  // ...and then go through them one level at a time. 
+  //
+  // @NOTE: The nodes of the same level only ever read the (already updated) 
+  // transforms of their parents. Therefore, every level can be updated in parallel.
+
+  for(sizei depth = 0; depth < levels.size(); depth++) {
+    if(levels[depth].empty()) {
+      continue;
+    }
+
+    if(levels.size() <= (depth + 1)) {
+      levels.resize(depth + 2);
+    }
+
+    DynamicArray<EntityID>& level      = levels[depth];
+    DynamicArray<EntityID>& next_level = levels[depth + 1];
+
+    thread_pool_parallel_for(s_jobs.pool, level.size(), HIERARCHY_JOBS_CHUNK_SIZE, [&](const sizei begin, const sizei end) {
+      for(sizei i = begin; i < end; i++) {
+        HierarchyComponent& node = nodes.get(level[i]);
+        Transform& transform     = transforms.get(level[i]);
+
+        if(node.parent != ENTITY_NULL) {
+          compose_world_transform(transforms.get(node.parent), node.local, transform);
+        }
+
+        node.world_matrix = transform.transform;
+        node.is_dirty     = false;
+      }
+    });
+
+    // The children of every updated node are dirty now as well
+
+    for(auto entt : level) {
+      EntityID child = nodes.get(entt).first_child;
+
+      while(child != ENTITY_NULL) {
+        HierarchyComponent& child_node = nodes.get(child);
+        
+        if(!child_node.is_dirty) { // Otherwise, it is already in the next level
+          child_node.is_dirty = true;
+          next_level.push_back(child);
+        }
+
+        child = child_node.next_sibling;
+      }
+    }
+  }
+}
+
+static void acquire_resource(const ResourceID& res_id) {
+  // @NOTE: Debug renderables and default materials come with invalid IDs
+  
+  if(RESOURCE_IS_VALID(res_id)) {
+    resources_acquire(res_id);
+  }
+}
+
+static void acquire_sampler_reference(const AnimationSamplerReference& ref) {
+  acquire_resource(ref.skeleton_id);
+
+  for(auto& anim_id : ref.animations) {
+    acquire_resource(anim_id);
+  }
+}
+
+static void release_resources(EntityWorld& world, const EntityID entt) {
+  // @NOTE: Every resource an entity holds on to gets acquired when the 
+  // component is added. Otherwise, the resource manager could evict it 
+  // as soon as the entity is not rendered for a frame.
+
+  if(world.any_of<RenderableComponent>(entt)) {
+    RenderableComponent& comp = world.get<RenderableComponent>(entt);
+
+    resources_release(comp.renderable_id);
+    resources_release(comp.material_id);
+  }
+  
+  if(world.any_of<InstancedRenderableComponent>(entt)) {
+    InstancedRenderableComponent& comp = world.get<InstancedRenderableComponent>(entt);
+
+    resources_release(comp.renderable_id);
+    resources_release(comp.material_id);
+  }
+
+  if(world.any_of<ParticleEmitter>(entt)) {
+    particle_emitter_destroy(world.get<ParticleEmitter>(entt));
+  }
+
+  if(world.any_of<AudioSourceReference>(entt)) {
+    resources_release(world.get<AudioSourceReference>(entt).buffer_id);
+  }
+
+  if(world.any_of<AnimationSamplerReference>(entt)) {
+    AnimationSamplerReference& ref = world.get<AnimationSamplerReference>(entt);
+    
+    resources_release(ref.skeleton_id);
+    for(auto& anim_id : ref.animations) {
+      resources_release(anim_id);
+    }
+  }
+  
+  if(world.any_of<AnimationBlenderReference>(entt)) {
+    resources_release(world.get<AnimationBlenderReference>(entt).skeleton_id);
+  }
+}
+
+static void release_components(EntityWorld& world, const EntityID entt) {
+  // @NOTE: The physics bodies are not released here, since 
+  // they can be destroyed in batches.
+
+  release_resources(world, entt);
+
+  if(world.any_of<CharacterComponent>(entt)) {
+    CharacterComponent& comp = world.get<CharacterComponent>(entt);
+    
+    physics_world_remove_character(comp.character);
+    character_body_destroy(&comp.character);
+  }
+
+  EntityPools& pools = get_pools(world);
+
+  if(world.any_of<AnimationSamplerComponent>(entt)) {
+    u32 index = world.get<AnimationSamplerComponent>(entt)._index;
+    animation_sampler_destroy(handle_pool_remove(pools.samplers, index));
+  }
+
+  if(world.any_of<AnimationBlenderComponent>(entt)) {
+    u32 index = world.get<AnimationBlenderComponent>(entt)._index;
+    animation_blender_destroy(handle_pool_remove(pools.blenders, index));
+  }
+
+  if(world.any_of<UIContextComponent>(entt)) {
+    u32 index = world.get<UIContextComponent>(entt)._index;
+    ui_context_destroy(handle_pool_remove(pools.ui_contexts, index));
+  }
+}
+
+static void gather_subtree(EntityWorld& world, const EntityID entt, DynamicArray<EntityID>& out_entities) {
+  out_entities.push_back(entt);
+
+  if(!world.any_of<HierarchyComponent>(entt)) {
+    return;
+  }
+
+  EntityID child = world.get<HierarchyComponent>(entt).first_child;
+  while(child != ENTITY_NULL) {
+    gather_subtree(world, child, out_entities);
+    child = world.get<HierarchyComponent>(child).next_sibling;
+  }
+}
+
+static void write_resource_id(File& file, const ResourceID& res_id) {
+  u16 data[] = {
+    (u16)res_id._type, 
+    res_id._id, 
+    res_id._generation, 
+    res_id.group,
+  };
+
+  file_write_bytes(file, data, sizeof(data));
+}
+
+static void read_resource_id(File& file, ResourceID* res_id) {
+  u16 data[4];
+  file_read_bytes(file, data, sizeof(data));
+
+  res_id->_type       = (ResourceType)data[0];
+  res_id->_id         = data[1];
+  res_id->_generation = data[2];
+  res_id->group       = (ResourceGroupID)data[3];
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SnapshotWriter functions
+
+void SnapshotWriter::operator()(const u32 value) {
+  file_write_bytes(*file, &value, sizeof(u32));
+}
+
+void SnapshotWriter::operator()(const EntityID entt) {
+  current = entt;
+
+  u32 raw_id = (u32)entt;
+  file_write_bytes(*file, &raw_id, sizeof(u32));
+}
+
+void SnapshotWriter::operator()(const Transform& transform) {
+  file_write_bytes(*file, transform);
+}
+
+void SnapshotWriter::operator()(const RenderableComponent& comp) {
+  u16 type = (u16)comp.type;
+  file_write_bytes(*file, &type, sizeof(u16));
+
+  write_resource_id(*file, comp.renderable_id);
+  write_resource_id(*file, comp.material_id);
+}
+
+void SnapshotWriter::operator()(const InstancedRenderableComponent& comp) {
+  u16 type = (u16)comp.type;
+  file_write_bytes(*file, &type, sizeof(u16));
+
+  write_resource_id(*file, comp.renderable_id);
+  write_resource_id(*file, comp.material_id);
+
+  u32 transforms_count = (u32)comp.transforms.size();
+  file_write_bytes(*file, &transforms_count, sizeof(u32));
+
+  for(auto& transform : comp.transforms) {
+    file_write_bytes(*file, transform);
+  }
+}
+
+void SnapshotWriter::operator()(const HierarchyComponent& comp) {
+  u32 data[] = {
+    (u32)comp.parent, 
+    (u32)comp.first_child, 
+    (u32)comp.next_sibling, 
+    (u32)comp.prev_sibling, 
+    comp.depth,
+  };
+
+  file_write_bytes(*file, data, sizeof(data));
+  file_write_bytes(*file, comp.local);
+}
+
+void SnapshotWriter::operator()(const PhysicsComponent& comp) {
+  file_write_bytes(*file, comp.body);
+}
+
+void SnapshotWriter::operator()(const Timer& timer) {
+  file_write_bytes(*file, timer);
+}
+
+void SnapshotWriter::operator()(const ParticleEmitter& emitter) {
+  Vec3 scale = (emitter.particles_count > 0) ? emitter.transforms[0].scale : Vec3(0.2f);
+
+  f32 f_data[] = {
+    emitter.initial_position.x,
+    emitter.initial_position.y,
+    emitter.initial_position.z,
+    
+    emitter.initial_velocity.x,
+    emitter.initial_velocity.y,
+    emitter.initial_velocity.z,
+
+    scale.x, 
+    scale.y, 
+    scale.z, 
+
+    emitter.lifetime.limit,
+    emitter.gravity_factor,
+    emitter.distribution_radius,
+  };
+
+  u32 u_data[] = {
+    (u32)emitter.particles_count, 
+    (u32)emitter.distribution, 
+    (u32)emitter.is_active,
+  };
+
+  file_write_bytes(*file, f_data, sizeof(f_data));
+  file_write_bytes(*file, u_data, sizeof(u_data));
+
+  write_resource_id(*file, emitter.mesh_id);
+  write_resource_id(*file, emitter.material_id);
+}
+
+void SnapshotWriter::operator()(const AudioSourceID& source) {
+  const AudioSourceReference* ref = world->try_get<AudioSourceReference>(current);
+  NIKOLA_ASSERT(ref, "Cannot save an audio source that was not added with entity_add_audio_source");
+
+  write_resource_id(*file, ref->buffer_id);
+  file_write_bytes(*file, source);
+}
+
+void SnapshotWriter::operator()(const AnimationSamplerComponent& comp) {
+  const AnimationSamplerReference* ref = world->try_get<AnimationSamplerReference>(current);
+  NIKOLA_ASSERT(ref, "Cannot save an animation sampler that was not added with entity_add_animation_sampler");
+
+  write_resource_id(*file, ref->skeleton_id);
+
+  u32 animations_count = (u32)ref->animations.size();
+  file_write_bytes(*file, &animations_count, sizeof(u32));
+
+  for(auto& anim_id : ref->animations) {
+    write_resource_id(*file, anim_id);
+  }
+}
+
+void SnapshotWriter::operator()(const AnimationBlenderComponent& comp) {
+  const AnimationBlenderReference* ref = world->try_get<AnimationBlenderReference>(current);
+  NIKOLA_ASSERT(ref, "Cannot save an animation blender that was not added with entity_add_animation_blender");
+
+  write_resource_id(*file, ref->skeleton_id);
+}
+
+/// SnapshotWriter functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// SnapshotReader functions
+
+void SnapshotReader::operator()(u32& value) {
+  file_read_bytes(*file, &value, sizeof(u32));
+}
+
+void SnapshotReader::operator()(EntityID& entt) {
+  u32 raw_id = 0;
+  file_read_bytes(*file, &raw_id, sizeof(u32));
+
+  entt    = (EntityID)raw_id;
+  current = entt;
+
+  if(is_reading_entities) {
+    entities.push_back(entt);
+  }
+}
+
+void SnapshotReader::operator()(Transform& transform) {
+  file_read_bytes(*file, &transform);
+}
+
+void SnapshotReader::operator()(RenderableComponent& comp) {
+  u16 type = 0;
+  file_read_bytes(*file, &type, sizeof(u16));
+  comp.type = (EntityRenderableType)type;
+
+  read_resource_id(*file, &comp.renderable_id);
+  read_resource_id(*file, &comp.material_id);
+
+  acquire_resource(comp.renderable_id);
+  acquire_resource(comp.material_id);
+}
+
+void SnapshotReader::operator()(InstancedRenderableComponent& comp) {
+  u16 type = 0;
+  file_read_bytes(*file, &type, sizeof(u16));
+  comp.type = (EntityRenderableType)type;
+
+  read_resource_id(*file, &comp.renderable_id);
+  read_resource_id(*file, &comp.material_id);
+
+  acquire_resource(comp.renderable_id);
+  acquire_resource(comp.material_id);
+
+  u32 transforms_count = 0;
+  file_read_bytes(*file, &transforms_count, sizeof(u32));
+
+  comp.transforms.resize(transforms_count);
+  for(auto& transform : comp.transforms) {
+    file_read_bytes(*file, &transform);
+  }
+}
+
+void SnapshotReader::operator()(HierarchyComponent& comp) {
+  u32 data[5];
+  file_read_bytes(*file, data, sizeof(data));
+
+  // @NOTE: These are still the IDs from the file. They get 
+  // remapped after all the entities are loaded.
+
+  comp.parent       = (EntityID)data[0];
+  comp.first_child  = (EntityID)data[1];
+  comp.next_sibling = (EntityID)data[2];
+  comp.prev_sibling = (EntityID)data[3];
+  comp.depth        = data[4];
+
+  file_read_bytes(*file, &comp.local);
+  comp.is_dirty = true;
+}
+
+void SnapshotReader::operator()(PhysicsComponent& comp) {
+  // An unknown collider means the body can't be created at all. 
+  // The whole load will be undone once everything is read.
+
+  PhysicsBodyDesc desc;
+  if(!file_read_bytes(*file, &desc)) {
+    comp.body  = PhysicsBodyID{};
+    has_failed = true;
+
+    return;
+  }
+
+  // Only create the body here. It gets added to the physics world with the rest of the batch.
+
+  comp.body = physics_world_create_body(desc);
+
+  bodies.push_back(comp.body);
+  bodies_owners.push_back(current);
+}
+
+void SnapshotReader::operator()(Timer& timer) {
+  file_read_bytes(*file, &timer);
+}
+
+void SnapshotReader::operator()(ParticleEmitter& emitter) {
+  f32 f_data[12];
+  file_read_bytes(*file, f_data, sizeof(f_data));
+
+  u32 u_data[3];
+  file_read_bytes(*file, u_data, sizeof(u_data));
+
+  ParticleEmitterDesc desc = {
+    .position = Vec3(f_data[0], f_data[1], f_data[2]),
+    .velocity = Vec3(f_data[3], f_data[4], f_data[5]),
+    .scale    = Vec3(f_data[6], f_data[7], f_data[8]),
+
+    .lifetime            = f_data[9],
+    .gravity_factor      = f_data[10],
+    .distribution        = (ParticleDistributionType)u_data[1],
+    .distribution_radius = f_data[11],
+    
+    .count = (sizei)u_data[0],
+  };
+
+  read_resource_id(*file, &desc.mesh_id);
+  read_resource_id(*file, &desc.material_id);
+
+  particle_emitter_create(&emitter, desc);
+  emitter.is_active = (bool)u_data[2];
+}
+
+void SnapshotReader::operator()(AudioSourceID& source) {
+  ResourceID buffer_id;
+  read_resource_id(*file, &buffer_id);
+
+  AudioSourceDesc desc;
+  desc.buffers[0]    = resources_get_audio_buffer(buffer_id);
+  desc.buffers_count = 1;
+
+  source = audio_source_create(desc);
+  file_read_bytes(*file, &source);
+
+  acquire_resource(buffer_id);
+  world->emplace_or_replace<AudioSourceReference>(loader->map(current), buffer_id);
+}
+
+void SnapshotReader::operator()(AnimationSamplerComponent& comp) {
+  AnimationSamplerReference ref;
+  read_resource_id(*file, &ref.skeleton_id);
+
+  u32 animations_count = 0;
+  file_read_bytes(*file, &animations_count, sizeof(u32));
+
+  ref.animations.resize(animations_count);
+  for(auto& anim_id : ref.animations) {
+    read_resource_id(*file, &anim_id);
+  }
 
+  AnimationSampler* sampler = animation_sampler_create(ref.skeleton_id, ref.animations.data(), ref.animations.size());
+  comp._index               = handle_pool_push(get_pools(*world).samplers, sampler);
+
+  acquire_sampler_reference(ref);
+  world->emplace_or_replace<AnimationSamplerReference>(loader->map(current), ref);
+}
+
+void SnapshotReader::operator()(AnimationBlenderComponent& comp) {
+  ResourceID skeleton_id;
+  read_resource_id(*file, &skeleton_id);
+
+  AnimationBlender* blender = animation_blender_create(skeleton_id);
+  comp._index               = handle_pool_push(get_pools(*world).blenders, blender);
+
+  acquire_resource(skeleton_id);
+  world->emplace_or_replace<AnimationBlenderReference>(loader->map(current), skeleton_id);
+}
+
+/// SnapshotReader functions
 /// ----------------------------------------------------------------------
-/// *** Entity ***
 
 /// ----------------------------------------------------------------------
 /// EntityWorld functions
 
+void entity_world_init() {
+  // Leave a core for the main thread
+
+  sizei cores_count = (sizei)std::thread::hardware_concurrency();
+  sizei workers     = (cores_count > 1) ? (cores_count - 1) : 1;
+
+  thread_pool_create(&s_jobs.pool, "Entity jobs", workers);
+}
+
+void entity_world_shutdown() {
+  thread_pool_destroy(s_jobs.pool);
+  
+  s_jobs.pool.workers.clear();
+  s_jobs.dying_entities.clear();
+  s_jobs.dying_bodies.clear();
+}
+
 void entity_world_clear(EntityWorld& world) {
+  // Let go of any resources the entities were holding on to
+
+  for(auto entt : world.view<EntityID>()) {
+    release_resources(world, entt);
+  }
+
+  // The pooled objects are owned by the world, so they go with it
+
+  EntityPools& pools = get_pools(world);
+
+  for(auto sampler : pools.samplers.objects) {
+    if(sampler) {
+      animation_sampler_destroy(sampler);
+    }
+  }
+  
+  for(auto blender : pools.blenders.objects) {
+    if(blender) {
+      animation_blender_destroy(blender);
+    }
+  }
+  
+  for(auto ui_ctx : pools.ui_contexts.objects) {
+    if(ui_ctx) {
+      ui_context_destroy(ui_ctx);
+    }
+  }
+
+  pools = EntityPools{};
   world.clear();
 }
 
@@ -21,6 +857,8 @@ EntityID entity_world_create_entity(EntityWorld& world,
                                   const Quat& rotation,
                                   const Vec3& scale) {
   // Create a new entity
+  
+  init_groups(world);
   EntityID entt = world.create();
 
   // Add a transform component  
@@ -45,44 +883,153 @@ EntityID entity_world_create_entity(EntityWorld& world,
   return entt;
 }
 
-void entity_world_destroy_entity(EntityWorld& world, EntityID& entt) {
-  // Dispatch an event
+void entity_world_create_entities(EntityWorld& world,
+                                  const sizei count,
+                                  EntityID* out_entities,
+                                  const Vec3& position, 
+                                  const Quat& rotation,
+                                  const Vec3& scale) {
+  NIKOLA_PROFILE_FUNCTION();
+  NIKOLA_ASSERT(out_entities, "Invalid entities array given to entity_world_create_entities");
+
+  if(count == 0) {
+    return;
+  }
+
+  // Create the entities in one range
+  
+  init_groups(world);
+  world.create(out_entities, out_entities + count);
+
+  // Add the same transform component to all of them  
+
+  Transform transform; 
+  transform.position = position; 
+  transform.rotation = rotation; 
+  transform.scale    = scale;
+  transform_apply(transform);
+
+  world.insert<Transform>(out_entities, out_entities + count, transform);
+
+  // Dispatch one event for the whole batch
 
   Event event = {
-    .type    = EVENT_ENTITY_DESTROYED, 
-    .entt_id = (u32)entt,
+    .type        = EVENT_ENTITIES_ADDED, 
+    .entt_ids    = (const u32*)out_entities,
+    .entts_count = count,
   };
   event_dispatch(event);
+}
 
-  // Destroy any components that require it 
+void entity_world_destroy_entities(EntityWorld& world, const EntityID* entities, const sizei count) {
+  NIKOLA_PROFILE_FUNCTION();
+  NIKOLA_ASSERT(entities, "Invalid entities array given to entity_world_destroy_entities");
 
-  if(world.any_of<PhysicsComponent>(entt)) {
-    PhysicsComponent& comp = world.get<PhysicsComponent>(entt);
-    physics_world_remove_and_destroy_body(&comp.body);
+  // Gather the whole subtree of every entity
+
+  DynamicArray<EntityID>& dying = s_jobs.dying_entities;
+  dying.clear();
+
+  for(sizei i = 0; i < count; i++) {
+    if(world.valid(entities[i])) {
+      gather_subtree(world, entities[i], dying);
+    }
   }
 
-  if(world.any_of<CharacterComponent>(entt)) {
-    CharacterComponent& comp = world.get<CharacterComponent>(entt);
+  // An entity might have been given along with one of its ancestors
+  
+  std::sort(dying.begin(), dying.end());
+  dying.erase(std::unique(dying.begin(), dying.end()), dying.end());
+
+  if(dying.empty()) {
+    return;
+  }
+
+  // Dispatch one event for the whole batch
+
+  Event event = {
+    .type        = EVENT_ENTITIES_DESTROYED, 
+    .entt_ids    = (const u32*)dying.data(),
+    .entts_count = dying.size(),
+  };
+  event_dispatch(event);
+
+  // Unlink everything while all the nodes are still alive
+
+  for(auto& entt : dying) {
+    if(!world.any_of<HierarchyComponent>(entt)) {
+      continue;
+    }
+
+    EntityID parent = world.get<HierarchyComponent>(entt).parent;
+    unlink_from_parent(world, entt);
     
-    physics_world_remove_character(comp.character);
-    character_body_destroy(&comp.character);
+    if(parent != ENTITY_NULL) {
+      prune_hierarchy_node(world, parent);
+    }
+  }
+
+  // Destroy any components that require it 
+
+  s_jobs.dying_bodies.clear();
+
+  for(auto& entt : dying) {
+    if(world.any_of<PhysicsComponent>(entt)) {
+      s_jobs.dying_bodies.push_back(world.get<PhysicsComponent>(entt).body);
+    }
+
+    release_components(world, entt);
   }
 
-  if(world.any_of<AnimationSampler*>(entt)) {
-    AnimationSampler* sampler = world.get<AnimationSampler*>(entt);
-    animation_sampler_destroy(sampler);
+  if(!s_jobs.dying_bodies.empty()) {
+    physics_world_remove_and_destroy_bodies(s_jobs.dying_bodies.data(), s_jobs.dying_bodies.size());
   }
 
-  if(world.any_of<AnimationBlender*>(entt)) {
-    AnimationBlender* blender = world.get<AnimationBlender*>(entt);
-    animation_blender_destroy(blender);
+  // Destroy the entities in the world
+  world.destroy(dying.begin(), dying.end()); 
+}
+
+void entity_world_destroy_entity(EntityWorld& world, EntityID& entt) {
+  // Dispatch an event
+
+  Event event = {
+    .type    = EVENT_ENTITY_DESTROYED, 
+    .entt_id = (u32)entt,
+  };
+  event_dispatch(event);
+
+  // Destroy the whole subtree of the entity
+
+  if(world.any_of<HierarchyComponent>(entt)) {
+    EntityID parent = world.get<HierarchyComponent>(entt).parent;
+    unlink_from_parent(world, entt);
+    
+    if(parent != ENTITY_NULL) {
+      prune_hierarchy_node(world, parent);
+    }
+
+    EntityID child = world.get<HierarchyComponent>(entt).first_child;
+    while(child != ENTITY_NULL) {
+      HierarchyComponent& child_node = world.get<HierarchyComponent>(child);
+      EntityID next                  = child_node.next_sibling;
+
+      // No need to unlink the child from a dying parent
+      child_node.parent = ENTITY_NULL;
+      
+      entity_world_destroy_entity(world, child);
+      child = next;
+    }
   }
 
-  if(world.any_of<UIContext*>(entt)) {
-    UIContext* ui_ctx = world.get<UIContext*>(entt);
-    ui_context_destroy(ui_ctx);
+  // Destroy any components that require it 
+
+  if(world.any_of<PhysicsComponent>(entt)) {
+    PhysicsComponent& comp = world.get<PhysicsComponent>(entt);
+    physics_world_remove_and_destroy_body(&comp.body);
   }
 
+  release_components(world, entt);
+
   // Destroy the entity in the world
   world.destroy(entt); 
 }
@@ -90,21 +1037,28 @@ void entity_world_destroy_entity(EntityWorld& world, EntityID& entt) {
 void entity_world_update(EntityWorld& world, const f64 delta_time) {
   NIKOLA_PROFILE_FUNCTION();
 
+  EntityPools& pools = get_pools(world);
+
   // Physics bodies
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(PhysicsComponent)");
 
-    auto physics_view = world.view<PhysicsComponent, Transform>();
-    for(auto entt : physics_view) {
-      PhysicsComponent& physics_comp = physics_view.get<PhysicsComponent>(entt); 
-      PhysicsBodyType body_type      = physics_body_get_type(physics_comp.body);
+    auto physics_group = world.group<PhysicsComponent>(entt::get<Transform>);
+
+    // Walk the bodies in the same order they are laid out in the physics world. 
+    // Bodies rarely get added, so this is mostly one pass over already-sorted components.
+    
+    physics_group.sort<PhysicsComponent>([](const PhysicsComponent& lhs, const PhysicsComponent& rhs) {
+      return lhs.body._id < rhs.body._id;
+    }, entt::insertion_sort{});
+
+    for(auto [entt, physics_comp, transform] : physics_group.each()) {
+      PhysicsBodyType body_type = physics_body_get_type(physics_comp.body);
       
       if(body_type == PHYSICS_BODY_STATIC) { // No need to update the transforms of static bodies.
         continue;
       }
 
-      Transform& transform = physics_view.get<Transform>(entt); 
-
       transform.position = physics_body_get_position(physics_comp.body);
       transform.rotation = physics_body_get_rotation(physics_comp.body);
       transform_apply(transform);
@@ -115,10 +1069,8 @@ void entity_world_update(EntityWorld& world, const f64 delta_time) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(CharacterComponent)");
 
-    auto chars_view = world.view<CharacterComponent, Transform>();
-    for(auto entt : chars_view) {
-      Transform& transform  = chars_view.get<Transform>(entt); 
-      CharacterComponent& char_comp = chars_view.get<CharacterComponent>(entt); 
+    auto chars_group = world.group<CharacterComponent>(entt::get<Transform>);
+    for(auto [entt, char_comp, transform] : chars_group.each()) {
       character_body_update(char_comp.character);
 
       transform.position = character_body_get_position(char_comp.character);
@@ -127,35 +1079,48 @@ void entity_world_update(EntityWorld& world, const f64 delta_time) {
     }
   }
 
-  // Animation samplers
+  // Hierarchies
   {
-    NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(AnimationSampler)");
-
-    auto anim_view = world.view<AnimationSampler*>();
-    for(auto entt : anim_view) {
-      AnimationSampler* sampler = anim_view.get<AnimationSampler*>(entt);
-      animation_sampler_update(sampler, (f32)delta_time);
-    }
+    NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(HierarchyComponent)");
+    update_hierarchies(world);
   }
 
-  // Animation blenders
+  // Animations
   {
-    NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(AnimationBlender)");
-
-    auto anim_view = world.view<AnimationBlender*>();
-    for(auto entt : anim_view) {
-      AnimationBlender* blender = anim_view.get<AnimationBlender*>(entt);
-      animation_blender_update(blender, (f32)delta_time);
-    }
+    NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(Animation)");
+
+    // Update all of the pooled samplers and blenders in parallel.
+    //
+    // @NOTE: Every sampler and blender owns its own buffers and sampling 
+    // contexts, while the skeletons and animations are only ever read. 
+    // Therefore, it is safe to update them on any thread.
+
+    auto& samplers = pools.samplers.objects;
+    auto& blenders = pools.blenders.objects;
+
+    sizei samplers_count = samplers.size();
+    sizei total_count    = samplers_count + blenders.size();
+    f32 dt               = (f32)delta_time;
+
+    thread_pool_parallel_for(s_jobs.pool, total_count, ANIMATION_JOBS_CHUNK_SIZE, [&samplers, &blenders, samplers_count, dt](const sizei begin, const sizei end) {
+      for(sizei i = begin; i < end; i++) {
+        if(i < samplers_count) {
+          if(samplers[i]) {
+            animation_sampler_update(samplers[i], dt);
+          }
+        }
+        else if(blenders[i - samplers_count]) {
+          animation_blender_update(blenders[i - samplers_count], dt);
+        }
+      }
+    });
   }
 
   // Timers
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(Timer)");
 
-    auto timer_view = world.view<Timer>();
-    for(auto entt : timer_view) {
-      Timer& timer = timer_view.get<Timer>(entt);
+    for(auto& timer : world.storage<Timer>()) {
       timer_update(timer, (f32)delta_time);
     }
   }
@@ -164,9 +1129,7 @@ void entity_world_update(EntityWorld& world, const f64 delta_time) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(ParticleEmitter)");
 
-    auto view = world.view<ParticleEmitter>();
-    for(auto entt : view) {
-      ParticleEmitter& emitter = view.get<ParticleEmitter>(entt);
+    for(auto& emitter : world.storage<ParticleEmitter>()) {
       particle_emitter_update(emitter, (f32)delta_time); 
     }
   }
@@ -175,10 +1138,10 @@ void entity_world_update(EntityWorld& world, const f64 delta_time) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_update(UIContext)");
 
-    auto view = world.view<UIContext*>();
-    for(auto entt : view) {
-      UIContext* ui_ctx = view.get<UIContext*>(entt);
-      ui_context_update(ui_ctx); 
+    for(auto ui_ctx : pools.ui_contexts.objects) {
+      if(ui_ctx) {
+        ui_context_update(ui_ctx); 
+      }
     }
   }
 }
@@ -186,15 +1149,19 @@ void entity_world_update(EntityWorld& world, const f64 delta_time) {
 void entity_world_render(const EntityWorld& world) {
   NIKOLA_PROFILE_FUNCTION();
 
+  // @NOTE: The pools are created along with the first pooled component. 
+  // Until then, the animation groups below are empty anyway.
+  const EntityPools* pools = world.ctx().find<EntityPools>();
+
   // Renderables
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render(RenderableComponent)");
 
-    auto view = world.view<RenderableComponent, Transform>();
-    for(auto entt : view) {
-      const Transform& transform            = view.get<Transform>(entt);
-      const RenderableComponent& renderable = view.get<RenderableComponent>(entt);
+    // @NOTE: Both components are owned by the group. Hence, they are 
+    // iterated side by side in the same order.
 
+    auto group = world.group_if_exists<RenderableComponent, Transform>();
+    for(auto [entt, renderable, transform] : group.each()) {
       switch(renderable.type) {
         case ENTITY_RENDERABLE_MESH:
           renderer_queue_mesh(renderable.renderable_id, transform, renderable.material_id);
@@ -216,11 +1183,8 @@ void entity_world_render(const EntityWorld& world) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render(InstancedRenderableComponent)");
 
-    auto view = world.view<InstancedRenderableComponent, Transform>();
-    for(auto entt : view) {
-      const Transform& transform                     = view.get<Transform>(entt);
-      const InstancedRenderableComponent& renderable = view.get<InstancedRenderableComponent>(entt);
-
+    auto view = world.view<InstancedRenderableComponent>();
+    for(auto [entt, renderable] : view.each()) {
       switch(renderable.type) {
         case ENTITY_RENDERABLE_MESH:
           renderer_queue_mesh_instanced(renderable.renderable_id, renderable.transforms.data(), renderable.transforms.size(), renderable.material_id);
@@ -242,13 +1206,10 @@ void entity_world_render(const EntityWorld& world) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render(AnimationSampler)");
 
-    auto view = world.view<AnimationSampler*, Transform>();
-    for(auto entt : view) {
-      const Transform& transform            = view.get<Transform>(entt);
-      const AnimationSampler* sampler       = view.get<AnimationSampler*>(entt);
-      const RenderableComponent& renderable = world.get<RenderableComponent>(entt);
-
-      renderer_queue_animation(renderable.renderable_id, transform, sampler, renderable.material_id);
+    auto group = world.group_if_exists<AnimationSamplerComponent>(entt::get<Transform, RenderableComponent>);
+    for(auto [entt, sampler, transform, renderable] : group.each()) {
+      const AnimationSampler* object = pools->samplers.objects[sampler._index];
+      renderer_queue_animation(renderable.renderable_id, transform, object, renderable.material_id);
     }
   }
 
@@ -256,13 +1217,10 @@ void entity_world_render(const EntityWorld& world) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render(AnimationBlender)");
 
-    auto view = world.view<AnimationBlender*, Transform>();
-    for(auto entt : view) {
-      const Transform& transform            = view.get<Transform>(entt);
-      const AnimationBlender* blender       = view.get<AnimationBlender*>(entt);
-      const RenderableComponent& renderable = world.get<RenderableComponent>(entt);
-
-      renderer_queue_animation(renderable.renderable_id, transform, blender, renderable.material_id);
+    auto group = world.group_if_exists<AnimationBlenderComponent>(entt::get<Transform, RenderableComponent>);
+    for(auto [entt, blender, transform, renderable] : group.each()) {
+      const AnimationBlender* object = pools->blenders.objects[blender._index];
+      renderer_queue_animation(renderable.renderable_id, transform, object, renderable.material_id);
     }
   }
   
@@ -270,11 +1228,8 @@ void entity_world_render(const EntityWorld& world) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render(ParticleEmitter)");
 
-    auto view = world.view<ParticleEmitter, Transform>();
-    for(auto entt : view) {
-      const Transform& transform     = view.get<Transform>(entt);
-      const ParticleEmitter& emitter = view.get<ParticleEmitter>(entt);
-
+    auto view = world.view<ParticleEmitter>();
+    for(auto [entt, emitter] : view.each()) {
       renderer_queue_particles(emitter);
     }
   }
@@ -285,12 +1240,183 @@ void entity_world_render_ui(const EntityWorld& world) {
   {
     NIKOLA_PROFILE_FUNCTION_NAMED("entity_world_render_ui(UIContext)");
 
-    auto view = world.view<UIContext*>();
-    for(auto entt : view) {
-      UIContext* ui_ctx = view.get<UIContext*>(entt);
-      ui_context_render(ui_ctx); 
+    const EntityPools* pools = world.ctx().find<EntityPools>();
+    if(!pools) {
+      return;
+    }
+
+    for(auto ui_ctx : pools->ui_contexts.objects) {
+      if(ui_ctx) {
+        ui_context_render(ui_ctx); 
+      }
+    }
+  }
+}
+
+bool entity_world_save(const EntityWorld& world, const FilePath& path) {
+  NIKOLA_PROFILE_FUNCTION();
+
+  File file;
+  if(!file_open(&file, path, (i32)(FILE_OPEN_WRITE | FILE_OPEN_BINARY | FILE_OPEN_TRUNCATE))) {
+    NIKOLA_LOG_ERROR("Could not open the world snapshot file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  // Header
+
+  u8 identifier = SNAPSHOT_VALID_IDENTIFIER;
+  u16 version   = SNAPSHOT_VALID_VERSION;
+
+  file_write_bytes(file, &identifier, sizeof(u8));
+  file_write_bytes(file, &version, sizeof(u16));
+
+  // Components
+
+  // @NOTE: The order here _MUST_ match the order in `entity_world_load`.
+
+  SnapshotWriter writer = {
+    .file  = &file,
+    .world = &world,
+  };
+
+  entt::snapshot{world}
+    .get<EntityID>(writer)
+    .get<Transform>(writer)
+    .get<RenderableComponent>(writer)
+    .get<InstancedRenderableComponent>(writer)
+    .get<HierarchyComponent>(writer)
+    .get<PhysicsComponent>(writer)
+    .get<Timer>(writer)
+    .get<ParticleEmitter>(writer)
+    .get<AudioSourceID>(writer)
+    .get<AnimationSamplerComponent>(writer)
+    .get<AnimationBlenderComponent>(writer);
+
+  file_close(file);
+  return true;
+}
+
+bool entity_world_load(EntityWorld& world, const FilePath& path) {
+  NIKOLA_PROFILE_FUNCTION();
+
+  File file;
+  if(!file_open(&file, path, (i32)(FILE_OPEN_READ | FILE_OPEN_BINARY))) {
+    NIKOLA_LOG_ERROR("Could not open the world snapshot file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  // Header
+
+  u8 identifier = 0;
+  u16 version   = 0;
+
+  file_read_bytes(file, &identifier, sizeof(u8));
+  file_read_bytes(file, &version, sizeof(u16));
+
+  if(identifier != SNAPSHOT_VALID_IDENTIFIER || version != SNAPSHOT_VALID_VERSION) {
+    NIKOLA_LOG_ERROR("Invalid world snapshot file at \'%s\'", path.c_str());
+
+    file_close(file);
+    return false;
+  }
+
+  // Components
+
+  init_groups(world);
+  entt::continuous_loader loader{world};
+
+  SnapshotReader reader = {
+    .file   = &file,
+    .world  = &world,
+    .loader = &loader,
+  };
+
+  reader.is_reading_entities = true;
+  loader.get<EntityID>(reader);
+  reader.is_reading_entities = false;
+
+  loader.get<Transform>(reader)
+    .get<RenderableComponent>(reader)
+    .get<InstancedRenderableComponent>(reader)
+    .get<HierarchyComponent>(reader)
+    .get<PhysicsComponent>(reader)
+    .get<Timer>(reader)
+    .get<ParticleEmitter>(reader)
+    .get<AudioSourceID>(reader)
+    .get<AnimationSamplerComponent>(reader)
+    .get<AnimationBlenderComponent>(reader);
+
+  file_close(file);
+
+  // Undo everything that was loaded if the file turned out to be broken
+
+  if(reader.has_failed) {
+    NIKOLA_LOG_ERROR("Invalid component data in the world snapshot file at \'%s\'", path.c_str());
+
+    for(auto& body : reader.bodies) {
+      physics_world_destroy_body(&body);
+    }
+
+    for(auto& remote : reader.entities) {
+      if(!loader.contains(remote)) {
+        continue;
+      }
+
+      EntityID entt = loader.map(remote);
+
+      release_components(world, entt);
+      world.destroy(entt);
+    }
+
+    return false;
+  }
+
+  // Add all the physics bodies in one batch
+
+  if(!reader.bodies.empty()) {
+    for(sizei i = 0; i < reader.bodies.size(); i++) {
+      physics_body_set_user_data(reader.bodies[i], (u64)loader.map(reader.bodies_owners[i]));
+    }
+
+    PhysicsBatchHandle batch = physics_world_prepare_bodies(reader.bodies.data(), reader.bodies.size());
+    physics_world_finalize_bodies(reader.bodies.data(), reader.bodies.size(), batch);
+  }
+
+  // Remap the hierarchies
+
+  DynamicArray<EntityID> loaded;
+  loaded.reserve(reader.entities.size());
+
+  for(auto& remote : reader.entities) {
+    // Skip the destroyed entities that were kept for their versions
+    if(!loader.contains(remote)) {
+      continue;
+    }
+
+    EntityID entt = loader.map(remote);
+    loaded.push_back(entt);
+
+    if(world.any_of<HierarchyComponent>(entt)) {
+      HierarchyComponent& node = world.get<HierarchyComponent>(entt);
+
+      node.parent       = loader.map(node.parent);
+      node.first_child  = loader.map(node.first_child);
+      node.next_sibling = loader.map(node.next_sibling);
+      node.prev_sibling = loader.map(node.prev_sibling);
     }
   }
+
+  // Let everyone know about the new entities
+
+  Event event = {
+    .type        = EVENT_ENTITIES_ADDED,
+    .entt_ids    = (const u32*)loaded.data(),
+    .entts_count = loaded.size(),
+  };
+  event_dispatch(event);
+
+  NIKOLA_LOG_INFO("Loaded %zu entities from \'%s\'", loaded.size(), path.c_str());
+  return true;
 }
 
 /// EntityWorld functions
@@ -308,7 +1434,11 @@ void entity_add_physics_body(EntityWorld& world,
   desc.position     = transform.position;
   desc.rotation     = transform.rotation;
   desc.user_data    = (u64)entt;
-  PhysicsBody* body = physics_world_create_and_add_body(desc);
+
+  // Only bodies with a callback need to hear about their contacts
+  desc.has_contact_events = desc.has_contact_events || (coll_func != nullptr);
+
+  PhysicsBodyID body = physics_world_create_and_add_body(desc);
 
   world.emplace<PhysicsComponent>(entt, body, coll_func);
 }
@@ -340,6 +1470,9 @@ void entity_add_audio_source(EntityWorld& world,
   desc.buffers_count = 1;
 
   world.emplace<AudioSourceID>(entt, audio_source_create(desc));
+  
+  acquire_resource(audio_buffer_id);
+  world.emplace_or_replace<AudioSourceReference>(entt, audio_buffer_id);
 }
 
 void entity_add_timer(EntityWorld& world, 
@@ -368,7 +1501,13 @@ void entity_add_animation_sampler(EntityWorld& world,
                                   const ResourceID& skeleton_id, 
                                   const ResourceID& animation_id) {
   AnimationSampler* sampler = animation_sampler_create(skeleton_id, animation_id); 
-  world.emplace<AnimationSampler*>(entt, sampler);
+  world.emplace<AnimationSamplerComponent>(entt, handle_pool_push(get_pools(world).samplers, sampler));
+
+  AnimationSamplerReference ref = {.skeleton_id = skeleton_id};
+  ref.animations.push_back(animation_id);
+  
+  acquire_sampler_reference(ref);
+  world.emplace_or_replace<AnimationSamplerReference>(entt, ref);
 }
 
 void entity_add_animation_sampler(EntityWorld& world, 
@@ -377,16 +1516,26 @@ void entity_add_animation_sampler(EntityWorld& world,
                                   const ResourceID* animations, 
                                   const sizei animations_count) {
   AnimationSampler* sampler = animation_sampler_create(skeleton_id, animations, animations_count); 
-  world.emplace<AnimationSampler*>(entt, sampler);
+  world.emplace<AnimationSamplerComponent>(entt, handle_pool_push(get_pools(world).samplers, sampler));
+
+  AnimationSamplerReference ref = {.skeleton_id = skeleton_id};
+  ref.animations.assign(animations, animations + animations_count);
+  
+  acquire_sampler_reference(ref);
+  world.emplace_or_replace<AnimationSamplerReference>(entt, ref);
 }
 
 void entity_add_animation_blender(EntityWorld& world, EntityID& entt, const ResourceID& skeleton_id) {
   AnimationBlender* blender = animation_blender_create(skeleton_id);
-  world.emplace<AnimationBlender*>(entt, blender);
+  world.emplace<AnimationBlenderComponent>(entt, handle_pool_push(get_pools(world).blenders, blender));
+  
+  acquire_resource(skeleton_id);
+  world.emplace_or_replace<AnimationBlenderReference>(entt, skeleton_id);
 }
 
 void entity_add_ui_context(EntityWorld& world, EntityID& entt, const String& name, const IVec2& bounds) {
-  world.emplace<UIContext*>(entt, ui_context_create(name, bounds));
+  UIContext* ui_ctx = ui_context_create(name, bounds);
+  world.emplace<UIContextComponent>(entt, handle_pool_push(get_pools(world).ui_contexts, ui_ctx));
 }
 
 void entity_add_renderable(EntityWorld& world, 
@@ -394,6 +1543,9 @@ void entity_add_renderable(EntityWorld& world,
                            const EntityRenderableType renderable_type, 
                            const ResourceID& renderable_id, 
                            const ResourceID& material_id) {
+  acquire_resource(renderable_id);
+  acquire_resource(material_id);
+
   world.emplace<RenderableComponent>(entt, renderable_type, renderable_id, material_id);
 }
 
@@ -403,9 +1555,100 @@ void entity_add_instanced_renderable(EntityWorld& world,
                                      const DynamicArray<Transform>& transforms,
                                      const ResourceID& renderable_id, 
                                      const ResourceID& material_id) {
+  acquire_resource(renderable_id);
+  acquire_resource(material_id);
+
   world.emplace<InstancedRenderableComponent>(entt, renderable_type, renderable_id, material_id, transforms);
 }
 
+void entity_attach(EntityWorld& world, EntityID& entt, EntityID& parent, const Transform& local) {
+  NIKOLA_ASSERT((entt != parent), "Cannot attach an entity to itself");
+  NIKOLA_ASSERT(!is_ancestor(world, entt, parent), "Cannot attach an entity to one of its descendants");
+
+  world.get_or_emplace<HierarchyComponent>(entt);
+  world.get_or_emplace<HierarchyComponent>(parent);
+
+  // Leave the old parent first
+
+  EntityID old_parent = world.get<HierarchyComponent>(entt).parent;
+  unlink_from_parent(world, entt);
+
+  // Link at the front of the children list
+
+  HierarchyComponent& node        = world.get<HierarchyComponent>(entt);
+  HierarchyComponent& parent_node = world.get<HierarchyComponent>(parent);
+
+  node.parent       = parent;
+  node.next_sibling = parent_node.first_child;
+  node.local        = local;
+  transform_apply(node.local);
+
+  if(parent_node.first_child != ENTITY_NULL) {
+    world.get<HierarchyComponent>(parent_node.first_child).prev_sibling = entt;
+  }
+  parent_node.first_child = entt;
+
+  set_subtree_depth(world, entt, parent_node.depth + 1);
+
+  // @NOTE: Pruning could remove a component. It must come after every reference is done.
+
+  if(old_parent != ENTITY_NULL) {
+    prune_hierarchy_node(world, old_parent);
+  }
+}
+
+void entity_detach(EntityWorld& world, EntityID& entt) {
+  if(!world.any_of<HierarchyComponent>(entt)) {
+    return;
+  }
+
+  EntityID parent = world.get<HierarchyComponent>(entt).parent;
+  if(parent == ENTITY_NULL) {
+    return;
+  }
+
+  // The current world transform stays as the root's transform
+
+  unlink_from_parent(world, entt);
+  set_subtree_depth(world, entt, 0);
+
+  prune_hierarchy_node(world, parent);
+  prune_hierarchy_node(world, entt);
+}
+
+void entity_set_local_transform(EntityWorld& world, EntityID& entt, const Transform& local) {
+  HierarchyComponent* node = world.try_get<HierarchyComponent>(entt);
+
+  // Roots are their own world transform
+
+  if(!node || node->parent == ENTITY_NULL) {
+    Transform& transform = world.get<Transform>(entt);
+    transform            = local;
+    transform_apply(transform);
+
+    return;
+  }
+
+  node->local    = local;
+  node->is_dirty = true;
+  transform_apply(node->local);
+}
+
+AnimationSampler* entity_get_animation_sampler(EntityWorld& world, EntityID& entt) {
+  u32 index = world.get<AnimationSamplerComponent>(entt)._index;
+  return get_pools(world).samplers.objects[index];
+}
+
+AnimationBlender* entity_get_animation_blender(EntityWorld& world, EntityID& entt) {
+  u32 index = world.get<AnimationBlenderComponent>(entt)._index;
+  return get_pools(world).blenders.objects[index];
+}
+
+UIContext* entity_get_ui_context(EntityWorld& world, EntityID& entt) {
+  u32 index = world.get<UIContextComponent>(entt)._index;
+  return get_pools(world).ui_contexts.objects[index];
+}
+
 /// EntityID functions
 /// ----------------------------------------------------------------------
 
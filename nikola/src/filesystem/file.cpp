@@ -573,7 +573,7 @@ void file_write_bytes(File& file, const Timer& timer) {
   file_write_bytes(file, &timer.is_active, sizeof(timer.is_active));
 }
 
-void file_write_bytes(File& file, const PhysicsBody* body) {
+void file_write_bytes(File& file, const PhysicsBodyID& body) {
   NIKOLA_ASSERT(file.is_open(), "Cannot perform an operation on an unopened file");
  
   Vec3 position = physics_body_get_position(body);
@@ -585,6 +585,14 @@ void file_write_bytes(File& file, const PhysicsBody* body) {
   
   PhysicsBodyType type     = physics_body_get_type(body);
   PhysicsObjectLayer layer = physics_body_get_layer(body);
+  bool is_sensor           = physics_body_is_sensor(body);
+  bool has_contact_events  = physics_body_has_contact_events(body);
+
+  Collider* collider = physics_body_get_collider(body);
+  NIKOLA_ASSERT(collider, "Cannot write a physics body without a collider");
+
+  ColliderType collider_type = collider_get_type(collider);
+  Vec3 extents               = collider_get_extents(collider);
 
   f32 f_data[] = {
     position.x,   
@@ -599,11 +607,18 @@ void file_write_bytes(File& file, const PhysicsBody* body) {
     restitution, 
     friction, 
     gravity_factor,
+
+    extents.x,
+    extents.y,
+    extents.z,
   };
 
   u16 u_data[] = {
     (u16)type, 
     (u16)layer,
+    (u16)collider_type,
+    (u16)is_sensor,
+    (u16)has_contact_events,
   };
 
   file_write_bytes(file, f_data, sizeof(f_data));
@@ -1084,15 +1099,15 @@ void file_read_bytes(File& file, Timer* timer) {
   file_read_bytes(file, &timer->is_active, sizeof(timer->is_active));
 }
 
-void file_read_bytes(File& file, PhysicsBodyDesc* body_desc) {
+bool file_read_bytes(File& file, PhysicsBodyDesc* body_desc) {
   NIKOLA_ASSERT(file.is_open(), "Cannot perform an operation on an unopened file");
 
   // Read the data from the file
 
-  f32 f_data[10];
+  f32 f_data[13];
   file_read_bytes(file, f_data, sizeof(f_data));
 
-  u16 u_data[2];
+  u16 u_data[5];
   file_read_bytes(file, u_data, sizeof(u_data));
 
   // Make sense of the data
@@ -1104,8 +1119,33 @@ void file_read_bytes(File& file, PhysicsBodyDesc* body_desc) {
   f32 friction       = f_data[8];
   f32 gravity_factor = f_data[9];
 
-  PhysicsBodyType type     = (PhysicsBodyType)u_data[0];
-  PhysicsObjectLayer layer = (PhysicsObjectLayer)u_data[1];
+  Vec3 extents = Vec3(f_data[10], f_data[11], f_data[12]);
+
+  PhysicsBodyType type       = (PhysicsBodyType)u_data[0];
+  PhysicsObjectLayer layer   = (PhysicsObjectLayer)u_data[1];
+  ColliderType collider_type = (ColliderType)u_data[2];
+  bool is_sensor             = (bool)u_data[3];
+  bool has_contact_events    = (bool)u_data[4];
+
+  // Re-create the collider from its extents
+
+  Collider* collider = nullptr;
+  switch(collider_type) {
+    case COLLIDER_BOX:
+      collider = collider_create(BoxColliderDesc{.half_size = extents});
+      break;
+    case COLLIDER_SPHERE:
+      collider = collider_create(SphereColliderDesc{.radius = extents.x});
+      break;
+    case COLLIDER_CAPSULE:
+      collider = collider_create(CapsuleColliderDesc{.half_height = extents.y, .radius = extents.x});
+      break;
+    default:
+      NIKOLA_LOG_ERROR("Invalid collider type \'%i\' found while reading a physics body", (i32)collider_type);
+      
+      body_desc->collider = nullptr;
+      return false;
+  }
 
   // Fill in the body desc
   
@@ -1118,6 +1158,12 @@ void file_read_bytes(File& file, PhysicsBodyDesc* body_desc) {
 
   body_desc->type   = type;
   body_desc->layers = layer;
+
+  body_desc->collider           = collider;
+  body_desc->is_sensor          = is_sensor;
+  body_desc->has_contact_events = has_contact_events;
+
+  return true;
 }
 
 void file_read_string(File& file, String* str) {
@@ -1,13 +1,65 @@
 #include "nikola/nikola_base.h"
 #include "nikola/nikola_file.h"
 
-#include <filewatch/FileWatch.hpp> 
+#include <filewatch/FileWatch.hpp>
+
+#include <chrono>
 
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola {
 
-// @TODO (Filesystem): This doesn't work, because fuck me...
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The amount of time (in seconds) a file has to stay "quiet" before its
+/// events are dispatched. Editors and exporters tend to write a file in
+/// multiple chunks, which would otherwise trigger a reload for each chunk.
+const f64 FILEWATCHER_DEBOUNCE_TIME = 0.25;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// WatchEntry
+struct WatchEntry {
+  FilePath path;
+  bool is_dir;
+
+  FileWatchFunc callback;
+  void* user_data;
+
+  filewatch::FileWatch<FilePath>* handle = nullptr;
+};
+/// WatchEntry
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// PendingEvent
+struct PendingEvent {
+  FileStatus status;
+  sizei entry_index;
+
+  std::chrono::steady_clock::time_point last_seen;
+};
+/// PendingEvent
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// FileWatcher
+struct FileWatcher {
+  DynamicArray<WatchEntry*> entries;
+
+  // The events are pushed by the watcher threads and
+  // consumed on the main thread. Hence, the lock.
+
+  std::mutex events_mutex;
+  HashMap<FilePath, PendingEvent> pending_events;
+};
+
+static FileWatcher s_watcher;
+/// FileWatcher
+///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
@@ -16,41 +68,167 @@ static FileStatus get_nikola_status(const filewatch::Event event) {
   switch(event) {
     case filewatch::Event::added:
       return FILE_STATUS_CREATED;
-	  case filewatch::Event::removed:
+    case filewatch::Event::removed:
       return FILE_STATUS_DELETED;
-	  case filewatch::Event::modified:
+    case filewatch::Event::modified:
       return FILE_STATUS_MODIFIED;
-	  case filewatch::Event::renamed_old:
+    case filewatch::Event::renamed_old:
     case filewatch::Event::renamed_new:
       return FILE_STATUS_RENAMED;
+    default:
+      return FILE_STATUS_MODIFIED;
   }
 }
 
+static bool merge_status(FileStatus& status, const FileStatus new_status) {
+  // A file that was just created and then deleted (temporary files, for example) 
+  // never existed as far as the user is concerned. The event should be dropped.
+
+  if(status == FILE_STATUS_CREATED && new_status == FILE_STATUS_DELETED) {
+    return false;
+  }
+
+  // A file that was just created and then modified (which happens a lot
+  // with exporters) is still a newly-created file as far as the user is concerned.
+
+  if(status == FILE_STATUS_CREATED && new_status == FILE_STATUS_MODIFIED) {
+    return true;
+  }
+
+  // A deleted file that comes back again is just a modification.
+
+  if(status == FILE_STATUS_DELETED && new_status == FILE_STATUS_CREATED) {
+    status = FILE_STATUS_MODIFIED;
+    return true;
+  }
+
+  status = new_status;
+  return true;
+}
+
+static void push_event(const sizei entry_index, const FilePath& watched_path, const filewatch::Event event) {
+  std::lock_guard<std::mutex> lock(s_watcher.events_mutex);
+  WatchEntry* entry = s_watcher.entries[entry_index];
+
+  // Directories report paths relative to themselves, while
+  // single files only report their names.
+  FilePath full_path = entry->is_dir ? filepath_append(entry->path, watched_path) : entry->path;
+  FileStatus status  = get_nikola_status(event);
+
+  auto pending = s_watcher.pending_events.find(full_path);
+  if(pending == s_watcher.pending_events.end()) {
+    s_watcher.pending_events[full_path] = PendingEvent {
+      .status      = status,
+      .entry_index = entry_index,
+      .last_seen   = std::chrono::steady_clock::now(),
+    };
+
+    return;
+  }
+
+  // Coalesce the events of the same file together
+
+  if(!merge_status(pending->second.status, status)) {
+    s_watcher.pending_events.erase(pending);
+    return;
+  }
+
+  pending->second.last_seen = std::chrono::steady_clock::now();
+}
+
+static void add_watch_entry(const FilePath& path, const bool is_dir, const FileWatchFunc& callback, const void* user_data) {
+  if(!filesystem_exists(path)) {
+    NIKOLA_LOG_WARN("Cannot watch non-existent path \'%s\'", path.c_str());
+    return;
+  }
+
+  WatchEntry* entry = new WatchEntry {
+    .path      = path,
+    .is_dir    = is_dir,
+    .callback  = callback,
+    .user_data = (void*)user_data,
+  };
+
+  // The entry needs to be in the array _before_ the watcher gets
+  // created since the watcher thread can start pushing events right away.
+
+  sizei entry_index = 0;
+  {
+    std::lock_guard<std::mutex> lock(s_watcher.events_mutex);
+
+    s_watcher.entries.push_back(entry);
+    entry_index = s_watcher.entries.size() - 1;
+  }
+
+  entry->handle = new filewatch::FileWatch<FilePath>(
+    path,
+    [entry_index](const FilePath& watched_path, const filewatch::Event event) {
+      push_event(entry_index, watched_path, event);
+    }
+  );
+}
+
 /// Private functions
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
-/// Filewatcher functions 
+/// Filewatcher functions
 
 void filewatcher_add_file(const FilePath& path, const FileWatchFunc& callback, const void* user_data) {
-  filewatch::FileWatch<FilePath> watcher(
-    path, 
-    [=](const FilePath& watched_path, const filewatch::Event event) {
-      callback(get_nikola_status(event), watched_path, (void*)user_data);
-    }
-  ); 
+  add_watch_entry(path, false, callback, user_data);
 }
 
 void filewatcher_add_dir(const FilePath& dir, const FileWatchFunc& callback, const void* user_data) {
-  filewatch::FileWatch<FilePath> watcher(
-    dir, 
-    [=](const FilePath& watched_path, const filewatch::Event event) {
-      callback(get_nikola_status(event), watched_path, (void*)user_data);
+  add_watch_entry(dir, true, callback, user_data);
+}
+
+void filewatcher_update() {
+  // Collect all the events that have been "quiet" for long enough
+
+  DynamicArray<std::pair<FilePath, PendingEvent>> ready_events;
+  {
+    std::lock_guard<std::mutex> lock(s_watcher.events_mutex);
+    if(s_watcher.pending_events.empty()) {
+      return;
     }
-  ); 
+
+    auto now = std::chrono::steady_clock::now();
+
+    for(auto it = s_watcher.pending_events.begin(); it != s_watcher.pending_events.end();) {
+      std::chrono::duration<f64> quiet_time = now - it->second.last_seen;
+      if(quiet_time.count() < FILEWATCHER_DEBOUNCE_TIME) {
+        it++;
+        continue;
+      }
+
+      ready_events.push_back(*it);
+      it = s_watcher.pending_events.erase(it);
+    }
+  }
+
+  // Dispatch the events on the main thread, outside of the lock,
+  // since the callbacks can take a while (reloading resources, for example).
+
+  for(auto& [path, event] : ready_events) {
+    WatchEntry* entry = s_watcher.entries[event.entry_index]; // Entries are only ever added on this thread
+    entry->callback(event.status, path, entry->user_data);
+  }
+}
+
+void filewatcher_shutdown() {
+  // Destroying the watchers will join their threads first, so no
+  // events can be pushed after this point.
+
+  for(auto& entry : s_watcher.entries) {
+    delete entry->handle;
+    delete entry;
+  }
+
+  s_watcher.entries.clear();
+  s_watcher.pending_events.clear();
 }
 
-/// Filewatcher functions 
+/// Filewatcher functions
 ///---------------------------------------------------------------------------------------------------------------------
 
 } // End of nikola
@@ -7,6 +7,7 @@
 #include <glad/glad.h>
 
 #include <cstring>
+#include <algorithm>
 
 namespace nikola { // Start of nikola
 
@@ -16,15 +17,6 @@ namespace nikola { // Start of nikola
 ///---------------------------------------------------------------------------------------------------------------------
 /// Macros
 
-#define SET_GFX_STATE(value, state) { \
-  if(value) {                         \
-    glEnable(state);                  \
-  }                                   \
-  else {                              \
-    glDisable(state);                 \
-  }                                   \
-}
-
 #define SET_BUFFER_BIT(value, bits, buffer) { \
   if(value) {                                 \
     SET_BIT(bits, buffer);                    \
@@ -37,12 +29,79 @@ namespace nikola { // Start of nikola
 /// Macros
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The number of `GfxBufferType` entries. Used to size the buffer binding caches.
+const sizei GFX_BUFFER_TYPES_COUNT = GFX_BUFFER_DRAW_INDIRECT + 1;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxStateCache
+
+// @NOTE: A mirror of the state currently set in the driver. Every state 
+// change goes through the cache first, and only reaches the driver if the 
+// cached value differs. The initial values are the OpenGL defaults.
+
+struct GfxStateCache {
+  u32 program      = 0; 
+  u32 vertex_array = 0; 
+  u32 framebuffer  = 0;
+
+  u32 texture_units[TEXTURES_MAX] = {};
+
+  u32 buffers[GFX_BUFFER_TYPES_COUNT]                           = {};
+  u32 buffer_bases[GFX_BUFFER_TYPES_COUNT][UNIFORM_BUFFERS_MAX] = {};
+
+  u32 enabled_states = GFX_STATE_MSAA; // GL_MULTISAMPLE is enabled by default
+
+  GLenum depth_func = GL_LESS;
+  bool depth_mask   = true;
+
+  GLenum stencil_face      = GL_FRONT_AND_BACK; 
+  GLenum stencil_func      = GL_ALWAYS;
+  i32 stencil_ref          = 0;
+  u32 stencil_read_mask    = 0xffffffff;
+  GLenum stencil_ops[3]    = {GL_KEEP, GL_KEEP, GL_KEEP};
+  u32 stencil_write_mask   = 0xffffffff;
+  bool is_write_mask_known = true;
+
+  GLenum blend_funcs[4] = {GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
+  f32 blend_color[4]    = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  GLenum cull_face  = GL_BACK; 
+  GLenum front_face = GL_CCW;
+
+  i32 scissor[4]  = {0, 0, 0, 0};
+  i32 viewport[4] = {0, 0, 0, 0};
+};
+/// GfxStateCache
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// GfxContext
 struct GfxContext {
   GfxContextDesc desc = {};
   GfxStates states;
 
+  GfxStateCache cache;
+
+  GfxContextStats frame_stats; 
+  GfxContextStats stats;
+
+  // @NOTE: Every frame region of the stream buffers is guarded by a fence. 
+  // The fence is placed once the frame is presented, and waited on right 
+  // before the region gets written to again.
+
+  DynamicArray<GfxBuffer*> stream_buffers;
+  GLsync stream_fences[STREAM_BUFFER_REGIONS_MAX];
+  u32 stream_region;
+  sizei stream_alignment;
+
+  GfxBuffer* indirect_buffer = nullptr;
+
   u32 current_target = 0; 
 
   u32 default_clear_flags = 0;
@@ -58,6 +117,7 @@ struct GfxContext {
 /// GfxFramebuffer
 struct GfxFramebuffer {
   GfxFramebufferDesc desc = {};
+  GfxContext* gfx         = nullptr;
   
   u32 clear_flags;
   u32 id;
@@ -79,6 +139,12 @@ struct GfxBuffer {
 
   GLenum gl_buff_type; 
   GLenum gl_buff_usage;
+
+  // Stream buffers only
+
+  u8* mapped_data   = nullptr;
+  sizei region_size = 0;
+  i32 bind_point    = -1;
 };
 /// GfxBuffer  
 ///---------------------------------------------------------------------------------------------------------------------
@@ -135,11 +201,35 @@ struct GfxPipeline {
   GfxBuffer* instance_buffer = nullptr; 
   sizei instance_count       = 0;
 
+  sizei strides[VERTEX_LAYOUTS_MAX];
+  u32 stream_region = 0;
+
   GfxDrawMode draw_mode;
 };
 /// GfxPipeline
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// GfxQuery
+struct GfxQuery {
+  GfxContext* gfx   = nullptr;
+  GfxQueryType type = GFX_QUERY_TIME_ELAPSED;
+
+  // @NOTE: Every measurement is written into the next slot of the ring. 
+  // A slot is only read back (and reused) once the GPU made its result available.
+
+  u32 start_ids[QUERY_FRAMES_MAX]; 
+  u32 end_ids[QUERY_FRAMES_MAX];   // Timestamps only
+  bool is_pending[QUERY_FRAMES_MAX];
+
+  u32 current_slot = 0;
+  bool is_active   = false;
+
+  f64 elapsed = 0.0;
+};
+/// GfxQuery
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions 
 
@@ -358,6 +448,8 @@ static GLenum get_buffer_usage(const GfxBufferUsage usage) {
       return GL_STATIC_DRAW;
     case GFX_BUFFER_USAGE_STATIC_READ:
       return GL_STATIC_READ;
+    case GFX_BUFFER_USAGE_STREAM: // Stream buffers use immutable storage instead
+      return GL_STREAM_DRAW;
     default:
       return 0;
   }
@@ -780,66 +872,381 @@ static GfxUniformType get_shader_type(const GLenum gl_type) {
   }
 }
 
+static bool should_apply_state(GfxContext* gfx, const bool is_redundant) {
+  if(is_redundant) {
+    gfx->frame_stats.elided_calls++;
+    return false;
+  }
+
+  gfx->frame_stats.state_calls++;
+  return true;
+}
+
+static void reset_cached_ids(u32* ids, const sizei count, const u32 id) {
+  for(sizei i = 0; i < count; i++) {
+    if(ids[i] == id) {
+      ids[i] = 0;
+    }
+  }
+}
+
+static void use_program(GfxContext* gfx, const u32 program) {
+  if(!should_apply_state(gfx, gfx->cache.program == program)) {
+    return;
+  }
+
+  glUseProgram(program);
+  gfx->cache.program = program;
+}
+
+static void bind_vertex_array(GfxContext* gfx, const u32 vertex_array) {
+  if(!should_apply_state(gfx, gfx->cache.vertex_array == vertex_array)) {
+    return;
+  }
+
+  glBindVertexArray(vertex_array);
+  gfx->cache.vertex_array = vertex_array;
+}
+
+static void bind_framebuffer(GfxContext* gfx, const u32 framebuffer) {
+  if(!should_apply_state(gfx, gfx->cache.framebuffer == framebuffer)) {
+    return;
+  }
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  gfx->cache.framebuffer = framebuffer;
+}
+
+static void bind_texture_unit(GfxContext* gfx, const u32 unit, const u32 texture) {
+  if(!should_apply_state(gfx, gfx->cache.texture_units[unit] == texture)) {
+    return;
+  }
+
+  glBindTextureUnit(unit, texture);
+  gfx->cache.texture_units[unit] = texture;
+}
+
+static void bind_buffer(GfxContext* gfx, const GfxBuffer* buffer) {
+  // The index buffer binding is part of the vertex array's state. 
+  // Hence, it cannot be tracked separately.
+
+  if(buffer->desc.type == GFX_BUFFER_INDEX) {
+    gfx->frame_stats.state_calls++;
+    glBindBuffer(buffer->gl_buff_type, buffer->id);
+    
+    return;
+  }
+
+  if(buffer->desc.type == GFX_BUFFER_DRAW_INDIRECT) {
+    gfx->indirect_buffer = (GfxBuffer*)buffer;
+  }
+
+  u32* cached_id = &gfx->cache.buffers[buffer->desc.type];
+  if(!should_apply_state(gfx, *cached_id == buffer->id)) {
+    return;
+  }
+
+  glBindBuffer(buffer->gl_buff_type, buffer->id);
+  *cached_id = buffer->id;
+}
+
+static bool is_stream_buffer(const GfxBuffer* buffer) {
+  return buffer && buffer->mapped_data;
+}
+
+static sizei get_stream_offset(const GfxBuffer* buffer) {
+  if(!is_stream_buffer(buffer)) {
+    return 0;
+  }
+
+  return buffer->gfx->stream_region * buffer->region_size;
+}
+
+static void bind_stream_range(GfxContext* gfx, GfxBuffer* buffer, const u32 bind_point) {
+  // The region changes every frame, so there is nothing to elide here
+
+  gfx->frame_stats.state_calls++;
+  glBindBufferRange(buffer->gl_buff_type, bind_point, buffer->id, get_stream_offset(buffer), buffer->desc.size);
+
+  buffer->bind_point                    = (i32)bind_point;
+  gfx->cache.buffers[buffer->desc.type] = buffer->id;
+
+  if(bind_point < UNIFORM_BUFFERS_MAX) {
+    gfx->cache.buffer_bases[buffer->desc.type][bind_point] = buffer->id;
+  }
+}
+
+static void wait_stream_fence(GfxContext* gfx, const u32 region) {
+  GLsync fence = gfx->stream_fences[region];
+  if(!fence) {
+    return;
+  }
+
+  // Only flush the commands on the first try. Otherwise, just keep waiting.
+
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+  while(true) {
+    GLenum result = glClientWaitSync(fence, flags, 1000000); // 1ms
+
+    if(result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+      break;
+    }
+    else if(result == GL_WAIT_FAILED) {
+      NIKOLA_LOG_ERROR("Failed to wait on the fence of stream region %u", region);
+      break;
+    }
+
+    flags = 0;
+  }
+
+  glDeleteSync(fence);
+  gfx->stream_fences[region] = nullptr;
+}
+
+static void advance_stream_region(GfxContext* gfx) {
+  if(gfx->stream_buffers.empty()) {
+    return;
+  }
+
+  // Fence off the region that was just used...
+  
+  gfx->stream_fences[gfx->stream_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  gfx->stream_region                     = (gfx->stream_region + 1) % STREAM_BUFFER_REGIONS_MAX;
+
+  // ...and make sure the GPU is done with the next one before writing into it
+  wait_stream_fence(gfx, gfx->stream_region);
+
+  // Buffers that were attached to a bind point need to point to the new region
+
+  for(auto& buffer : gfx->stream_buffers) {
+    if(buffer->bind_point != -1) {
+      bind_stream_range(gfx, buffer, (u32)buffer->bind_point);
+    }
+  }
+}
+
+static void update_stream_vertex_buffers(GfxPipeline* pipe) {
+  GfxContext* gfx = pipe->gfx;
+  if(pipe->stream_region == gfx->stream_region) {
+    return;
+  }
+
+  if(is_stream_buffer(pipe->vertex_buffer)) {
+    gfx->frame_stats.state_calls++;
+    glVertexArrayVertexBuffer(pipe->vertex_array, 0, pipe->vertex_buffer->id, get_stream_offset(pipe->vertex_buffer), pipe->strides[0]);
+  }
+  
+  if(is_stream_buffer(pipe->instance_buffer)) {
+    gfx->frame_stats.state_calls++;
+    glVertexArrayVertexBuffer(pipe->vertex_array, 1, pipe->instance_buffer->id, get_stream_offset(pipe->instance_buffer), pipe->strides[1]);
+  }
+
+  pipe->stream_region = gfx->stream_region;
+}
+
+static void bind_buffer_base(GfxContext* gfx, const GfxBuffer* buffer, const u32 bind_point) {
+  // Bind points beyond the cache are always sent to the driver
+
+  if(bind_point >= UNIFORM_BUFFERS_MAX) {
+    gfx->frame_stats.state_calls++;
+    glBindBufferBase(buffer->gl_buff_type, bind_point, buffer->id);
+    
+    gfx->cache.buffers[buffer->desc.type] = buffer->id;
+    return;
+  }
+  
+  u32* cached_id = &gfx->cache.buffer_bases[buffer->desc.type][bind_point];
+  if(!should_apply_state(gfx, *cached_id == buffer->id)) {
+    return;
+  }
+
+  // @NOTE: `glBindBufferBase` also binds the buffer to the generic binding point of the target.
+  
+  glBindBufferBase(buffer->gl_buff_type, bind_point, buffer->id);
+  
+  *cached_id                            = buffer->id;
+  gfx->cache.buffers[buffer->desc.type] = buffer->id;
+}
+
 static void set_state(GfxContext* gfx, const GfxStates state, const bool value) {
+  bool is_enabled = IS_BIT_SET(gfx->cache.enabled_states, state);
+  if(!should_apply_state(gfx, is_enabled == value)) {
+    return;
+  }
+
+  GLenum gl_state = GL_NONE;
   switch(state) {
     case GFX_STATE_DEPTH:
-      SET_GFX_STATE(value, GL_DEPTH_TEST);
+      gl_state = GL_DEPTH_TEST;
       break;
     case GFX_STATE_STENCIL:
-      SET_GFX_STATE(value, GL_STENCIL_TEST);
+      gl_state = GL_STENCIL_TEST;
       break;
     case GFX_STATE_BLEND:
-      SET_GFX_STATE(value, GL_BLEND);
+      gl_state = GL_BLEND;
       break;
     case GFX_STATE_MSAA:
-      SET_GFX_STATE(value, GL_MULTISAMPLE);
+      gl_state = GL_MULTISAMPLE;
       break;
     case GFX_STATE_CULL:
-      SET_GFX_STATE(value, GL_CULL_FACE);
+      gl_state = GL_CULL_FACE;
+      break;
     case GFX_STATE_SCISSOR:
-      SET_GFX_STATE(value, GL_SCISSOR_TEST);
+      gl_state = GL_SCISSOR_TEST;
       break;
+    default:
+      return;
+  }
+
+  if(value) {
+    glEnable(gl_state);
+    SET_BIT(gfx->cache.enabled_states, state);
+  }
+  else {
+    glDisable(gl_state);
+    UNSET_BIT(gfx->cache.enabled_states, state);
   }
 }
 
+static void set_depth_mask(GfxContext* gfx, const bool mask) {
+  if(!should_apply_state(gfx, gfx->cache.depth_mask == mask)) {
+    return;
+  }
+
+  glDepthMask(mask);
+  gfx->cache.depth_mask = mask;
+}
+
+static void set_stencil_mask(GfxContext* gfx, const u32 mask) {
+  bool is_redundant = gfx->cache.is_write_mask_known && (gfx->cache.stencil_write_mask == mask);
+  if(!should_apply_state(gfx, is_redundant)) {
+    return;
+  }
+
+  glStencilMask(mask);
+
+  gfx->cache.stencil_write_mask  = mask;
+  gfx->cache.is_write_mask_known = true;
+}
+
+static void set_blend_color(GfxContext* gfx, const f32* color) {
+  if(!should_apply_state(gfx, memcmp(gfx->cache.blend_color, color, sizeof(f32) * 4) == 0)) {
+    return;
+  }
+
+  glBlendColor(color[0], color[1], color[2], color[3]);
+  memcpy(gfx->cache.blend_color, color, sizeof(f32) * 4);
+}
+
 static void set_depth_state(GfxContext* gfx) {
   GLenum func = get_gl_compare_func(gfx->desc.depth_desc.compare_func);
 
-  glDepthFunc(func);
-  glDepthMask(gfx->desc.depth_desc.depth_write_enabled);
+  if(should_apply_state(gfx, gfx->cache.depth_func == func)) {
+    glDepthFunc(func);
+    gfx->cache.depth_func = func;
+  }
+
+  set_depth_mask(gfx, gfx->desc.depth_desc.depth_write_enabled);
 }
 
 static void set_stencil_state(GfxContext* gfx) {
-  GLenum func  = get_gl_compare_func(gfx->desc.stencil_desc.compare_func);
-  GLenum face  = get_gl_cull_mode(gfx->desc.stencil_desc.polygon_face); 
-  GLenum sfail = get_gl_operation(gfx->desc.stencil_desc.stencil_fail_op); 
-  GLenum dfail = get_gl_operation(gfx->desc.stencil_desc.depth_fail_op); 
-  GLenum dpass = get_gl_operation(gfx->desc.stencil_desc.depth_pass_op); 
+  GfxStencilDesc& desc = gfx->desc.stencil_desc;
+
+  GLenum func  = get_gl_compare_func(desc.compare_func);
+  GLenum face  = get_gl_cull_mode(desc.polygon_face); 
+  GLenum sfail = get_gl_operation(desc.stencil_fail_op); 
+  GLenum dfail = get_gl_operation(desc.depth_fail_op); 
+  GLenum dpass = get_gl_operation(desc.depth_pass_op); 
+
+  GfxStateCache& cache = gfx->cache;
+  bool is_same_face    = (cache.stencil_face == face);
+
+  // Stencil function
+  
+  bool is_redundant = is_same_face                      && 
+                      (cache.stencil_func == func)      && 
+                      (cache.stencil_ref == desc.ref)   && 
+                      (cache.stencil_read_mask == desc.mask);
+  if(should_apply_state(gfx, is_redundant)) {
+    glStencilFuncSeparate(face, func, desc.ref, desc.mask);
+  }
 
-  glStencilFuncSeparate(face, func, gfx->desc.stencil_desc.ref, gfx->desc.stencil_desc.mask);
-  glStencilOpSeparate(face, sfail, dfail, dpass);
-  glStencilMaskSeparate(face, gfx->desc.stencil_desc.mask);
+  // Stencil operations
+  
+  is_redundant = is_same_face                    && 
+                 (cache.stencil_ops[0] == sfail) && 
+                 (cache.stencil_ops[1] == dfail) && 
+                 (cache.stencil_ops[2] == dpass);
+  if(should_apply_state(gfx, is_redundant)) {
+    glStencilOpSeparate(face, sfail, dfail, dpass);
+  }
+
+  // Stencil write mask
+  
+  is_redundant = is_same_face && cache.is_write_mask_known && (cache.stencil_write_mask == desc.mask);
+  if(should_apply_state(gfx, is_redundant)) {
+    glStencilMaskSeparate(face, desc.mask);
+  }
+
+  cache.stencil_face      = face;
+  cache.stencil_func      = func;
+  cache.stencil_ref       = desc.ref;
+  cache.stencil_read_mask = desc.mask;
+  cache.stencil_ops[0]    = sfail;
+  cache.stencil_ops[1]    = dfail;
+  cache.stencil_ops[2]    = dpass;
+
+  // Only one face was affected, so `glStencilMask` cannot be elided later on
+  
+  cache.stencil_write_mask  = desc.mask;
+  cache.is_write_mask_known = (face == GL_FRONT_AND_BACK);
 }
 
 static void set_blend_state(GfxContext* gfx) {
-  GLenum src_color = get_gl_blend_mode(gfx->desc.blend_desc.src_color_blend);
-  GLenum dst_color = get_gl_blend_mode(gfx->desc.blend_desc.dest_color_blend);
+  GLenum funcs[4] = {
+    get_gl_blend_mode(gfx->desc.blend_desc.src_color_blend),
+    get_gl_blend_mode(gfx->desc.blend_desc.dest_color_blend),
+    get_gl_blend_mode(gfx->desc.blend_desc.src_alpha_blend),
+    get_gl_blend_mode(gfx->desc.blend_desc.dest_alpha_blend),
+  };
 
-  GLenum src_alpha = get_gl_blend_mode(gfx->desc.blend_desc.src_alpha_blend);
-  GLenum dst_alpha = get_gl_blend_mode(gfx->desc.blend_desc.dest_alpha_blend);
+  if(should_apply_state(gfx, memcmp(gfx->cache.blend_funcs, funcs, sizeof(funcs)) == 0)) {
+    glBlendFuncSeparate(funcs[0], funcs[1], funcs[2], funcs[3]);
+    memcpy(gfx->cache.blend_funcs, funcs, sizeof(funcs));
+  }
 
-  f32* factor = gfx->desc.blend_desc.blend_factor;
-  
-  glBlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
-  glBlendColor(factor[0], factor[1], factor[2], factor[3]);
+  set_blend_color(gfx, gfx->desc.blend_desc.blend_factor);
 }
 
 static void set_cull_state(GfxContext* gfx) {
   GLenum front_face = get_gl_cull_order(gfx->desc.cull_desc.front_face);
   GLenum face       = get_gl_cull_mode(gfx->desc.cull_desc.cull_mode);
   
-  glCullFace(face);
-  glFrontFace(front_face);
+  if(should_apply_state(gfx, gfx->cache.cull_face == face)) {
+    glCullFace(face);
+    gfx->cache.cull_face = face;
+  }
+
+  if(should_apply_state(gfx, gfx->cache.front_face == front_face)) {
+    glFrontFace(front_face);
+    gfx->cache.front_face = front_face;
+  }
+}
+
+static void set_rect_state(GfxContext* gfx, i32* cached_rect, const i32 x, const i32 y, const i32 width, const i32 height, const bool is_scissor) {
+  i32 rect[4] = {x, y, width, height};
+  if(!should_apply_state(gfx, memcmp(cached_rect, rect, sizeof(rect)) == 0)) {
+    return;
+  }
+
+  if(is_scissor) {
+    glScissor(x, y, width, height);
+  }
+  else {
+    glViewport(x, y, width, height);
+  }
+
+  memcpy(cached_rect, rect, sizeof(rect));
 }
 
 static void set_gfx_states(GfxContext* gfx) {
@@ -1070,6 +1477,55 @@ static void update_gl_texture_storage(GfxTexture* texture, GLenum in_format) {
   }
 }
 
+static void attach_texture_layer(const u32 framebuffer_id, const u32 attachment, const GfxTexture* texture, const u32 layer) {
+  // Only array targets have layers to choose from
+
+  if(texture->desc.type != GFX_TEXTURE_2D_ARRAY) {
+    return;
+  }
+  
+  NIKOLA_ASSERT((layer < texture->desc.depth), "Out of bounds layer given to GfxFramebuffer");
+  glNamedFramebufferTextureLayer(framebuffer_id, attachment, texture->id, 0, layer);
+}
+
+static void resolve_query_slots(GfxQuery* query) {
+  // Go from the oldest slot to the newest one
+ 
+  for(sizei i = 0; i < QUERY_FRAMES_MAX; i++) {
+    u32 slot = (query->current_slot + i) % QUERY_FRAMES_MAX;
+    if(!query->is_pending[slot]) {
+      continue;
+    }
+
+    bool is_timestamp = (query->type == GFX_QUERY_TIMESTAMP);
+    u32 last_id       = is_timestamp ? query->end_ids[slot] : query->start_ids[slot];
+
+    // Queries finish in order. Nothing newer can be available either.
+
+    i32 is_available = GL_FALSE;
+    glGetQueryObjectiv(last_id, GL_QUERY_RESULT_AVAILABLE, &is_available);
+    
+    if(!is_available) {
+      break;
+    }
+
+    // Nanoseconds to milliseconds
+
+    u64 start_time = 0, end_time = 0;
+    glGetQueryObjectui64v(query->start_ids[slot], GL_QUERY_RESULT, &start_time);
+
+    if(is_timestamp) {
+      glGetQueryObjectui64v(query->end_ids[slot], GL_QUERY_RESULT, &end_time);
+      query->elapsed = (f64)(end_time - start_time) / 1000000.0;
+    }
+    else {
+      query->elapsed = (f64)start_time / 1000000.0;
+    }
+
+    query->is_pending[slot] = false;
+  }
+}
+
 /// Private functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -1081,6 +1537,9 @@ GfxContext* gfx_context_init(const GfxContextDesc& desc) {
   memory_zero(gfx, sizeof(GfxContext)); 
   
   gfx->desc                = desc;
+  gfx->cache               = GfxStateCache{};
+  gfx->frame_stats         = GfxContextStats{};
+  gfx->stats               = GfxContextStats{};
   gfx->default_clear_flags = GL_COLOR_BUFFER_BIT;
   gfx->current_clear_flags = gfx->default_clear_flags;
 
@@ -1105,7 +1564,12 @@ GfxContext* gfx_context_init(const GfxContextDesc& desc) {
   
   i32 width, height; 
   window_get_size(desc.window, &width, &height);
-  glViewport(0, 0, width, height);
+
+  // The scissor box starts off as the size of the window as well 
+  
+  gfx->cache.scissor[2] = width;
+  gfx->cache.scissor[3] = height;
+  set_rect_state(gfx, gfx->cache.viewport, 0, 0, width, height, false);
 
   // Setting the flags
   
@@ -1146,6 +1610,18 @@ GfxContext* gfx_context_init(const GfxContextDesc& desc) {
     NIKOLA_LOG_FATAL("Could not find GL_ARB_draw_indirect extension in this driver.");
   }
 
+  // Stream regions are bound with `glBindBufferRange`, which 
+  // requires the offsets to be aligned.
+
+  i32 uniform_alignment = 0, storage_alignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storage_alignment);
+  
+  gfx->stream_alignment = (sizei)((uniform_alignment > storage_alignment) ? uniform_alignment : storage_alignment);
+  if(gfx->stream_alignment < 64) {
+    gfx->stream_alignment = 64;
+  }
+
   if(!gfx_context_has_extension(gfx, "GL_ARB_seamless_cube_map")) {
     NIKOLA_LOG_WARN("Could not find GL_ARB_seamless_cube_map extension in this driver.");
   }
@@ -1171,6 +1647,12 @@ void gfx_context_shutdown(GfxContext* gfx) {
     return;
   }
 
+  for(sizei i = 0; i < STREAM_BUFFER_REGIONS_MAX; i++) {
+    if(gfx->stream_fences[i]) {
+      glDeleteSync(gfx->stream_fences[i]);
+    }
+  }
+
   NIKOLA_LOG_INFO("The graphics context was successfully destroyed");
   memory_free(gfx);
 }
@@ -1193,6 +1675,25 @@ bool gfx_context_has_extension(GfxContext* gfx, const char* ext) {
   return false;
 }
 
+const u32 gfx_context_get_stream_region(GfxContext* gfx) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+
+  return gfx->stream_region;
+}
+
+void gfx_context_wait_idle(GfxContext* gfx) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  
+  gfx->frame_stats.state_calls++;
+  glFinish();
+}
+
+const GfxContextStats& gfx_context_get_stats(GfxContext* gfx) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  
+  return gfx->stats;
+}
+
 void gfx_context_set_state(GfxContext* gfx, const GfxStates state, const bool value) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
   set_state(gfx, state, value);
@@ -1229,13 +1730,13 @@ void gfx_context_set_blend_state(GfxContext* gfx, const GfxBlendDesc& blend_desc
 void gfx_context_set_scissor_rect(GfxContext* gfx, const i32 x, const i32 y, const i32 width, const i32 height) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
   
-  glScissor(x, y, width, height);
+  set_rect_state(gfx, gfx->cache.scissor, x, y, width, height, true);
 }
 
 void gfx_context_set_viewport(GfxContext* gfx, const i32 x, const i32 y, const i32 width, const i32 height) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
  
-  glViewport(x, y, width, height);
+  set_rect_state(gfx, gfx->cache.viewport, x, y, width, height, false);
 }
 
 void gfx_context_set_target(GfxContext* gfx, GfxFramebuffer* framebuffer) {
@@ -1254,7 +1755,7 @@ void gfx_context_set_target(GfxContext* gfx, GfxFramebuffer* framebuffer) {
 void gfx_context_clear(GfxContext* gfx, const f32 r, const f32 g, const f32 b, const f32 a) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
 
-  glBindFramebuffer(GL_FRAMEBUFFER, gfx->current_target);
+  bind_framebuffer(gfx, gfx->current_target);
   glClear(gfx->current_clear_flags);
   glClearColor(r, g, b, a);
 }
@@ -1264,7 +1765,7 @@ void gfx_context_use_bindings(GfxContext* gfx, const GfxBindingDesc& binding_des
   NIKOLA_ASSERT(binding_desc.shader, "Must have a valid GfxShader to bind resources");
 
   // Bind the shader
-  glUseProgram(binding_desc.shader->id);
+  use_program(gfx, binding_desc.shader->id);
 
   // Bind the textures 
 
@@ -1273,7 +1774,7 @@ void gfx_context_use_bindings(GfxContext* gfx, const GfxBindingDesc& binding_des
 
   for(sizei i = 0; i < binding_desc.textures_count; i++) {
     NIKOLA_ASSERT(binding_desc.textures[i], "An invalid texture found in texutres array");
-    glBindTextureUnit(i, binding_desc.textures[i]->id);
+    bind_texture_unit(gfx, i, binding_desc.textures[i]->id);
   }
 
   // Bind the images
@@ -1302,8 +1803,7 @@ void gfx_context_use_bindings(GfxContext* gfx, const GfxBindingDesc& binding_des
   for(sizei i = 0; i < binding_desc.buffers_count; i++) {
     NIKOLA_ASSERT(binding_desc.buffers[i], "An invalid buffer found in buffers array");
 
-    GfxBuffer* buffer = binding_desc.buffers[i];
-    glBindBuffer(buffer->gl_buff_type, buffer->id);
+    bind_buffer(gfx, binding_desc.buffers[i]);
   }
 
   // Bind the cubemaps
@@ -1312,7 +1812,7 @@ void gfx_context_use_bindings(GfxContext* gfx, const GfxBindingDesc& binding_des
                 "Cubemaps count in gfx_context_use_bindings exceeding CUBEMAPS_MAX");
 
   for(sizei i = 0; i < binding_desc.cubemaps_count; i++) {
-    glBindTextureUnit(i, binding_desc.cubemaps[i]->id);
+    bind_texture_unit(gfx, i, binding_desc.cubemaps[i]->id);
   }
 }
 
@@ -1325,14 +1825,14 @@ void gfx_context_use_pipeline(GfxContext* gfx, GfxPipeline* pipeline) {
 
   pipeline->gfx->bound_pipeline = pipeline;
 
-  glDepthMask(pipeline->desc.depth_mask);
-  glStencilMask(pipeline->desc.stencil_ref);
-
-  const f32* blend_color = pipeline->desc.blend_factor;
-  glBlendColor(blend_color[0], blend_color[1], blend_color[2], blend_color[3]);
+  set_depth_mask(gfx, pipeline->desc.depth_mask);
+  set_stencil_mask(gfx, pipeline->desc.stencil_ref);
+  set_blend_color(gfx, pipeline->desc.blend_factor);
 
   // Bind the new bound pipeline
-  glBindVertexArray(pipeline->vertex_array);
+  
+  update_stream_vertex_buffers(pipeline);
+  bind_vertex_array(gfx, pipeline->vertex_array);
 }
 
 void gfx_context_draw(GfxContext* gfx, const u32 start_element) {
@@ -1348,13 +1848,16 @@ void gfx_context_draw(GfxContext* gfx, const u32 start_element) {
   if(pipe->index_buffer) {
     GLenum index_type = get_layout_type(pipe->desc.indices_type);
     glDrawElements(draw_mode, pipe->index_count, index_type, 0);
+    
+    gfx->frame_stats.triangles += pipe->index_count / 3;
   }
   else {
     glDrawArrays(draw_mode, start_element, pipe->vertex_count);
+    
+    gfx->frame_stats.triangles += pipe->vertex_count / 3;
   }
 
-  // Unbind the vertex array for debugging purposes
-  glBindVertexArray(0);
+  gfx->frame_stats.draw_calls++;
 }
 
 void gfx_context_draw_instanced(GfxContext* gfx, const u32 start_element) {
@@ -1371,34 +1874,40 @@ void gfx_context_draw_instanced(GfxContext* gfx, const u32 start_element) {
   if(pipe->index_buffer) {
     GLenum index_type = get_layout_type(pipe->desc.indices_type);
     glDrawElementsInstanced(draw_mode, pipe->index_count, index_type, 0, pipe->instance_count);
+    
+    gfx->frame_stats.triangles += (u64)(pipe->index_count / 3) * pipe->instance_count;
   }
   else {
     glDrawArraysInstanced(draw_mode, start_element, pipe->vertex_count, pipe->instance_count);
+    
+    gfx->frame_stats.triangles += (u64)(pipe->vertex_count / 3) * pipe->instance_count;
   }
   
-  // Unbind the vertex array for debugging purposes
-  glBindVertexArray(0);
+  gfx->frame_stats.draw_calls++;
 }
 
 void gfx_context_draw_multi_indirect(GfxContext* gfx, const u32 offset, const sizei count, const sizei stride) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+  NIKOLA_ASSERT(gfx->bound_pipeline, "Cannot draw using an invalid bound pipeline");
   
   GfxPipeline* pipe = gfx->bound_pipeline;
   GLenum draw_mode  = get_draw_mode(pipe->desc.draw_mode);
   
+  // The commands of stream buffers live in the region of the current frame
+  const void* commands = (const void*)(get_stream_offset(gfx->indirect_buffer) + offset);
+  
   // Draw the index buffer (if it is valid).
   // Otherwise, draw using the vertex buffer.
   
   if(pipe->index_buffer) {
     GLenum index_type = get_layout_type(pipe->desc.indices_type);
-    glMultiDrawElementsIndirect(draw_mode, index_type, nullptr, count, stride);
+    glMultiDrawElementsIndirect(draw_mode, index_type, commands, count, stride);
   }
   else {
-    glMultiDrawArraysIndirect(draw_mode, nullptr, count, stride);
+    glMultiDrawArraysIndirect(draw_mode, commands, count, stride);
   }
   
-  // Unbind the vertex array for debugging purposes
-  glBindVertexArray(0);
+  gfx->frame_stats.draw_calls++;
 }
 
 void gfx_context_dispatch(GfxContext* gfx, const u32 work_group_x, const u32 work_group_y, const u32 work_group_z) {
@@ -1440,6 +1949,12 @@ void gfx_context_memory_barrier(GfxContext* gfx, const i32 barrier_bits) {
 void gfx_context_present(GfxContext* gfx) {
   NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
   window_swap_buffers(gfx->desc.window, gfx->desc.has_vsync);
+  advance_stream_region(gfx);
+
+  // Save the stats of this frame and start anew
+  
+  gfx->stats       = gfx->frame_stats;
+  gfx->frame_stats = GfxContextStats{};
 }
 
 /// Context functions 
@@ -1457,6 +1972,7 @@ GfxFramebuffer* gfx_framebuffer_create(GfxContext* gfx, const GfxFramebufferDesc
   GfxFramebuffer* buff = (GfxFramebuffer*)alloc_fn(sizeof(GfxFramebuffer));
 
   buff->desc        = desc; 
+  buff->gfx         = gfx;
   buff->clear_flags = get_gl_clear_flags(desc.clear_flags);
 
   glCreateFramebuffers(1, &buff->id);
@@ -1519,6 +2035,11 @@ GfxFramebuffer* gfx_framebuffer_create(GfxContext* gfx, const GfxFramebufferDesc
     buff->stencil_texture = GL_STENCIL_ATTACHMENT;
   }
   
+  // Array render targets get attached as layered by default, which 
+  // is not what we want. Only the first layer is attached instead.
+
+  gfx_framebuffer_set_layer(buff, 0);
+
   // Setting the draw and read buffers
 
   glNamedFramebufferDrawBuffers(buff->id,  
@@ -1543,6 +2064,9 @@ void gfx_framebuffer_destroy(GfxFramebuffer* framebuffer, const FreeMemoryFn& fr
     return;
   }
 
+  // OpenGL reuses the names of deleted objects
+  reset_cached_ids(&framebuffer->gfx->cache.framebuffer, 1, framebuffer->id);
+
   glDeleteFramebuffers(1, &framebuffer->id);
   free_fn(framebuffer);
 }
@@ -1642,6 +2166,11 @@ void gfx_framebuffer_update(GfxFramebuffer* framebuffer, const GfxFramebufferDes
     framebuffer->stencil_texture = GL_STENCIL_ATTACHMENT;
   }
 
+  // Array render targets get attached as layered by default, which 
+  // is not what we want. Only the first layer is attached instead.
+
+  gfx_framebuffer_set_layer(framebuffer, 0);
+
   // Setting the draw and read buffers
 
   glNamedFramebufferDrawBuffers(framebuffer->id,  
@@ -1659,6 +2188,24 @@ void gfx_framebuffer_update(GfxFramebuffer* framebuffer, const GfxFramebufferDes
   }
 }
 
+void gfx_framebuffer_set_layer(GfxFramebuffer* framebuffer, const u32 layer) {
+  NIKOLA_ASSERT(framebuffer, "Invalid GfxFramebuffer struct passed");
+
+  GfxFramebufferDesc& desc = framebuffer->desc;
+
+  for(sizei i = 0; i < desc.attachments_count; i++) {
+    attach_texture_layer(framebuffer->id, framebuffer->color_textures[i], desc.color_attachments[i], layer);
+  }
+
+  if(desc.depth_attachment) {
+    attach_texture_layer(framebuffer->id, framebuffer->depth_texture, desc.depth_attachment, layer);
+  }
+  
+  if(desc.stencil_attachment) {
+    attach_texture_layer(framebuffer->id, framebuffer->stencil_texture, desc.stencil_attachment, layer);
+  }
+}
+
 /// Framebuffer functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -1670,8 +2217,11 @@ GfxBuffer* gfx_buffer_create(GfxContext* gfx, const AllocateMemoryFn& alloc_fn)
 
   GfxBuffer* buff = (GfxBuffer*)alloc_fn(sizeof(GfxBuffer));
   
-  buff->desc = {};
-  buff->gfx  = gfx; 
+  buff->desc        = {};
+  buff->gfx         = gfx; 
+  buff->mapped_data = nullptr;
+  buff->region_size = 0;
+  buff->bind_point  = -1;
 
   glCreateBuffers(1, &buff->id);
   return buff;
@@ -1683,8 +2233,49 @@ const bool gfx_buffer_load(GfxBuffer* buffer, const GfxBufferDesc& desc) {
   buffer->desc          = desc;
   buffer->gl_buff_type  = get_buffer_type(desc.type);
   buffer->gl_buff_usage = get_buffer_usage(desc.usage);
+ 
+  if(desc.usage != GFX_BUFFER_USAGE_STREAM) {
+    glNamedBufferData(buffer->id, desc.size, desc.data, buffer->gl_buff_usage);
+    return true;
+  }
+
+  // Stream buffers have immutable storage. They can only be loaded once. 
+  
+  if(buffer->mapped_data) {
+    NIKOLA_LOG_ERROR("Cannot reload the storage of a stream buffer");
+    return false;
+  }
   
-  glNamedBufferData(buffer->id, desc.size, desc.data, buffer->gl_buff_usage);
+  if(desc.type == GFX_BUFFER_INDEX) {
+    NIKOLA_LOG_ERROR("Index buffers cannot use GFX_BUFFER_USAGE_STREAM");
+    return false;
+  }
+
+  // Each region is padded to respect the offset alignment of bind points
+  
+  GfxContext* gfx     = buffer->gfx;
+  buffer->region_size = (desc.size + (gfx->stream_alignment - 1)) & ~(gfx->stream_alignment - 1);
+  
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  sizei total_size = buffer->region_size * STREAM_BUFFER_REGIONS_MAX;
+  
+  glNamedBufferStorage(buffer->id, total_size, nullptr, flags);
+  buffer->mapped_data = (u8*)glMapNamedBufferRange(buffer->id, 0, total_size, flags);
+
+  if(!buffer->mapped_data) {
+    NIKOLA_LOG_ERROR("Failed to map the storage of a stream buffer");
+    return false;
+  }
+
+  // Every region starts off with the same data
+  
+  if(desc.data) {
+    for(sizei i = 0; i < STREAM_BUFFER_REGIONS_MAX; i++) {
+      memory_copy(buffer->mapped_data + (i * buffer->region_size), desc.data, desc.size);
+    }
+  }
+
+  gfx->stream_buffers.push_back(buffer);
   return true;
 }
 
@@ -1693,6 +2284,26 @@ void gfx_buffer_destroy(GfxBuffer* buff, const FreeMemoryFn& free_fn) {
     return;
   }
 
+  // OpenGL reuses the names of deleted objects
+
+  GfxContext* gfx      = buff->gfx;
+  GfxStateCache& cache = gfx->cache;
+  reset_cached_ids(cache.buffers, GFX_BUFFER_TYPES_COUNT, buff->id);
+  reset_cached_ids(&cache.buffer_bases[0][0], GFX_BUFFER_TYPES_COUNT * UNIFORM_BUFFERS_MAX, buff->id);
+
+  if(gfx->indirect_buffer == buff) {
+    gfx->indirect_buffer = nullptr;
+  }
+
+  if(is_stream_buffer(buff)) {
+    glUnmapNamedBuffer(buff->id);
+    
+    auto it = std::find(gfx->stream_buffers.begin(), gfx->stream_buffers.end(), buff);
+    if(it != gfx->stream_buffers.end()) {
+      gfx->stream_buffers.erase(it);
+    }
+  }
+
   glDeleteBuffers(1, &buff->id);
   free_fn(buff);
 }
@@ -1709,7 +2320,12 @@ void gfx_buffer_bind_point(GfxBuffer* buffer, const u32 bind_point) {
   bool is_valid_buffer = (buffer->desc.type == GFX_BUFFER_UNIFORM) || (buffer->desc.type == GFX_BUFFER_SHADER_STORAGE);
   NIKOLA_ASSERT(is_valid_buffer, "Cannot bind a non-uniform or non-shader storage buffer to a bind point");
 
-  glBindBufferBase(get_buffer_type(buffer->desc.type), bind_point, buffer->id);
+  if(is_stream_buffer(buffer)) {
+    bind_stream_range(buffer->gfx, buffer, bind_point);
+    return;
+  }
+
+  bind_buffer_base(buffer->gfx, buffer, bind_point);
 }
 
 void gfx_buffer_update(GfxBuffer* buff, const GfxBufferDesc& desc) {
@@ -1724,6 +2340,35 @@ void gfx_buffer_upload_data(GfxBuffer* buff, const sizei offset, const sizei siz
   NIKOLA_ASSERT(buff->gfx, "Invalid GfxContext struct passed");
   NIKOLA_ASSERT((offset + size) <= buff->desc.size, "The GfxBuffer does not have enough memory to upload this data");
 
+  // Nothing to upload (the data is probably an empty array as well)
+
+  if(size == 0) {
+    return;
+  }
+
+  // Stats
+  
+  GfxContextStats& stats = buff->gfx->frame_stats;
+  stats.uploaded_bytes  += size;
+
+  // The commands are still on the CPU here, which makes it 
+  // much cheaper to count their triangles than at draw time
+
+  if(buff->desc.type == GFX_BUFFER_DRAW_INDIRECT) {
+    const GfxDrawCommandIndirect* commands = (const GfxDrawCommandIndirect*)data;
+
+    for(sizei i = 0; i < (size / sizeof(GfxDrawCommandIndirect)); i++) {
+      stats.triangles += (u64)(commands[i].elements_count / 3) * commands[i].instance_count;
+    }
+  }
+
+  // The storage is coherent, so a plain copy is all that's needed
+  
+  if(is_stream_buffer(buff)) {
+    memory_copy(buff->mapped_data + get_stream_offset(buff) + offset, data, size);
+    return;
+  }
+
   glNamedBufferSubData(buff->id, offset, size, data);
 }
 
@@ -1809,6 +2454,7 @@ void gfx_shader_destroy(GfxShader* shader, const FreeMemoryFn& free_fn) {
     return;
   }
 
+  reset_cached_ids(&shader->gfx->cache.program, 1, shader->id);
   glDeleteProgram(shader->id);
   free_fn(shader);
 }
@@ -1989,7 +2635,7 @@ void gfx_shader_upload_uniform_array(GfxShader* shader, const i32 location, cons
     return;
   }
 
-  glUseProgram(shader->id);
+  use_program(shader->gfx, shader->id);
 
   switch(type) {
     case GFX_LAYOUT_FLOAT1:
@@ -2167,6 +2813,7 @@ void gfx_texture_destroy(GfxTexture* texture, const FreeMemoryFn& free_fn) {
     glMakeTextureHandleNonResidentARB(texture->bindless_id);
   }
   
+  reset_cached_ids(texture->gfx->cache.texture_units, TEXTURES_MAX, texture->id);
   glDeleteTextures(1, &texture->id);
   free_fn(texture);
 }
@@ -2198,6 +2845,9 @@ const bool gfx_texture_reload(GfxTexture* texture, const GfxTextureDesc& desc) {
     glMakeTextureHandleNonResidentARB(texture->bindless_id);
   }
   
+  // OpenGL might hand the old ID to a completely different texture 
+  reset_cached_ids(texture->gfx->cache.texture_units, TEXTURES_MAX, texture->id);
+  
   // Creating the new texutre ID based on its type
   
   switch(desc.type) {
@@ -2335,6 +2985,7 @@ void gfx_cubemap_destroy(GfxCubemap* cubemap, const FreeMemoryFn& free_fn) {
     return;
   }
   
+  reset_cached_ids(cubemap->gfx->cache.texture_units, TEXTURES_MAX, cubemap->id);
   glDeleteTextures(1, &cubemap->id);
   free_fn(cubemap);
 }
@@ -2421,19 +3072,21 @@ GfxPipeline* gfx_pipeline_create(GfxContext* gfx, const GfxPipelineDesc& desc, c
 
   // Pipeline layout init
  
-  sizei strides[VERTEX_LAYOUTS_MAX];
-  init_pipeline_layout(pipe, strides);
+  init_pipeline_layout(pipe, pipe->strides);
+  sizei* strides = pipe->strides;
 
   // Vertex buffer init
   
-  pipe->vertex_buffer = desc.vertex_buffer; 
-  pipe->vertex_count  = desc.vertices_count; 
+  pipe->vertex_buffer   = desc.vertex_buffer; 
+  pipe->vertex_count    = desc.vertices_count; 
+  pipe->instance_buffer = nullptr;
+  pipe->stream_region   = gfx->stream_region;
   
-  glVertexArrayVertexBuffer(pipe->vertex_array,      // VAO
-                            0,                       // Binding index
-                            pipe->vertex_buffer->id, // Buffer ID
-                            0,                       // Starting offset
-                            strides[0]);             // Buffer stride
+  glVertexArrayVertexBuffer(pipe->vertex_array,                     // VAO
+                            0,                                      // Binding index
+                            pipe->vertex_buffer->id,                // Buffer ID
+                            get_stream_offset(pipe->vertex_buffer), // Starting offset
+                            strides[0]);                            // Buffer stride
 
   // Instance buffer init
 
@@ -2441,11 +3094,11 @@ GfxPipeline* gfx_pipeline_create(GfxContext* gfx, const GfxPipelineDesc& desc, c
     pipe->instance_buffer = desc.instance_buffer; 
     pipe->instance_count  = desc.instance_count; 
 
-    glVertexArrayVertexBuffer(pipe->vertex_array,        // VAO
-                              1,                         // Binding index
-                              pipe->instance_buffer->id, // Buffer ID
-                              0,                         // Starting offset
-                              strides[1]);               // Buffer stride
+    glVertexArrayVertexBuffer(pipe->vertex_array,                       // VAO
+                              1,                                        // Binding index
+                              pipe->instance_buffer->id,                // Buffer ID
+                              get_stream_offset(pipe->instance_buffer), // Starting offset
+                              strides[1]);                              // Buffer stride
   }
 
   // Index buffer init
@@ -2466,6 +3119,12 @@ GfxPipeline* gfx_pipeline_create(GfxContext* gfx, const GfxPipelineDesc& desc, c
 void gfx_pipeline_destroy(GfxPipeline* pipeline, const FreeMemoryFn& free_fn) {
   NIKOLA_ASSERT(pipeline, "Attempting to free an invalid GfxPipeline");
 
+  GfxContext* gfx = pipeline->gfx;
+  if(gfx->bound_pipeline == pipeline) {
+    gfx->bound_pipeline = nullptr;
+  }
+  
+  reset_cached_ids(&gfx->cache.vertex_array, 1, pipeline->vertex_array);
   glDeleteVertexArrays(1, &pipeline->vertex_array);
   free_fn(pipeline);
 }
@@ -2496,6 +3155,100 @@ GfxPipelineDesc& gfx_pipeline_get_desc(GfxPipeline* pipeline) {
 /// Pipeline functions 
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Query functions 
+
+GfxQuery* gfx_query_create(GfxContext* gfx, const GfxQueryType type, const AllocateMemoryFn& alloc_fn) {
+  NIKOLA_ASSERT(gfx, "Invalid GfxContext struct passed");
+
+  GfxQuery* query = (GfxQuery*)alloc_fn(sizeof(GfxQuery));
+  *query          = GfxQuery{};
+
+  query->gfx  = gfx;
+  query->type = type;
+
+  if(type == GFX_QUERY_TIMESTAMP) {
+    glCreateQueries(GL_TIMESTAMP, QUERY_FRAMES_MAX, query->start_ids);
+    glCreateQueries(GL_TIMESTAMP, QUERY_FRAMES_MAX, query->end_ids);
+  }
+  else {
+    glCreateQueries(GL_TIME_ELAPSED, QUERY_FRAMES_MAX, query->start_ids);
+  }
+
+  return query;
+}
+
+void gfx_query_destroy(GfxQuery* query, const FreeMemoryFn& free_fn) {
+  if(!query) {
+    return;
+  }
+
+  // @NOTE: Deleting the unused (zero) end queries is silently ignored.
+
+  glDeleteQueries(QUERY_FRAMES_MAX, query->start_ids);
+  glDeleteQueries(QUERY_FRAMES_MAX, query->end_ids);
+
+  free_fn(query);
+}
+
+void gfx_query_begin(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+  NIKOLA_ASSERT(!query->is_active, "Cannot begin a GfxQuery that is already active");
+
+  resolve_query_slots(query);
+  
+  // The GPU is too far behind. Skip this measurement rather than waiting on it.
+  
+  if(query->is_pending[query->current_slot]) {
+    return;
+  }
+
+  if(query->type == GFX_QUERY_TIMESTAMP) {
+    glQueryCounter(query->start_ids[query->current_slot], GL_TIMESTAMP);
+  }
+  else {
+    glBeginQuery(GL_TIME_ELAPSED, query->start_ids[query->current_slot]);
+  }
+
+  query->is_active = true;
+}
+
+void gfx_query_end(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+
+  // Skipped measurement
+  
+  if(!query->is_active) {
+    return;
+  }
+
+  if(query->type == GFX_QUERY_TIMESTAMP) {
+    glQueryCounter(query->end_ids[query->current_slot], GL_TIMESTAMP);
+  }
+  else {
+    glEndQuery(GL_TIME_ELAPSED);
+  }
+
+  query->is_pending[query->current_slot] = true;
+  query->current_slot                    = (query->current_slot + 1) % QUERY_FRAMES_MAX;
+  query->is_active                       = false;
+}
+
+const f64 gfx_query_get_elapsed(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+
+  resolve_query_slots(query);
+  return query->elapsed;
+}
+
+const GfxQueryType gfx_query_get_type(GfxQuery* query) {
+  NIKOLA_ASSERT(query, "Invalid GfxQuery struct passed");
+  return query->type;
+}
+
+/// Query functions 
+///---------------------------------------------------------------------------------------------------------------------
+
 /// *** Graphics ***
 /// ---------------------------------------------------------------------
 
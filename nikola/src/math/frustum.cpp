@@ -0,0 +1,70 @@
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_math.h"
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Math frustum ***
+
+/// ----------------------------------------------------------------------
+/// Frustum functions
+
+const Frustum frustum_create(const Mat4& view_projection) {
+  // Gribb-Hartmann extraction. The matrix is column-major, hence the transpose.
+
+  Mat4 rows = glm::transpose(view_projection);
+  Frustum frustum;
+
+  frustum.planes[0] = rows[3] + rows[0]; // Left
+  frustum.planes[1] = rows[3] - rows[0]; // Right
+  frustum.planes[2] = rows[3] + rows[1]; // Bottom
+  frustum.planes[3] = rows[3] - rows[1]; // Top
+  frustum.planes[4] = rows[3] + rows[2]; // Near
+  frustum.planes[5] = rows[3] - rows[2]; // Far
+
+  for(auto& plane : frustum.planes) {
+    plane /= glm::length(Vec3(plane));
+  }
+
+  return frustum;
+}
+
+const bool frustum_contains_sphere(const Frustum& frustum, const Vec3& center, const f32 radius) {
+  for(auto& plane : frustum.planes) {
+    if((glm::dot(Vec3(plane), center) + plane.w) < -radius) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const bool frustum_contains_aabb(const Frustum& frustum, const AABB& aabb) {
+  Vec3 center  = (aabb.min + aabb.max) * 0.5f;
+  Vec3 extents = (aabb.max - aabb.min) * 0.5f;
+
+  for(auto& plane : frustum.planes) {
+    Vec3 normal = Vec3(plane);
+
+    // The furthest the box reaches along the plane's normal
+    f32 radius = glm::dot(glm::abs(normal), extents);
+
+    if((glm::dot(normal, center) + plane.w) < -radius) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Frustum functions
+/// ----------------------------------------------------------------------
+
+/// *** Math frustum ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,444 @@
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_math.h"
+
+#include <cmath>
+
+// @NOTE: SSE2 is always there on x86-64, while AVX is only there if the compiler
+// was asked for it, which the `NIKOLA_ENABLE_AVX2` CMake option does (`-mavx2` or `/arch:AVX2`).
+// Anything else takes the scalar paths.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #define NIKOLA_SIMD_SSE 1
+  #include <immintrin.h>
+#endif
+
+#if defined(NIKOLA_SIMD_SSE) && defined(__AVX__)
+  #define NIKOLA_SIMD_AVX 1
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+/// ----------------------------------------------------------------------
+/// *** Math batch ***
+
+/// ----------------------------------------------------------------------
+/// Defines
+
+/// Gather the `member` of 4 consecutive elements starting at `arr` into one SSE register.
+#define GATHER4(arr, member) _mm_setr_ps((arr)[0].member, (arr)[1].member, (arr)[2].member, (arr)[3].member)
+
+/// Gather the `member` of 8 consecutive elements starting at `arr` into one AVX register.
+#define GATHER8(arr, member) _mm256_setr_ps((arr)[0].member, (arr)[1].member, (arr)[2].member, (arr)[3].member, \
+                                            (arr)[4].member, (arr)[5].member, (arr)[6].member, (arr)[7].member)
+
+/// Defines
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void aabb_transform(const AABB& box, const Mat4& matrix, AABB& out_box) {
+  Vec3 center  = (box.min + box.max) * 0.5f;
+  Vec3 extents = (box.max - box.min) * 0.5f;
+
+  // Arvo's method: the extents only need the absolute rotation/scale part
+
+  Vec3 new_center  = Vec3(matrix * Vec4(center, 1.0f));
+  Vec3 new_extents = Vec3(glm::abs(matrix[0]) * extents.x +
+                          glm::abs(matrix[1]) * extents.y +
+                          glm::abs(matrix[2]) * extents.z);
+
+  out_box.min = new_center - new_extents;
+  out_box.max = new_center + new_extents;
+}
+
+#if NIKOLA_SIMD_SSE
+
+static inline __m128 simd_abs(const __m128 value) {
+  return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+static inline void store_matrix_column(Transform* transforms, const sizei column, __m128 x, __m128 y, __m128 z, __m128 w) {
+  // Every register holds one component of 4 transforms.
+  // Transposing turns them into the columns of each transform.
+
+  _MM_TRANSPOSE4_PS(x, y, z, w);
+
+  _mm_storeu_ps(glm::value_ptr(transforms[0].transform[column]), x);
+  _mm_storeu_ps(glm::value_ptr(transforms[1].transform[column]), y);
+  _mm_storeu_ps(glm::value_ptr(transforms[2].transform[column]), z);
+  _mm_storeu_ps(glm::value_ptr(transforms[3].transform[column]), w);
+}
+
+#endif
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Batch functions
+
+void transform_apply_batch(Transform* transforms, const sizei count) {
+  sizei i = 0;
+
+#if NIKOLA_SIMD_SSE
+  const __m128 one  = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for(; (i + 4) <= count; i += 4) {
+    Transform* trans = &transforms[i];
+
+    __m128 qx = GATHER4(trans, rotation.x);
+    __m128 qy = GATHER4(trans, rotation.y);
+    __m128 qz = GATHER4(trans, rotation.z);
+    __m128 qw = GATHER4(trans, rotation.w);
+
+    // Rotation matrix terms (the same ones `glm::mat4_cast` uses)
+
+    __m128 x2 = _mm_add_ps(qx, qx);
+    __m128 y2 = _mm_add_ps(qy, qy);
+    __m128 z2 = _mm_add_ps(qz, qz);
+
+    __m128 xx = _mm_mul_ps(qx, x2);
+    __m128 yy = _mm_mul_ps(qy, y2);
+    __m128 zz = _mm_mul_ps(qz, z2);
+    __m128 xy = _mm_mul_ps(qx, y2);
+    __m128 xz = _mm_mul_ps(qx, z2);
+    __m128 yz = _mm_mul_ps(qy, z2);
+    __m128 wx = _mm_mul_ps(qw, x2);
+    __m128 wy = _mm_mul_ps(qw, y2);
+    __m128 wz = _mm_mul_ps(qw, z2);
+
+    // Translation * Rotation * Scale
+
+    __m128 sx = GATHER4(trans, scale.x);
+    __m128 sy = GATHER4(trans, scale.y);
+    __m128 sz = GATHER4(trans, scale.z);
+
+    store_matrix_column(trans, 0,
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), sx),
+                        _mm_mul_ps(_mm_add_ps(xy, wz), sx),
+                        _mm_mul_ps(_mm_sub_ps(xz, wy), sx),
+                        zero);
+
+    store_matrix_column(trans, 1,
+                        _mm_mul_ps(_mm_sub_ps(xy, wz), sy),
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), sy),
+                        _mm_mul_ps(_mm_add_ps(yz, wx), sy),
+                        zero);
+
+    store_matrix_column(trans, 2,
+                        _mm_mul_ps(_mm_add_ps(xz, wy), sz),
+                        _mm_mul_ps(_mm_sub_ps(yz, wx), sz),
+                        _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), sz),
+                        zero);
+
+    store_matrix_column(trans, 3,
+                        GATHER4(trans, position.x),
+                        GATHER4(trans, position.y),
+                        GATHER4(trans, position.z),
+                        one);
+  }
+#endif
+
+  for(; i < count; i++) {
+    transform_apply(transforms[i]);
+  }
+}
+
+void aabb_transform_batch(const AABB* boxes, const Mat4* matrices, AABB* out_boxes, const sizei count) {
+  sizei i = 0;
+
+#if NIKOLA_SIMD_SSE
+  const __m128 half = _mm_set1_ps(0.5f);
+
+  for(; i < count; i++) {
+    const AABB& box    = boxes[i];
+    const Mat4& matrix = matrices[i];
+
+    __m128 col0 = _mm_loadu_ps(glm::value_ptr(matrix[0]));
+    __m128 col1 = _mm_loadu_ps(glm::value_ptr(matrix[1]));
+    __m128 col2 = _mm_loadu_ps(glm::value_ptr(matrix[2]));
+    __m128 col3 = _mm_loadu_ps(glm::value_ptr(matrix[3]));
+
+    __m128 box_min = _mm_setr_ps(box.min.x, box.min.y, box.min.z, 0.0f);
+    __m128 box_max = _mm_setr_ps(box.max.x, box.max.y, box.max.z, 0.0f);
+
+    __m128 center  = _mm_mul_ps(_mm_add_ps(box_min, box_max), half);
+    __m128 extents = _mm_mul_ps(_mm_sub_ps(box_max, box_min), half);
+
+    // Arvo's method: the extents only need the absolute rotation/scale part
+
+    __m128 new_center = col3;
+    new_center = _mm_add_ps(new_center, _mm_mul_ps(col0, _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0))));
+    new_center = _mm_add_ps(new_center, _mm_mul_ps(col1, _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1))));
+    new_center = _mm_add_ps(new_center, _mm_mul_ps(col2, _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2))));
+
+    __m128 new_extents = _mm_mul_ps(simd_abs(col0), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(0, 0, 0, 0)));
+    new_extents = _mm_add_ps(new_extents, _mm_mul_ps(simd_abs(col1), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(1, 1, 1, 1))));
+    new_extents = _mm_add_ps(new_extents, _mm_mul_ps(simd_abs(col2), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(2, 2, 2, 2))));
+
+    f32 out_min[4], out_max[4];
+    _mm_storeu_ps(out_min, _mm_sub_ps(new_center, new_extents));
+    _mm_storeu_ps(out_max, _mm_add_ps(new_center, new_extents));
+
+    out_boxes[i].min = Vec3(out_min[0], out_min[1], out_min[2]);
+    out_boxes[i].max = Vec3(out_max[0], out_max[1], out_max[2]);
+  }
+#endif
+
+  for(; i < count; i++) {
+    aabb_transform(boxes[i], matrices[i], out_boxes[i]);
+  }
+}
+
+void frustum_test_spheres(const Frustum& frustum, const Vec4* spheres, const sizei count, bool* out_results) {
+  sizei i = 0;
+
+#if NIKOLA_SIMD_AVX
+  for(; (i + 8) <= count; i += 8) {
+    const Vec4* group = &spheres[i];
+
+    __m256 cx         = GATHER8(group, x);
+    __m256 cy         = GATHER8(group, y);
+    __m256 cz         = GATHER8(group, z);
+    __m256 neg_radius = _mm256_sub_ps(_mm256_setzero_ps(), GATHER8(group, w));
+
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for(auto& plane : frustum.planes) {
+      __m256 dist = _mm256_set1_ps(plane.w);
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.x), cx));
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.y), cy));
+      dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(plane.z), cz));
+
+      inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, neg_radius, _CMP_GE_OQ));
+    }
+
+    i32 mask = _mm256_movemask_ps(inside);
+    for(sizei j = 0; j < 8; j++) {
+      out_results[i + j] = (mask >> j) & 1;
+    }
+  }
+#endif
+
+#if NIKOLA_SIMD_SSE
+  for(; (i + 4) <= count; i += 4) {
+    __m128 cx = _mm_loadu_ps(glm::value_ptr(spheres[i + 0]));
+    __m128 cy = _mm_loadu_ps(glm::value_ptr(spheres[i + 1]));
+    __m128 cz = _mm_loadu_ps(glm::value_ptr(spheres[i + 2]));
+    __m128 cw = _mm_loadu_ps(glm::value_ptr(spheres[i + 3]));
+    _MM_TRANSPOSE4_PS(cx, cy, cz, cw);
+
+    __m128 neg_radius = _mm_sub_ps(_mm_setzero_ps(), cw);
+
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for(auto& plane : frustum.planes) {
+      __m128 dist = _mm_set1_ps(plane.w);
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.x), cx));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.z), cz));
+
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, neg_radius));
+    }
+
+    i32 mask = _mm_movemask_ps(inside);
+    for(sizei j = 0; j < 4; j++) {
+      out_results[i + j] = (mask >> j) & 1;
+    }
+  }
+#endif
+
+  for(; i < count; i++) {
+    out_results[i] = frustum_contains_sphere(frustum, Vec3(spheres[i]), spheres[i].w);
+  }
+}
+
+void frustum_test_aabbs(const Frustum& frustum, const AABB* boxes, const sizei count, bool* out_results) {
+  sizei i = 0;
+
+#if NIKOLA_SIMD_SSE
+  const __m128 half = _mm_set1_ps(0.5f);
+
+  for(; (i + 4) <= count; i += 4) {
+    const AABB* group = &boxes[i];
+
+    __m128 min_x = GATHER4(group, min.x);
+    __m128 min_y = GATHER4(group, min.y);
+    __m128 min_z = GATHER4(group, min.z);
+    __m128 max_x = GATHER4(group, max.x);
+    __m128 max_y = GATHER4(group, max.y);
+    __m128 max_z = GATHER4(group, max.z);
+
+    __m128 cx = _mm_mul_ps(_mm_add_ps(min_x, max_x), half);
+    __m128 cy = _mm_mul_ps(_mm_add_ps(min_y, max_y), half);
+    __m128 cz = _mm_mul_ps(_mm_add_ps(min_z, max_z), half);
+    __m128 ex = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+    __m128 ey = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+    __m128 ez = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for(auto& plane : frustum.planes) {
+      __m128 dist = _mm_set1_ps(plane.w);
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.x), cx));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+      dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.z), cz));
+
+      // The furthest each box reaches along the plane's normal
+
+      __m128 radius = _mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), ex);
+      radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), ey));
+      radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), ez));
+
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+    }
+
+    i32 mask = _mm_movemask_ps(inside);
+    for(sizei j = 0; j < 4; j++) {
+      out_results[i + j] = (mask >> j) & 1;
+    }
+  }
+#endif
+
+  for(; i < count; i++) {
+    out_results[i] = frustum_contains_aabb(frustum, boxes[i]);
+  }
+}
+
+void quat_normalize_batch(Quat* quats, const sizei count) {
+  sizei i = 0;
+
+  // @NOTE: The kernels below do not care about the order the components are stored
+  // in, since every component of a quaternion goes through the same operations.
+
+#if NIKOLA_SIMD_SSE
+  const __m128 one  = _mm_set1_ps(1.0f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for(; (i + 4) <= count; i += 4) {
+    __m128 c0 = _mm_loadu_ps(glm::value_ptr(quats[i + 0]));
+    __m128 c1 = _mm_loadu_ps(glm::value_ptr(quats[i + 1]));
+    __m128 c2 = _mm_loadu_ps(glm::value_ptr(quats[i + 2]));
+    __m128 c3 = _mm_loadu_ps(glm::value_ptr(quats[i + 3]));
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 length_sq = _mm_mul_ps(c0, c0);
+    length_sq = _mm_add_ps(length_sq, _mm_mul_ps(c1, c1));
+    length_sq = _mm_add_ps(length_sq, _mm_mul_ps(c2, c2));
+    length_sq = _mm_add_ps(length_sq, _mm_mul_ps(c3, c3));
+
+    __m128 inv_length = _mm_div_ps(one, _mm_sqrt_ps(length_sq));
+
+    c0 = _mm_mul_ps(c0, inv_length);
+    c1 = _mm_mul_ps(c1, inv_length);
+    c2 = _mm_mul_ps(c2, inv_length);
+    c3 = _mm_mul_ps(c3, inv_length);
+
+    // Zero-length quaternions are left for `quat_normalize` to turn into the identity
+    i32 degenerate_mask = _mm_movemask_ps(_mm_cmple_ps(length_sq, zero));
+
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps(glm::value_ptr(quats[i + 0]), c0);
+    _mm_storeu_ps(glm::value_ptr(quats[i + 1]), c1);
+    _mm_storeu_ps(glm::value_ptr(quats[i + 2]), c2);
+    _mm_storeu_ps(glm::value_ptr(quats[i + 3]), c3);
+
+    for(sizei j = 0; degenerate_mask && j < 4; j++) {
+      if((degenerate_mask >> j) & 1) {
+        quats[i + j] = quat_normalize(Quat(0.0f, 0.0f, 0.0f, 0.0f));
+      }
+    }
+  }
+#endif
+
+  for(; i < count; i++) {
+    quats[i] = quat_normalize(quats[i]);
+  }
+}
+
+void quat_slerp_batch(const Quat* starts, const Quat* ends, const f32 amount, Quat* out_quats, const sizei count) {
+  sizei i = 0;
+
+#if NIKOLA_SIMD_SSE
+  const __m128 zero      = _mm_setzero_ps();
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+
+  for(; (i + 4) <= count; i += 4) {
+    __m128 a0 = _mm_loadu_ps(glm::value_ptr(starts[i + 0]));
+    __m128 a1 = _mm_loadu_ps(glm::value_ptr(starts[i + 1]));
+    __m128 a2 = _mm_loadu_ps(glm::value_ptr(starts[i + 2]));
+    __m128 a3 = _mm_loadu_ps(glm::value_ptr(starts[i + 3]));
+    _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+
+    __m128 b0 = _mm_loadu_ps(glm::value_ptr(ends[i + 0]));
+    __m128 b1 = _mm_loadu_ps(glm::value_ptr(ends[i + 1]));
+    __m128 b2 = _mm_loadu_ps(glm::value_ptr(ends[i + 2]));
+    __m128 b3 = _mm_loadu_ps(glm::value_ptr(ends[i + 3]));
+    _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+    __m128 cos_theta = _mm_mul_ps(a0, b0);
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(a1, b1));
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(a2, b2));
+    cos_theta = _mm_add_ps(cos_theta, _mm_mul_ps(a3, b3));
+
+    // Take the shortest path by flipping the ends that are more than 90 degrees away
+
+    __m128 flip = _mm_and_ps(_mm_cmplt_ps(cos_theta, zero), sign_mask);
+    cos_theta   = _mm_xor_ps(cos_theta, flip);
+
+    b0 = _mm_xor_ps(b0, flip);
+    b1 = _mm_xor_ps(b1, flip);
+    b2 = _mm_xor_ps(b2, flip);
+    b3 = _mm_xor_ps(b3, flip);
+
+    // There are no SIMD trigonometric functions, so the weights are computed per lane
+
+    f32 cosines[4], start_weights[4], end_weights[4];
+    _mm_storeu_ps(cosines, cos_theta);
+
+    for(sizei j = 0; j < 4; j++) {
+      // Too close to each other. Fallback to a linear interpolation.
+      if(cosines[j] > (1.0f - (f32)EPSILON)) {
+        start_weights[j] = 1.0f - amount;
+        end_weights[j]   = amount;
+        continue;
+      }
+
+      f32 angle     = std::acos(cosines[j]);
+      f32 inv_sin   = 1.0f / std::sin(angle);
+
+      start_weights[j] = std::sin((1.0f - amount) * angle) * inv_sin;
+      end_weights[j]   = std::sin(amount * angle) * inv_sin;
+    }
+
+    __m128 start_weight = _mm_loadu_ps(start_weights);
+    __m128 end_weight   = _mm_loadu_ps(end_weights);
+
+    __m128 r0 = _mm_add_ps(_mm_mul_ps(a0, start_weight), _mm_mul_ps(b0, end_weight));
+    __m128 r1 = _mm_add_ps(_mm_mul_ps(a1, start_weight), _mm_mul_ps(b1, end_weight));
+    __m128 r2 = _mm_add_ps(_mm_mul_ps(a2, start_weight), _mm_mul_ps(b2, end_weight));
+    __m128 r3 = _mm_add_ps(_mm_mul_ps(a3, start_weight), _mm_mul_ps(b3, end_weight));
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(glm::value_ptr(out_quats[i + 0]), r0);
+    _mm_storeu_ps(glm::value_ptr(out_quats[i + 1]), r1);
+    _mm_storeu_ps(glm::value_ptr(out_quats[i + 2]), r2);
+    _mm_storeu_ps(glm::value_ptr(out_quats[i + 3]), r3);
+  }
+#endif
+
+  for(; i < count; i++) {
+    out_quats[i] = quat_slerp(starts[i], ends[i], amount);
+  }
+}
+
+/// Batch functions
+/// ----------------------------------------------------------------------
+
+/// *** Math batch ***
+/// ----------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -51,7 +51,6 @@ namespace nikola { // Start of nikola
 ///---------------------------------------------------------------------------------------------------------------------
 /// Defines
 
-#define BODY_CHECK(body)     NIKOLA_ASSERT((body && body->handle), "Trying to access a physics body with an invalid ID")
 #define COLLIDER_CHECK(coll) NIKOLA_ASSERT((coll && coll->handle), "Trying to access a collider with an invalid ID")
 #define CHARACTER_CHECK(ch)  NIKOLA_ASSERT((ch && ch->handle), "Trying to access a character with an invalid ID")
 
@@ -70,7 +69,13 @@ static inline JPH::Vec3 vec3_to_jph_vec3(const Vec3& vec);
 static inline JPH::Vec4 vec4_to_jph_vec4(const Vec4& vec);
 static inline JPH::Quat quat_to_jph_quat(const Quat& quat);
 static inline JPH::EMotionType body_type_to_jph_body_type(const PhysicsBodyType type);
+static inline PhysicsBodyID jph_body_id_to_body_id(const JPH::BodyID& id);
+static inline JPH::BodyID body_id_to_jph_body_id(const PhysicsBodyID& id);
 static bool assert_impl(const char* expr, const char* msg, const char* file, JPH::uint line);
+static PhysicsBody* find_pooled_body(const JPH::BodyID& id);
+static PhysicsBody* get_body(const PhysicsBodyID& id);
+static void push_contact(const EventType type, const JPH::BodyID& id1, const JPH::BodyID& id2, const JPH::ContactManifold* manifold);
+static void flush_contacts();
 
 /// Private functions declarations
 ///---------------------------------------------------------------------------------------------------------------------
@@ -81,6 +86,8 @@ struct PhysicsBody {
   JPH::Body* handle  = nullptr;
   u64 user_data      = 0;
   Collider* collider = nullptr;
+
+  bool has_contact_events = false;
 };
 /// PhysicsBody
 ///---------------------------------------------------------------------------------------------------------------------
@@ -114,7 +121,7 @@ public:
 	void OnBodyActivated(const JPH::BodyID &inBodyID, JPH::uint64 inBodyUserData) override {
     Event event = {
       .type = EVENT_PHYSICS_BODY_ACTIVATED,
-      .body = reinterpret_cast<PhysicsBody*>(inBodyUserData), 
+      .body = jph_body_id_to_body_id(inBodyID), 
     };
     event_dispatch(event);
 	}
@@ -122,7 +129,7 @@ public:
 	void OnBodyDeactivated(const JPH::BodyID &inBodyID, JPH::uint64 inBodyUserData) override {
     Event event = {
       .type = EVENT_PHYSICS_BODY_DEACTIVATED,
-      .body = reinterpret_cast<PhysicsBody*>(inBodyUserData), 
+      .body = jph_body_id_to_body_id(inBodyID), 
     };
     event_dispatch(event);
 	}
@@ -146,57 +153,38 @@ public:
                       const JPH::Body& inBody2, 
                       const JPH::ContactManifold& inManifold, 
                       JPH::ContactSettings& ioSettings) override {
-    CollisionData data = {
-      .body1 = reinterpret_cast<PhysicsBody*>(inBody1.GetUserData()), 
-      .body2 = reinterpret_cast<PhysicsBody*>(inBody2.GetUserData()), 
-
-      .base_offset       = jph_vec3_to_vec3(inManifold.mBaseOffset), 
-      .normal            = jph_vec3_to_vec3(inManifold.mWorldSpaceNormal),
-      .penetration_depth = inManifold.mPenetrationDepth,
-    };
-
-    Event event = {
-      .type           = EVENT_PHYSICS_CONTACT_ADDED,
-      .collision_data = data,
-    };
-    event_dispatch(event);
+    push_contact(EVENT_PHYSICS_CONTACT_ADDED, inBody1.GetID(), inBody2.GetID(), &inManifold);
 	}
 
 	void OnContactPersisted(const JPH::Body& inBody1, 
                           const JPH::Body& inBody2, 
                           const JPH::ContactManifold& inManifold, 
                           JPH::ContactSettings& ioSettings) override {
-    CollisionData data = {
-      .body1 = reinterpret_cast<PhysicsBody*>(inBody1.GetUserData()), 
-      .body2 = reinterpret_cast<PhysicsBody*>(inBody2.GetUserData()), 
-
-      .base_offset       = jph_vec3_to_vec3(inManifold.mBaseOffset), 
-      .normal            = jph_vec3_to_vec3(inManifold.mWorldSpaceNormal),
-      .penetration_depth = inManifold.mPenetrationDepth,
-    };
-
-    Event event = {
-      .type           = EVENT_PHYSICS_CONTACT_PERSISTED,
-      .collision_data = data,
-    };
-    event_dispatch(event);
+    push_contact(EVENT_PHYSICS_CONTACT_PERSISTED, inBody1.GetID(), inBody2.GetID(), &inManifold);
 	}
 
 	void OnContactRemoved(const JPH::SubShapeIDPair& inSubShapePair) override {
-    // @TODO (Physics)
-    // CollisionData data = {
-    // };
-    //
-    // Event event = {
-    //   .type           = EVENT_PHYSICS_CONTACT_REMOVED,
-    //   .collision_data = data,
-    // };
-    // event_dispatch(event);
+    // @NOTE: The bodies cannot be accessed here, since they might have been removed 
+    // already. Only their IDs are given, which is enough to find them in the pool.
+
+    push_contact(EVENT_PHYSICS_CONTACT_REMOVED, inSubShapePair.GetBody1ID(), inSubShapePair.GetBody2ID(), nullptr);
 	}
 };
 /// NKContactListener  
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// ContactBuffer
+struct ContactBuffer {
+  std::mutex mutex;
+
+  // The contact events of the current step, one per body pair and event type
+  DynamicArray<Event> events;
+  HashMap<u64, sizei> lookup;
+};
+/// ContactBuffer
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// PhysicsWorld
 struct PhysicsWorld {
@@ -213,6 +201,16 @@ struct PhysicsWorld {
 
   JPH::BodyInterface* body_interface;
 
+  // @NOTE: The bodies live in one contiguous pool, indexed by the index of their Jolt `BodyID`. 
+  // The pool is sized to `max_bodies` on init and never grows. The `PhysicsBodyID`s handed 
+  // out also carry the slot's sequence number, so a slot taken over by another body 
+  // never answers to the IDs of the bodies it held before.
+  DynamicArray<PhysicsBody> bodies;
+
+  // @NOTE: The contact listener gets called from the worker threads during the step. 
+  // The contacts are gathered here instead, and only dispatched once the step is done.
+  ContactBuffer contacts;
+
   f32 collision_tolerance = 0.05f;
   bool is_paused          = false;
 };
@@ -283,11 +281,109 @@ static inline JPH::EMotionType body_type_to_jph_body_type(const PhysicsBodyType
   }
 }
 
+static inline PhysicsBodyID jph_body_id_to_body_id(const JPH::BodyID& id) {
+  return PhysicsBodyID {
+    ._id         = id.GetIndex(), 
+    ._generation = id.GetSequenceNumber(),
+  };
+}
+
+static inline JPH::BodyID body_id_to_jph_body_id(const PhysicsBodyID& id) {
+  return JPH::BodyID(id._id, (JPH::uint8)id._generation);
+}
+
 static bool assert_impl(const char* expr, const char* msg, const char* file, JPH::uint line) {
   logger_log_assert(expr, msg, file, line);
   return true;
 };
 
+static PhysicsBody* find_pooled_body(const JPH::BodyID& id) {
+  PhysicsBody* body = &s_world->bodies[id.GetIndex()];
+
+  // Characters (and bodies that were destroyed or replaced since) do not own this slot
+
+  if(!body->handle || body->handle->GetID() != id) {
+    return nullptr;
+  }
+
+  return body;
+}
+
+static PhysicsBody* get_body(const PhysicsBodyID& id) {
+  NIKOLA_ASSERT(physics_body_is_valid(id), "Trying to access a physics body with an invalid ID");
+  return &s_world->bodies[id._id];
+}
+
+static void push_contact(const EventType type, const JPH::BodyID& id1, const JPH::BodyID& id2, const JPH::ContactManifold* manifold) {
+  // Only the bodies that asked for contact events get any
+
+  PhysicsBody* body1 = find_pooled_body(id1);
+  PhysicsBody* body2 = find_pooled_body(id2);
+
+  bool is_wanted = (body1 && body1->has_contact_events) || (body2 && body2->has_contact_events);
+  if(!is_wanted) {
+    return;
+  }
+
+  // @NOTE: The IDs are given out even if the bodies are not pooled (characters) 
+  // or already destroyed. Neither of these would pass `physics_body_is_valid`.
+
+  CollisionData data = {
+    .body1 = jph_body_id_to_body_id(id1), 
+    .body2 = jph_body_id_to_body_id(id2),
+  };
+
+  if(manifold) {
+    data.base_offset       = jph_vec3_to_vec3(manifold->mBaseOffset);
+    data.normal            = jph_vec3_to_vec3(manifold->mWorldSpaceNormal);
+    data.penetration_depth = manifold->mPenetrationDepth;
+  }
+
+  // @NOTE: The indices of Jolt's bodies never exceed 23 bits, which leaves 
+  // enough room to pack the body pair and the event type into one key.
+
+  u64 index1 = (u64)id1.GetIndex();
+  u64 index2 = (u64)id2.GetIndex();
+  if(index1 > index2) {
+    std::swap(index1, index2);
+  }
+
+  u64 key = ((u64)type << 48) | (index1 << 24) | index2;
+
+  // Aggregate every sub-shape contact of the same pair into one event, 
+  // keeping the deepest one
+
+  std::lock_guard<std::mutex> lock(s_world->contacts.mutex);
+
+  auto it = s_world->contacts.lookup.find(key);
+  if(it != s_world->contacts.lookup.end()) {
+    Event& event = s_world->contacts.events[it->second];
+    
+    if(data.penetration_depth > event.collision_data.penetration_depth) {
+      event.collision_data = data;
+    }
+
+    return;
+  }
+
+  s_world->contacts.lookup[key] = s_world->contacts.events.size();
+  s_world->contacts.events.push_back(Event {
+    .type           = type, 
+    .collision_data = data,
+  });
+}
+
+static void flush_contacts() {
+  // @NOTE: No need to lock here, since the step is done and no worker thread is touching the buffer.
+
+  for(auto& event : s_world->contacts.events) {
+    event_dispatch(event);
+  }
+
+  s_world->contacts.events.clear();
+  s_world->contacts.lookup.clear();
+}
+
 /// Private functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -376,6 +472,9 @@ void physics_world_init(const PhysicsWorldDesc& desc) {
   // Body interface init
   s_world->body_interface = &s_world->physics_system.GetBodyInterface();
 
+  // Bodies pool init
+  s_world->bodies.resize(desc.max_bodies);
+
   // Listeners init
 
   s_world->physics_system.SetBodyActivationListener(&s_world->activation_listener);
@@ -406,16 +505,17 @@ void physics_world_step(const f32 delta_time, const i32 collision_steps) {
 
   // Update the world
   s_world->physics_system.Update(delta_time, collision_steps, s_world->temp_allocater, s_world->job_system);
+
+  // Deliver the contacts of this step
+  flush_contacts();
 }
 
 void physics_world_optimize_broadphase() {
   s_world->physics_system.OptimizeBroadPhase();
 }
 
-PhysicsBody* physics_world_create_body(const PhysicsBodyDesc& desc) {
+PhysicsBodyID physics_world_create_body(const PhysicsBodyDesc& desc) {
   COLLIDER_CHECK(desc.collider);
-  
-  PhysicsBody* nk_body = new PhysicsBody{};
 
   // Create the Jolt body
 
@@ -429,22 +529,29 @@ PhysicsBody* physics_world_create_body(const PhysicsBodyDesc& desc) {
   body_settings.mFriction      = desc.friction;
   body_settings.mGravityFactor = desc.gravity_factor;
   body_settings.mIsSensor      = desc.is_sensor;  
-  body_settings.mUserData      = (JPH::uint64)nk_body;
 
-  // Create our body
+  JPH::Body* handle = s_world->body_interface->CreateBody(body_settings); 
+  NIKOLA_ASSERT(handle, "Cannot create any more physics bodies. Consider increasing `max_bodies`");
+
+  // Take the body's slot in the pool. 
+  // Jolt never hands out an index beyond `max_bodies`.
+
+  PhysicsBody* nk_body = &s_world->bodies[handle->GetID().GetIndex()];
  
-  nk_body->handle      = s_world->body_interface->CreateBody(body_settings); 
+  nk_body->handle      = handle;
   nk_body->collider    = (Collider*)desc.collider; 
   nk_body->user_data   = desc.user_data;
 
-  return nk_body;
+  nk_body->has_contact_events = desc.has_contact_events;
+
+  return jph_body_id_to_body_id(handle->GetID());
 }
 
-void physics_world_add_body(const PhysicsBody* body, const bool is_active) {
-  BODY_CHECK(body);
+void physics_world_add_body(const PhysicsBodyID& body, const bool is_active) {
+  PhysicsBody* nk_body = get_body(body);
 
   JPH::EActivation active = is_active ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-  s_world->body_interface->AddBody(body->handle->GetID(), active);
+  s_world->body_interface->AddBody(nk_body->handle->GetID(), active);
 }
 
 void physics_world_add_character(const Character* character, const bool is_active) {
@@ -454,83 +561,107 @@ void physics_world_add_character(const Character* character, const bool is_activ
   character->handle->AddToPhysicsSystem(activate);
 }
 
-PhysicsBody* physics_world_create_and_add_body(const PhysicsBodyDesc& desc, const bool is_active) {
-  PhysicsBody* body = physics_world_create_body(desc);
+PhysicsBodyID physics_world_create_and_add_body(const PhysicsBodyDesc& desc, const bool is_active) {
+  PhysicsBodyID body = physics_world_create_body(desc);
   physics_world_add_body(body, is_active);
 
   return body;
 }
 
-PhysicsBatchHandle physics_world_prepare_bodies(PhysicsBody** bodies, const sizei count) {
-  // @TEMP (Physics): This works for now, but it's not the pretiest thing ever 
-  // Convert our physics body struct into BodyIDs. 
+PhysicsBatchHandle physics_world_prepare_bodies(PhysicsBodyID* bodies, const sizei count) {
+  // Convert our IDs into Jolt's, making sure none of them went stale along the way
 
   DynamicArray<JPH::BodyID> body_ids;
   body_ids.reserve(count);
 
   for(sizei i = 0; i < count; i++) {
-    body_ids.emplace_back(bodies[i]->handle->GetID());
+    NIKOLA_ASSERT(physics_body_is_valid(bodies[i]), "Trying to access a physics body with an invalid ID");
+    body_ids.emplace_back(body_id_to_jph_body_id(bodies[i]));
   }
 
   // Initiate the prepare process
   return (PhysicsBatchHandle)s_world->body_interface->AddBodiesPrepare(body_ids.data(), (i32)body_ids.size());
 }
 
-void physics_world_finalize_bodies(PhysicsBody** bodies, const sizei count, PhysicsBatchHandle batch_handle, const bool is_active) {
+void physics_world_finalize_bodies(PhysicsBodyID* bodies, const sizei count, PhysicsBatchHandle batch_handle, const bool is_active) {
   JPH::EActivation active = is_active ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
   
-  // @TEMP (Physics): This works for now, but it's not the pretiest thing ever 
-  // Convert our physics body struct into BodyIDs. 
+  // Convert our IDs into Jolt's, making sure none of them went stale along the way
 
   DynamicArray<JPH::BodyID> body_ids;
   body_ids.reserve(count);
 
   for(sizei i = 0; i < count; i++) {
-    body_ids.emplace_back(bodies[i]->handle->GetID());
+    NIKOLA_ASSERT(physics_body_is_valid(bodies[i]), "Trying to access a physics body with an invalid ID");
+    body_ids.emplace_back(body_id_to_jph_body_id(bodies[i]));
   }
 
   // Initiate the prepare process
   return s_world->body_interface->AddBodiesFinalize(body_ids.data(), (i32)body_ids.size(), (JPH::BodyInterface::AddState)batch_handle, active);
 }
 
-void physics_world_abort_bodies(PhysicsBody** bodies, const sizei count, PhysicsBatchHandle batch_handle) {
-  // @TEMP (Physics): This works for now, but it's not the pretiest thing ever 
-  // Convert our physics body struct into BodyIDs. 
+void physics_world_abort_bodies(PhysicsBodyID* bodies, const sizei count, PhysicsBatchHandle batch_handle) {
+  // Convert our IDs into Jolt's, making sure none of them went stale along the way
 
   DynamicArray<JPH::BodyID> body_ids;
   body_ids.reserve(count);
 
   for(sizei i = 0; i < count; i++) {
-    body_ids.emplace_back(bodies[i]->handle->GetID());
+    NIKOLA_ASSERT(physics_body_is_valid(bodies[i]), "Trying to access a physics body with an invalid ID");
+    body_ids.emplace_back(body_id_to_jph_body_id(bodies[i]));
   }
 
   // Initiate the prepare process
   return s_world->body_interface->AddBodiesAbort(body_ids.data(), (i32)body_ids.size(), (JPH::BodyInterface::AddState)batch_handle);
 }
 
-void physics_world_remove_body(PhysicsBody* body) {
-  BODY_CHECK(body);
+void physics_world_remove_body(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
   
-  s_world->body_interface->RemoveBody(body->handle->GetID());
+  s_world->body_interface->RemoveBody(nk_body->handle->GetID());
 }
 
-void physics_world_destroy_body(PhysicsBody** body) {
-  BODY_CHECK((*body));
+void physics_world_destroy_body(PhysicsBodyID* body) {
+  PhysicsBody* nk_body = get_body(*body);
   
-  s_world->body_interface->DestroyBody((*body)->handle->GetID());
-  (*body)->handle = nullptr;
-
-  delete (*body)->collider;
-  delete (*body);
+  s_world->body_interface->DestroyBody(nk_body->handle->GetID());
+  delete nk_body->collider;
 
-  *body = nullptr;
+  // Give the slot back to the pool
+  
+  *nk_body = PhysicsBody{};
+  *body    = PhysicsBodyID{};
 }
 
-void physics_world_remove_and_destroy_body(PhysicsBody** body) {
+void physics_world_remove_and_destroy_body(PhysicsBodyID* body) {
   physics_world_remove_body(*body);
   physics_world_destroy_body(body);
 }
 
+void physics_world_remove_and_destroy_bodies(PhysicsBodyID* bodies, const sizei count) {
+  DynamicArray<JPH::BodyID> body_ids;
+  body_ids.reserve(count);
+
+  for(sizei i = 0; i < count; i++) {
+    NIKOLA_ASSERT(physics_body_is_valid(bodies[i]), "Trying to access a physics body with an invalid ID");
+    body_ids.emplace_back(body_id_to_jph_body_id(bodies[i]));
+  }
+
+  // @NOTE: Jolt sorts the IDs in-place when removing. That is fine, 
+  // since they are only used as a set from here on.
+
+  s_world->body_interface->RemoveBodies(body_ids.data(), (i32)body_ids.size());
+  s_world->body_interface->DestroyBodies(body_ids.data(), (i32)body_ids.size());
+
+  for(sizei i = 0; i < count; i++) {
+    PhysicsBody* nk_body = &s_world->bodies[bodies[i]._id];
+    delete nk_body->collider;
+
+    *nk_body  = PhysicsBody{};
+    bodies[i] = PhysicsBodyID{};
+  }
+}
+
 void physics_world_remove_character(Character* character) {
   CHARACTER_CHECK(character);
   character->handle->RemoveFromPhysicsSystem();
@@ -560,7 +691,7 @@ const bool physics_world_cast_ray(const RayCastDesc& cast_desc) {
                           (s_world->body_interface->GetCenterOfMassPosition(result->mBodyID) - ray.mOrigin);
 
     RayCastResult ray_result = {
-      .body          = reinterpret_cast<PhysicsBody*>(s_world->body_interface->GetUserData(result->mBodyID)), 
+      .body          = jph_body_id_to_body_id(result->mBodyID), 
       .point         = jph_vec3_to_vec3(hit_point),
       .ray_direction = cast_desc.direction, 
     };
@@ -622,219 +753,233 @@ const bool physics_world_is_paused() {
 ///---------------------------------------------------------------------------------------------------------------------
 /// Physics body functions
 
-void physics_body_set_position(PhysicsBody* body, const Vec3 position, const bool activate) {
-  BODY_CHECK(body);
+void physics_body_set_position(const PhysicsBodyID& body, const Vec3 position, const bool activate) {
+  PhysicsBody* nk_body = get_body(body);
 
   JPH::EActivation active = activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-  s_world->body_interface->SetPosition(body->handle->GetID(), vec3_to_jph_vec3(position), active);
+  s_world->body_interface->SetPosition(nk_body->handle->GetID(), vec3_to_jph_vec3(position), active);
 }
 
-void physics_body_set_rotation(PhysicsBody* body, const Quat rotation, const bool activate) {
-  BODY_CHECK(body);
+void physics_body_set_rotation(const PhysicsBodyID& body, const Quat rotation, const bool activate) {
+  PhysicsBody* nk_body = get_body(body);
 
   JPH::EActivation active = activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-  s_world->body_interface->SetRotation(body->handle->GetID(), quat_to_jph_quat(rotation), active);
+  s_world->body_interface->SetRotation(nk_body->handle->GetID(), quat_to_jph_quat(rotation), active);
 }
 
-void physics_body_set_rotation(PhysicsBody* body, const Vec3 axis, const f32 angle, const bool activate) {
-  BODY_CHECK(body);
+void physics_body_set_rotation(const PhysicsBodyID& body, const Vec3 axis, const f32 angle, const bool activate) {
+  PhysicsBody* nk_body = get_body(body);
  
   JPH::EActivation active = activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
   JPH::Quat rotation      = quat_to_jph_quat(quat_angle_axis(axis, angle));
   
-  s_world->body_interface->SetRotation(body->handle->GetID(), rotation, active);
+  s_world->body_interface->SetRotation(nk_body->handle->GetID(), rotation, active);
 }
 
-void physics_body_set_transform(PhysicsBody* body, const Transform& transform, const bool activate) {
-  BODY_CHECK(body);
+void physics_body_set_transform(const PhysicsBodyID& body, const Transform& transform, const bool activate) {
+  PhysicsBody* nk_body = get_body(body);
  
   JPH::EActivation active = activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
   JPH::Vec3 position      = vec3_to_jph_vec3(transform.position);
   JPH::Quat rotation      = quat_to_jph_quat(transform.rotation);
 
-  s_world->body_interface->SetPositionAndRotation(body->handle->GetID(), position, rotation, active);
+  s_world->body_interface->SetPositionAndRotation(nk_body->handle->GetID(), position, rotation, active);
 }
 
-void physics_body_set_linear_velocity(PhysicsBody* body, const Vec3 velocity) {
-  BODY_CHECK(body);
-  body->handle->SetLinearVelocity(vec3_to_jph_vec3(velocity));
+void physics_body_set_linear_velocity(const PhysicsBodyID& body, const Vec3 velocity) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->SetLinearVelocity(vec3_to_jph_vec3(velocity));
 }
 
-void physics_body_set_angular_velocity(PhysicsBody* body, const Vec3 velocity) {
-  BODY_CHECK(body);
-  body->handle->SetAngularVelocity(vec3_to_jph_vec3(velocity));
+void physics_body_set_angular_velocity(const PhysicsBodyID& body, const Vec3 velocity) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->SetAngularVelocity(vec3_to_jph_vec3(velocity));
 }
 
-void physics_body_set_active(PhysicsBody* body, const bool active) {
-  BODY_CHECK(body);
+void physics_body_set_active(const PhysicsBodyID& body, const bool active) {
+  PhysicsBody* nk_body = get_body(body);
  
   if(active) {
-    s_world->body_interface->ActivateBody(body->handle->GetID());
+    s_world->body_interface->ActivateBody(nk_body->handle->GetID());
   }
   else {
-    s_world->body_interface->DeactivateBody(body->handle->GetID());
+    s_world->body_interface->DeactivateBody(nk_body->handle->GetID());
   }
 }
 
-void physics_body_set_user_data(PhysicsBody* body, const u64 user_data) {
-  BODY_CHECK(body);
-  body->user_data = user_data;
+void physics_body_set_user_data(const PhysicsBodyID& body, const u64 user_data) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->user_data = user_data;
+}
+
+void physics_body_set_contact_events(const PhysicsBodyID& body, const bool enabled) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->has_contact_events = enabled;
 }
 
-void physics_body_set_layer(PhysicsBody* body, const PhysicsObjectLayer layer) {
-  BODY_CHECK(body);
-  s_world->body_interface->SetObjectLayer(body->handle->GetID(), (JPH::ObjectLayer)layer);
+void physics_body_set_layer(const PhysicsBodyID& body, const PhysicsObjectLayer layer) {
+  PhysicsBody* nk_body = get_body(body);
+  s_world->body_interface->SetObjectLayer(nk_body->handle->GetID(), (JPH::ObjectLayer)layer);
 }
 
-void physics_body_set_restitution(PhysicsBody* body, const f32 restitution) {
-  BODY_CHECK(body);
-  body->handle->SetRestitution(restitution);
+void physics_body_set_restitution(const PhysicsBodyID& body, const f32 restitution) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->SetRestitution(restitution);
 }
 
-void physics_body_set_friction(PhysicsBody* body, const f32 friction) {
-  BODY_CHECK(body);
-  body->handle->SetFriction(friction);
+void physics_body_set_friction(const PhysicsBodyID& body, const f32 friction) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->SetFriction(friction);
 }
 
-void physics_body_set_gravity_factor(PhysicsBody* body, const f32 factor) {
-  BODY_CHECK(body);
-  body->handle->GetMotionProperties()->SetGravityFactor(factor);
+void physics_body_set_gravity_factor(const PhysicsBodyID& body, const f32 factor) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->GetMotionProperties()->SetGravityFactor(factor);
 }
 
-void physics_body_set_type(PhysicsBody* body, const PhysicsBodyType type) {
-  BODY_CHECK(body);
+void physics_body_set_type(const PhysicsBodyID& body, const PhysicsBodyType type) {
+  PhysicsBody* nk_body = get_body(body);
   
-  body->handle->SetMotionType(body_type_to_jph_body_type(type));
+  nk_body->handle->SetMotionType(body_type_to_jph_body_type(type));
 }
 
-void physics_body_set_collider(PhysicsBody* body, const Collider* collider, const bool activate) {
-  BODY_CHECK(body);
+void physics_body_set_collider(const PhysicsBodyID& body, const Collider* collider, const bool activate) {
+  PhysicsBody* nk_body = get_body(body);
   COLLIDER_CHECK(collider);
   
   JPH::EActivation active = activate ? JPH::EActivation::Activate : JPH::EActivation::DontActivate;
-  s_world->body_interface->SetShape(body->handle->GetID(), collider->handle, true, active);
+  s_world->body_interface->SetShape(nk_body->handle->GetID(), collider->handle, true, active);
 
-  body->collider = (Collider*)collider;
+  nk_body->collider = (Collider*)collider;
 }
 
-void physics_body_apply_linear_velocity(PhysicsBody* body, const Vec3 velocity) {
-  BODY_CHECK(body);
-  s_world->body_interface->AddLinearVelocity(body->handle->GetID(), vec3_to_jph_vec3(velocity));
+void physics_body_apply_linear_velocity(const PhysicsBodyID& body, const Vec3 velocity) {
+  PhysicsBody* nk_body = get_body(body);
+  s_world->body_interface->AddLinearVelocity(nk_body->handle->GetID(), vec3_to_jph_vec3(velocity));
 }
 
-void physics_body_apply_force(PhysicsBody* body, const Vec3 force) {
-  BODY_CHECK(body);
-  body->handle->AddForce(vec3_to_jph_vec3(force));
+void physics_body_apply_force(const PhysicsBodyID& body, const Vec3 force) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->AddForce(vec3_to_jph_vec3(force));
 }
 
-void physics_body_apply_force_at(PhysicsBody* body, const Vec3 force, const Vec3 point) {
-  BODY_CHECK(body);
-  body->handle->AddForce(vec3_to_jph_vec3(force), vec3_to_jph_vec3(point));
+void physics_body_apply_force_at(const PhysicsBodyID& body, const Vec3 force, const Vec3 point) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->AddForce(vec3_to_jph_vec3(force), vec3_to_jph_vec3(point));
 }
 
-void physics_body_apply_torque(PhysicsBody* body, const Vec3 torque) {
-  BODY_CHECK(body);
-  body->handle->AddTorque(vec3_to_jph_vec3(torque));
+void physics_body_apply_torque(const PhysicsBodyID& body, const Vec3 torque) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->AddTorque(vec3_to_jph_vec3(torque));
 }
 
-void physics_body_apply_impulse(PhysicsBody* body, const Vec3 impulse) {
-  BODY_CHECK(body);
-  body->handle->AddImpulse(vec3_to_jph_vec3(impulse));
+void physics_body_apply_impulse(const PhysicsBodyID& body, const Vec3 impulse) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->AddImpulse(vec3_to_jph_vec3(impulse));
 }
 
-void physics_body_apply_impulse_at(PhysicsBody* body, const Vec3 impulse, const Vec3 point) {
-  BODY_CHECK(body);
-  body->handle->AddImpulse(vec3_to_jph_vec3(impulse), vec3_to_jph_vec3(point));
+void physics_body_apply_impulse_at(const PhysicsBodyID& body, const Vec3 impulse, const Vec3 point) {
+  PhysicsBody* nk_body = get_body(body);
+  nk_body->handle->AddImpulse(vec3_to_jph_vec3(impulse), vec3_to_jph_vec3(point));
 }
 
-void physics_body_apply_angular_impulse(PhysicsBody* body, const Vec3 impulse) {
-  BODY_CHECK(body);
-  s_world->body_interface->AddAngularImpulse(body->handle->GetID(), vec3_to_jph_vec3(impulse));
+void physics_body_apply_angular_impulse(const PhysicsBodyID& body, const Vec3 impulse) {
+  PhysicsBody* nk_body = get_body(body);
+  s_world->body_interface->AddAngularImpulse(nk_body->handle->GetID(), vec3_to_jph_vec3(impulse));
 }
 
-const Vec3 physics_body_get_position(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_vec3_to_vec3(body->handle->GetPosition());
+const Vec3 physics_body_get_position(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_vec3_to_vec3(nk_body->handle->GetPosition());
 }
 
-const Vec3 physics_body_get_com_position(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_vec3_to_vec3(s_world->body_interface->GetCenterOfMassPosition(body->handle->GetID()));
+const Vec3 physics_body_get_com_position(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_vec3_to_vec3(s_world->body_interface->GetCenterOfMassPosition(nk_body->handle->GetID()));
 }
 
-const Quat physics_body_get_rotation(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_quat_to_quat(body->handle->GetRotation());
+const Quat physics_body_get_rotation(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_quat_to_quat(nk_body->handle->GetRotation());
 }
 
-const Vec3 physics_body_get_linear_velocity(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_vec3_to_vec3(body->handle->GetLinearVelocity());
+const Vec3 physics_body_get_linear_velocity(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_vec3_to_vec3(nk_body->handle->GetLinearVelocity());
 }
 
-const Vec3 physics_body_get_angular_velocity(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_vec3_to_vec3(body->handle->GetAngularVelocity());
+const Vec3 physics_body_get_angular_velocity(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_vec3_to_vec3(nk_body->handle->GetAngularVelocity());
 }
 
-const bool physics_body_is_active(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->handle->IsActive();
+const bool physics_body_is_active(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->handle->IsActive();
 }
 
-const bool physics_body_is_sensor(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->handle->IsSensor();
+const bool physics_body_is_sensor(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->handle->IsSensor();
 }
 
-const bool physics_body_is_valid(const PhysicsBody* body) {
-  return (body && body->handle);
+const bool physics_body_has_contact_events(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->has_contact_events;
 }
 
-const u64 physics_body_get_user_data(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->user_data;
+const bool physics_body_is_valid(const PhysicsBodyID& body) {
+  if(body._id >= s_world->bodies.size()) {
+    return false;
+  }
+
+  return find_pooled_body(body_id_to_jph_body_id(body)) != nullptr;
 }
 
-const PhysicsObjectLayer physics_body_get_layer(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return (PhysicsObjectLayer)body->handle->GetObjectLayer();
+const u64 physics_body_get_user_data(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->user_data;
 }
 
-const f32 physics_body_get_restitution(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->handle->GetRestitution();
+const PhysicsObjectLayer physics_body_get_layer(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return (PhysicsObjectLayer)nk_body->handle->GetObjectLayer();
 }
 
-const f32 physics_body_get_friction(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->handle->GetFriction();
+const f32 physics_body_get_restitution(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->handle->GetRestitution();
 }
 
-const f32 physics_body_get_gravity_factor(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->handle->GetMotionProperties()->GetGravityFactor();
+const f32 physics_body_get_friction(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->handle->GetFriction();
 }
 
-const PhysicsBodyType physics_body_get_type(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return jph_body_type_to_body_type(body->handle->GetMotionType());
+const f32 physics_body_get_gravity_factor(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->handle->GetMotionProperties()->GetGravityFactor();
 }
 
-Transform physics_body_get_transform(const PhysicsBody* body) {
-  BODY_CHECK(body);
+const PhysicsBodyType physics_body_get_type(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return jph_body_type_to_body_type(nk_body->handle->GetMotionType());
+}
+
+Transform physics_body_get_transform(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
 
   Transform transform;
-  transform.position = jph_vec3_to_vec3(body->handle->GetPosition());
-  transform.rotation = jph_quat_to_quat(body->handle->GetRotation());
+  transform.position = jph_vec3_to_vec3(nk_body->handle->GetPosition());
+  transform.rotation = jph_quat_to_quat(nk_body->handle->GetRotation());
 
   transform_apply(transform);
   return transform;
 }
 
-Collider* physics_body_get_collider(const PhysicsBody* body) {
-  BODY_CHECK(body);
-  return body->collider;
+Collider* physics_body_get_collider(const PhysicsBodyID& body) {
+  PhysicsBody* nk_body = get_body(body);
+  return nk_body->collider;
 }
 
 /// Physics body functions
@@ -1099,11 +1244,17 @@ const Vec3 character_body_get_ground_velocity(const Character* character) {
   return jph_vec3_to_vec3(character->handle->GetGroundVelocity());
 }
 
-const PhysicsBody* character_body_get_ground_body(const Character* character) {
+PhysicsBodyID character_body_get_ground_body(const Character* character) {
   CHARACTER_CHECK(character);
 
-  JPH::uint64 user_data = s_world->body_interface->GetUserData(character->handle->GetGroundBodyID());
-  return reinterpret_cast<const PhysicsBody*>(user_data);
+  // Standing on nothing (or on another character)
+  
+  JPH::BodyID ground_id = character->handle->GetGroundBodyID();
+  if(ground_id.IsInvalid() || !find_pooled_body(ground_id)) {
+    return PhysicsBodyID{};
+  }
+
+  return jph_body_id_to_body_id(ground_id);
 }
 
 const bool character_body_cast_ray(const Character* character, const RayCastDesc& cast_desc) {
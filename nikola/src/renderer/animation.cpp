@@ -9,12 +9,16 @@
 
 #include <ozz/animation/runtime/animation.h>
 #include <ozz/animation/runtime/skeleton.h>
+#include <ozz/animation/runtime/skeleton_utils.h>
 #include <ozz/animation/runtime/local_to_model_job.h>
 #include <ozz/animation/runtime/sampling_job.h>
 #include <ozz/animation/runtime/blending_job.h>
+#include <ozz/animation/runtime/ik_two_bone_job.h>
+#include <ozz/animation/runtime/ik_aim_job.h>
 
 #include <ozz/base/maths/transform.h>
 #include <ozz/base/maths/simd_math.h>
+#include <ozz/base/maths/simd_quaternion.h>
 #include <ozz/base/maths/soa_transform.h>
 #include <ozz/base/maths/vec_float.h>
 
@@ -22,6 +26,27 @@
 
 namespace nikola { // Start of nikola
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The amount of time (in seconds) between each pose evaluation for every `AnimationLOD`. 
+const f32 ANIMATION_LOD_INTERVALS[ANIMATION_LOD_FROZEN] = {
+  0.0f,         // ANIMATION_LOD_FULL
+  1.0f / 30.0f, // ANIMATION_LOD_HALF
+  1.0f / 15.0f, // ANIMATION_LOD_QUARTER
+};
+
+/// The minimum screen coverage (the ratio of the bounding sphere's 
+/// projected radius to half the screen's height) for every `AnimationLOD`. 
+const f32 ANIMATION_LOD_SCREEN_SIZES[ANIMATION_LOD_FROZEN] = {
+  0.25f, // ANIMATION_LOD_FULL
+  0.1f,  // ANIMATION_LOD_HALF
+  0.03f, // ANIMATION_LOD_QUARTER
+};
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Skeleton
 struct Skeleton {
@@ -39,6 +64,18 @@ struct Animation {
 /// Animation
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// IKChain
+struct IKChain {
+  AnimationIKTarget target;
+
+  i32 start_joint  = -1;
+  i32 middle_joint = -1;
+  i32 end_joint    = -1;
+};
+/// IKChain
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// AnimationSampler
 struct AnimationSampler {
@@ -49,8 +86,13 @@ struct AnimationSampler {
   ozz::vector<ozz::math::SoaTransform> locals;
   ozz::vector<ozz::math::Float4x4> models;
   
+  DynamicArray<IKChain> ik_chains;
+  
   Array<Mat4, JOINTS_MAX> skinning_palette;
   AnimationSamplerInfo info;
+
+  f32 lod_timer = 0.0f;
+  bool has_pose = false;
 };
 /// AnimationSampler
 ///---------------------------------------------------------------------------------------------------------------------
@@ -63,6 +105,11 @@ struct AnimationBlender {
 
     ozz::animation::SamplingJob::Context context;
     ozz::vector<ozz::math::SoaTransform> locals;
+    
+    // Stays empty unless a joint mask was set on the blend
+    ozz::vector<ozz::math::SimdFloat4> joint_weights; 
+
+    AnimationBlendMode mode = ANIMATION_BLEND_NORMAL;
 
     f32 time     = 0.0f;
     f32 duration = 0.0f; 
@@ -72,15 +119,26 @@ struct AnimationBlender {
 
   Skeleton* skeleton = nullptr;
 
-  sizei blends_count = 0;
-  BlendSample blends[ANIMATION_BLENDS_MAX]; 
+  // @NOTE: The blends are allocated on the heap since the 
+  // sampling context cannot be copied around when the array grows.
+  DynamicArray<BlendSample*> blends; 
+  
+  // The indices of the blends driven by `AnimationBlenderInfo::blending_ratio`
+  DynamicArray<sizei> base_blends; 
+  
   ozz::vector<ozz::animation::BlendingJob::Layer> blend_layers;
+  ozz::vector<ozz::animation::BlendingJob::Layer> additive_layers;
 
   ozz::vector<ozz::math::SoaTransform> locals;
   ozz::vector<ozz::math::Float4x4> models;
+  
+  DynamicArray<IKChain> ik_chains;
 
   Array<Mat4, JOINTS_MAX> skinning_palette;
   AnimationBlenderInfo info;
+  
+  f32 lod_timer = 0.0f;
+  bool has_pose = false;
 };
 /// AnimationBlender ---------------------------------------------------------------------------------------------------------------------
 
@@ -127,6 +185,41 @@ static void traverse_joints(Skeleton* skeleton,
   }
 }
 
+static bool should_evaluate_pose(const AnimationLOD lod, f32& lod_timer, const bool has_pose, const f32 dt) {
+  // There has to be at least one valid pose, regardless of the LOD
+  
+  if(!has_pose) {
+    lod_timer = 0.0f;
+    return true;
+  }
+
+  if(lod >= ANIMATION_LOD_FROZEN) {
+    return false;
+  }
+
+  // Accumulate the time until the next evaluation is due. 
+  //
+  // @NOTE: The time of the animation itself is always advanced with the 
+  // full `dt`, so skipping an evaluation does not make it fall behind.
+
+  f32 interval = ANIMATION_LOD_INTERVALS[lod];
+
+  lod_timer += dt;
+  if(lod_timer < interval) {
+    return false;
+  }
+
+  // Carry the overshoot over to keep the evaluation rate steady. A long 
+  // stall, however, should only ever trigger a single evaluation.
+
+  lod_timer -= interval;
+  if(lod_timer >= interval) {
+    lod_timer = 0.0f;
+  }
+
+  return true;
+}
+
 static void update_blend_weights(AnimationBlender* blender) {
   /// @NOTE (11/12/2025, Mohamed):
   ///
@@ -134,34 +227,205 @@ static void update_blend_weights(AnimationBlender* blender) {
   /// You can see the full code here: https://github.com/guillaumeblanc/ozz-animation/blob/master/samples/blend/sample_blend.cc
   ///
 
+  // Only the base blends are driven by the blending ratio. 
+  // Additive and masked blends are controlled by the user.
+
+  DynamicArray<sizei>& bases = blender->base_blends;
+  if(bases.empty()) {
+    return;
+  }
+
+  // A single blend has nothing to blend with
+
+  if(bases.size() == 1) {
+    blender->blends[bases[0]]->weight = 1.0f;
+    blender->blends[bases[0]]->speed  = 1.0f;
+
+    return;
+  }
+
   // Compute the weight for all blends
 
-  sizei intervals_count = blender->blends_count - 1;
+  sizei intervals_count = bases.size() - 1;
   f32 interval          = 1.0f / intervals_count;
 
-  for(sizei i = 0; i < blender->blends_count; i++) {
+  for(sizei i = 0; i < bases.size(); i++) {
     f32 med = i * interval;
     f32 x   = blender->info.blending_ratio - med;
     f32 y   = ((x < 0.0f ? x : -x) + interval) * intervals_count;
 
-    blender->blends[i].weight = max_float(0.0f, y);
+    blender->blends[bases[i]]->weight = max_float(0.0f, y);
   }
 
   // Select the 2 blends that are in the range of blend ratio
 
   f32 clamped_ratio = clamp_float(blender->info.blending_ratio, 0.0f, 0.999f);
-  sizei lower       = (sizei)(clamped_ratio * (blender->blends_count - 1));
+  sizei lower       = (sizei)(clamped_ratio * (bases.size() - 1));
 
-  AnimationBlender::BlendSample& blend_l = blender->blends[lower];
-  AnimationBlender::BlendSample& blend_r = blender->blends[lower + 1];
+  AnimationBlender::BlendSample* blend_l = blender->blends[bases[lower]];
+  AnimationBlender::BlendSample* blend_r = blender->blends[bases[lower + 1]];
 
-  f32 duration = (blend_l.duration * blend_l.weight) + (blend_r.duration * blend_r.weight); 
+  f32 duration = (blend_l->duration * blend_l->weight) + (blend_r->duration * blend_r->weight); 
 
   // Find the speed coefficient for all blends
 
   f32 inv_duration = 1.0f / duration;
-  for(sizei i = 0; i < blender->blends_count; i++) {
-    blender->blends[i].speed = blender->blends[i].duration * inv_duration;
+  for(sizei i = 0; i < bases.size(); i++) {
+    AnimationBlender::BlendSample* blend = blender->blends[bases[i]];
+    blend->speed = blend->duration * inv_duration;
+  }
+}
+
+static void rebuild_base_blends(AnimationBlender* blender) {
+  blender->base_blends.clear();
+
+  for(sizei i = 0; i < blender->blends.size(); i++) {
+    AnimationBlender::BlendSample* blend = blender->blends[i];
+
+    if(blend->mode == ANIMATION_BLEND_NORMAL && blend->joint_weights.empty()) {
+      blender->base_blends.push_back(i);
+    }
+  }
+}
+
+static i32 find_joint(const Skeleton* skeleton, const String& joint_name) {
+  const ozz::animation::Skeleton* handle = skeleton->handle.get();
+
+  for(sizei i = 0; i < handle->num_joints(); i++) {
+    if(joint_name == handle->joint_names()[i]) {
+      return (i32)i;
+    }
+  }
+
+  return -1;
+}
+
+static bool is_ik_chain_valid(const IKChain& chain) {
+  if(chain.target.type == ANIMATION_IK_TWO_BONE && chain.middle_joint == -1) {
+    return false;
+  }
+
+  return chain.start_joint != -1 && chain.end_joint != -1;
+}
+
+static IKChain resolve_ik_chain(const Skeleton* skeleton, const AnimationIKTarget& target) {
+  IKChain chain = {
+    .target    = target, 
+    .end_joint = find_joint(skeleton, target.end_joint),
+  };
+
+  if(target.type == ANIMATION_IK_TWO_BONE) {
+    chain.start_joint  = find_joint(skeleton, target.start_joint);
+    chain.middle_joint = find_joint(skeleton, target.middle_joint);
+  }
+  else {
+    chain.start_joint = chain.end_joint;
+  }
+
+  if(!is_ik_chain_valid(chain)) {
+    NIKOLA_LOG_WARN("Could not resolve the joints of an IK target ending at \'%s\'. The target will be ignored", target.end_joint.c_str());
+  }
+
+  return chain;
+}
+
+static void multiply_local_rotation(ozz::vector<ozz::math::SoaTransform>& locals, const i32 joint, const ozz::math::SimdQuaternion& quat) {
+  // The rotations are stored in SoA form (4 joints per transform). 
+  // Therefore, we need to transpose them back to AoS to multiply a single joint. 
+
+  ozz::math::SoaTransform& soa_transform = locals[joint / 4];
+
+  ozz::math::SimdFloat4 aos_quats[4];
+  ozz::math::Transpose4x4(&soa_transform.rotation.x, aos_quats);
+
+  ozz::math::SimdFloat4& aos_quat = aos_quats[joint & 3];
+  aos_quat = (ozz::math::SimdQuaternion{aos_quat} * quat).xyzw;
+
+  ozz::math::Transpose4x4(aos_quats, &soa_transform.rotation.x);
+}
+
+static bool solve_ik_chain(const IKChain& chain, 
+                           ozz::vector<ozz::math::SoaTransform>& locals, 
+                           const ozz::vector<ozz::math::Float4x4>& models) {
+  const AnimationIKTarget& target = chain.target;
+
+  ozz::math::SimdFloat4 position    = ozz::math::simd_float4::Load3PtrU(&target.position[0]);
+  ozz::math::SimdFloat4 pole_vector = ozz::math::simd_float4::Load3PtrU(&target.pole_vector[0]);
+
+  // Two bone 
+
+  if(target.type == ANIMATION_IK_TWO_BONE) {
+    ozz::math::SimdQuaternion start_correction, middle_correction;
+
+    ozz::animation::IKTwoBoneJob ik_job;
+    ik_job.target                 = position;
+    ik_job.pole_vector            = pole_vector;
+    ik_job.mid_axis               = ozz::math::simd_float4::Load3PtrU(&target.middle_axis[0]);
+    ik_job.weight                 = target.weight;
+    ik_job.soften                 = target.soften;
+    ik_job.start_joint            = &models[chain.start_joint];
+    ik_job.mid_joint              = &models[chain.middle_joint];
+    ik_job.end_joint              = &models[chain.end_joint];
+    ik_job.start_joint_correction = &start_correction;
+    ik_job.mid_joint_correction   = &middle_correction;
+
+    if(!ik_job.Run()) {
+      return false;
+    }
+
+    multiply_local_rotation(locals, chain.start_joint, start_correction);
+    multiply_local_rotation(locals, chain.middle_joint, middle_correction);
+
+    return true;
+  }
+
+  // Aim
+
+  ozz::math::SimdQuaternion correction;
+
+  ozz::animation::IKAimJob ik_job;
+  ik_job.target           = position;
+  ik_job.pole_vector      = pole_vector;
+  ik_job.forward          = ozz::math::simd_float4::Load3PtrU(&target.forward[0]);
+  ik_job.up               = ozz::math::simd_float4::Load3PtrU(&target.up[0]);
+  ik_job.weight           = target.weight;
+  ik_job.joint            = &models[chain.end_joint];
+  ik_job.joint_correction = &correction;
+
+  if(!ik_job.Run()) {
+    return false;
+  }
+
+  multiply_local_rotation(locals, chain.end_joint, correction);
+  return true;
+}
+
+static void apply_ik_chains(const Skeleton* skeleton, 
+                            DynamicArray<IKChain>& chains, 
+                            ozz::vector<ozz::math::SoaTransform>& locals, 
+                            ozz::vector<ozz::math::Float4x4>& models) {
+  for(auto& chain : chains) {
+    if(chain.target.weight <= 0.0f || !is_ik_chain_valid(chain)) {
+      continue;
+    }
+
+    if(!solve_ik_chain(chain, locals, models)) {
+      NIKOLA_LOG_DEBUG("Failed to run the IK job for a target ending at \'%s\'", chain.target.end_joint.c_str());
+      continue;
+    }
+
+    // Only the corrected joints and their children need 
+    // to have their model matrices recomputed. 
+
+    ozz::animation::LocalToModelJob local_to_model_job;
+    local_to_model_job.skeleton = skeleton->handle.get();
+    local_to_model_job.from     = chain.start_joint;
+    local_to_model_job.input    = make_span(locals);
+    local_to_model_job.output   = make_span(models);
+
+    if(!local_to_model_job.Run()) {
+      NIKOLA_LOG_DEBUG("Failed to run the partial local to model job of an IK target");
+    }
   }
 }
 
@@ -290,6 +554,37 @@ Animation* animation_create(const NBRAnimation& nbr_anim) {
   return anim;
 }
 
+bool animation_reload(Animation* anim, const NBRAnimation& nbr_anim) {
+  NIKOLA_ASSERT(anim, "Cannot reload an invalid animation");
+
+  // Build a whole new animation first, so that a 
+  // faulty file does not leave `anim` in a broken state.
+
+  Animation* new_anim = animation_create(nbr_anim);
+  if(!new_anim) {
+    return false;
+  }
+
+  // Samplers that reference `anim` size their contexts depending on 
+  // the number of tracks. Hence, a mismatch would break them.
+
+  if(anim->handle && (anim->handle->num_tracks() != new_anim->handle->num_tracks())) {
+    NIKOLA_LOG_WARN("Cannot reload animation with a different tracks count (%i != %i)", 
+                    anim->handle->num_tracks(), 
+                    new_anim->handle->num_tracks());
+
+    animation_destroy(new_anim);
+    return false;
+  }
+
+  // Swap the handles, leaving any references to `anim` intact
+
+  std::swap(anim->handle, new_anim->handle);
+  animation_destroy(new_anim);
+
+  return true;
+}
+
 void animation_destroy(Animation* anim) {
   if(!anim) {
     return;
@@ -299,6 +594,40 @@ void animation_destroy(Animation* anim) {
   delete anim;
 }
 
+const AnimationLOD animation_lod_evaluate(const Camera& camera, const Vec3& position, const f32 radius) {
+  Vec3 view_pos = Vec3(camera.view * Vec4(position, 1.0f));
+  f32 depth     = -view_pos.z; // The camera looks down the negative Z axis
+
+  f32 tan_y = nikola::tan(TO_RADIANS(camera.zoom) * 0.5f);
+  f32 tan_x = tan_y * camera.aspect_ratio;
+
+  // Check against the frustum first. 
+  //
+  // @NOTE: The side planes are tilted, so the radius has to be scaled 
+  // by the secant of the half angle to get a conservative test.
+
+  if((depth + radius) < camera.near || (depth - radius) > camera.far) {
+    return ANIMATION_LOD_FROZEN;
+  }
+
+  if(nikola::abs(view_pos.x) > (depth * tan_x + radius * (f32)nikola::sqrt(1.0f + tan_x * tan_x)) ||
+     nikola::abs(view_pos.y) > (depth * tan_y + radius * (f32)nikola::sqrt(1.0f + tan_y * tan_y))) {
+    return ANIMATION_LOD_FROZEN;
+  }
+
+  // Pick a level based on the screen coverage
+
+  f32 coverage = radius / (max_float(depth, camera.near) * tan_y);
+
+  for(sizei i = 0; i < ANIMATION_LOD_FROZEN; i++) {
+    if(coverage >= ANIMATION_LOD_SCREEN_SIZES[i]) {
+      return (AnimationLOD)i;
+    }
+  }
+
+  return ANIMATION_LOD_FROZEN;
+}
+
 /// Animation functions
 ///---------------------------------------------------------------------------------------------------------------------
 
@@ -341,6 +670,7 @@ void animation_sampler_destroy(AnimationSampler* sampler) {
 
   sampler->locals.clear();
   sampler->models.clear();
+  sampler->ik_chains.clear();
   sampler->context.Invalidate();
 
   delete sampler;
@@ -356,6 +686,25 @@ const Array<Mat4, JOINTS_MAX>& animation_sampler_get_skinning_palette(const Anim
   return sampler->skinning_palette;
 }
 
+const sizei animation_sampler_get_joints_count(const AnimationSampler* sampler) {
+  NIKOLA_ASSERT(sampler, "Invalid AnimationSampler given to animation_sampler_get_joints_count");
+  return (sizei)min_int((i32)sampler->skeleton->inverse_bind_matrices.size(), (i32)JOINTS_MAX);
+}
+
+const sizei animation_sampler_push_ik_target(AnimationSampler* sampler, const AnimationIKTarget& target) {
+  NIKOLA_ASSERT(sampler, "Invalid AnimationSampler given to animation_sampler_push_ik_target");
+
+  sampler->ik_chains.push_back(resolve_ik_chain(sampler->skeleton, target));
+  return sampler->ik_chains.size() - 1;
+}
+
+AnimationIKTarget& animation_sampler_get_ik_target(AnimationSampler* sampler, const sizei index) {
+  NIKOLA_ASSERT(sampler, "Invalid AnimationSampler given to animation_sampler_get_ik_target");
+  NIKOLA_ASSERT((index >= 0 && index < sampler->ik_chains.size()), "Invalid index given to animation_sampler_get_ik_target");
+
+  return sampler->ik_chains[index].target;
+}
+
 void animation_sampler_update(AnimationSampler* sampler, const f32 dt) {
   NIKOLA_ASSERT(sampler, "Invalid AnimationSampler given to animation_sampler_update");
 
@@ -383,6 +732,12 @@ void animation_sampler_update(AnimationSampler* sampler, const f32 dt) {
   // Update the time 
   sampler->info.current_time += (dt * sampler->info.play_speed) / duration;
 
+  // Not the time to evaluate the pose yet...
+
+  if(!should_evaluate_pose(sampler->info.lod, sampler->lod_timer, sampler->has_pose, dt)) {
+    return;
+  }
+
   // Sampling job
 
   ozz::animation::SamplingJob sample_job;
@@ -408,6 +763,9 @@ void animation_sampler_update(AnimationSampler* sampler, const f32 dt) {
     return;
   }
 
+  // Inverse kinematics
+  apply_ik_chains(sampler->skeleton, sampler->ik_chains, sampler->locals, sampler->models);
+
   // Convert the newly calculated models into our engine format
 
   for(sizei i = 0; i < sampler->models.size(); i++) {
@@ -424,6 +782,8 @@ void animation_sampler_update(AnimationSampler* sampler, const f32 dt) {
     // Set the skinning matrix
     sampler->skinning_palette[i] = mat4_make(raw_mat) * sampler->skeleton->inverse_bind_matrices[i];
   }
+
+  sampler->has_pose = true;
 }
 
 /// AnimatorSampler functions
@@ -452,44 +812,87 @@ void animation_blender_destroy(AnimationBlender* blender) {
   }
 
   for(auto& blend : blender->blends) {
-    blend.animation = nullptr;
+    blend->animation = nullptr;
+
+    blend->context.Invalidate(); 
+    blend->locals.clear();
+    blend->joint_weights.clear();
 
-    blend.context.Invalidate(); 
-    blend.locals.clear();
+    delete blend;
   } 
 
+  blender->blends.clear();
+
   blender->locals.clear();
   blender->models.clear();
+  blender->ik_chains.clear();
 
   delete blender;
 }
 
-void animation_blender_push_animation(AnimationBlender* blender, const ResourceID& animation_id) {
+void animation_blender_push_animation(AnimationBlender* blender, const ResourceID& animation_id, const AnimationBlendMode mode) {
   NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_push_animation");
 
   // Init the blend sample
 
-  AnimationBlender::BlendSample* sample = &blender->blends[blender->blends_count];
+  AnimationBlender::BlendSample* sample = new AnimationBlender::BlendSample{};
 
   sample->animation = resources_get_animation(animation_id);
   sample->duration  = sample->animation->handle->duration();
+  sample->mode      = mode;
+  sample->weight    = (mode == ANIMATION_BLEND_ADDITIVE) ? 1.0f : 0.0f;
 
   sample->locals.resize(blender->skeleton->handle->num_soa_joints());
   sample->context.Resize(blender->skeleton->handle->num_joints());
 
-  // Add a new layer for later
-  blender->blend_layers.push_back(ozz::animation::BlendingJob::Layer{});
-
   // New blend!
-  blender->blends_count++;
+  
+  blender->blends.push_back(sample);
+  rebuild_base_blends(blender);
 }
 
 void animation_blender_set_animation_weight(AnimationBlender* blender, const sizei anim_index, const f32 weight) {
   NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_set_animation_weight");
-  NIKOLA_ASSERT((anim_index >= 0 && anim_index < ANIMATION_BLENDS_MAX), 
-                "Invalid AnimationBlender given to animation_blender_set_animation_weight");
+  NIKOLA_ASSERT((anim_index >= 0 && anim_index < blender->blends.size()), 
+                "Invalid index given to animation_blender_set_animation_weight");
 
-  blender->blends[anim_index].weight = weight;
+  blender->blends[anim_index]->weight = weight;
+}
+
+void animation_blender_set_joint_mask(AnimationBlender* blender, const sizei anim_index, const String& joint_name, const f32 weight) {
+  NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_set_joint_mask");
+  NIKOLA_ASSERT((anim_index >= 0 && anim_index < blender->blends.size()), 
+                "Invalid index given to animation_blender_set_joint_mask");
+
+  const ozz::animation::Skeleton* skeleton = blender->skeleton->handle.get();
+  AnimationBlender::BlendSample* blend     = blender->blends[anim_index];
+
+  // Find the root joint of the mask
+
+  i32 root_joint = find_joint(blender->skeleton, joint_name);
+  if(root_joint == -1) {
+    NIKOLA_LOG_WARN("Could not find joint \'%s\' to mask in AnimationBlender", joint_name.c_str());
+    return;
+  }
+
+  // The first mask on the blend excludes every other joint and 
+  // takes the blend out of the blending ratio's control
+
+  if(blend->joint_weights.empty()) {
+    blend->joint_weights.resize(skeleton->num_soa_joints(), ozz::math::simd_float4::zero());
+    blend->weight = 1.0f;
+
+    rebuild_base_blends(blender);
+  }
+
+  // Apply the weight to the joint and all of its children. 
+  // The weights are stored in SoA form, where each `SimdFloat4` holds 4 joints. 
+
+  ozz::math::SimdFloat4 simd_weight = ozz::math::simd_float4::Load1(weight);
+  ozz::animation::IterateJointsDF(*skeleton, [&](int joint, int) {
+    ozz::math::SimdFloat4& soa_weight = blend->joint_weights[joint / 4];
+    soa_weight = ozz::math::SetI(soa_weight, simd_weight, joint % 4);
+  }, root_joint);
 }
 
 AnimationBlenderInfo& animation_blender_get_info(AnimationBlender* blender) {
@@ -497,11 +900,30 @@ AnimationBlenderInfo& animation_blender_get_info(AnimationBlender* blender) {
   return blender->info;
 }
 
+const sizei animation_blender_push_ik_target(AnimationBlender* blender, const AnimationIKTarget& target) {
+  NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_push_ik_target");
+
+  blender->ik_chains.push_back(resolve_ik_chain(blender->skeleton, target));
+  return blender->ik_chains.size() - 1;
+}
+
+AnimationIKTarget& animation_blender_get_ik_target(AnimationBlender* blender, const sizei index) {
+  NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_get_ik_target");
+  NIKOLA_ASSERT((index >= 0 && index < blender->ik_chains.size()), "Invalid index given to animation_blender_get_ik_target");
+
+  return blender->ik_chains[index].target;
+}
+
 const Array<Mat4, JOINTS_MAX>& animation_blender_get_skinning_palette(const AnimationBlender* blender) {
   NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_get_skinning_palette");
   return blender->skinning_palette;
 }
 
+const sizei animation_blender_get_joints_count(const AnimationBlender* blender) {
+  NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_get_joints_count");
+  return (sizei)min_int((i32)blender->skeleton->inverse_bind_matrices.size(), (i32)JOINTS_MAX);
+}
+
 void animation_blender_update(AnimationBlender* blender, const f32 dt) {
   NIKOLA_ASSERT(blender, "Invalid AnimationBlender given to animation_blender_update");
   
@@ -514,37 +936,46 @@ void animation_blender_update(AnimationBlender* blender, const f32 dt) {
   // Update each blend's weight before animating
   update_blend_weights(blender);
 
-  // Sampling jobs
-
-  for(sizei i = 0; i < blender->blends_count; i++) {
-    AnimationBlender::BlendSample& blend = blender->blends[i];
+  // Update the time of each blend
 
+  for(auto& blend : blender->blends) {
     // Looping is turned off and we're past the end so continue...
     // Otherwise, we can start the animation again. 
 
-    if(!blender->info.is_looping && blend.time > blend.duration) {
+    if(!blender->info.is_looping && blend->time > blend->duration) {
       continue;
     }
-    else if(blend.time > blend.duration) { 
-      blend.time = 0.0f;
+    else if(blend->time > blend->duration) { 
+      blend->time = 0.0f;
     }
 
-    // Update the time 
-    blend.time += (dt * blend.speed) / blend.duration;
+    blend->time += (dt * blend->speed) / blend->duration;
+  }
+
+  // Not the time to evaluate the pose yet...
+
+  if(!should_evaluate_pose(blender->info.lod, blender->lod_timer, blender->has_pose, dt)) {
+    return;
+  }
+
+  // Sampling jobs
+
+  for(sizei i = 0; i < blender->blends.size(); i++) {
+    AnimationBlender::BlendSample* blend = blender->blends[i];
 
     // The weight is too small to be considered in the blend... skip
 
-    if(blend.weight <= 0.0f) {
+    if(blend->weight <= 0.0f) {
       continue;
     }
 
     // Initiate the job
 
     ozz::animation::SamplingJob sample_job;
-    sample_job.animation = blend.animation->handle.get();
-    sample_job.context   = &blend.context;
-    sample_job.ratio     = blend.time;
-    sample_job.output    = make_span(blend.locals);
+    sample_job.animation = blend->animation->handle.get();
+    sample_job.context   = &blend->context;
+    sample_job.ratio     = blend->time;
+    sample_job.output    = make_span(blend->locals);
 
     if(!sample_job.Run()) {
       NIKOLA_LOG_DEBUG("Failed to run the sampling job for a blend at index \'%zu\'", i);
@@ -552,21 +983,35 @@ void animation_blender_update(AnimationBlender* blender, const f32 dt) {
     }
   }
   
-  // Setup the blending layers
+  // Setup the blending layers, skipping any blends that were not sampled
+
+  blender->blend_layers.clear();
+  blender->additive_layers.clear();
 
-  for(sizei i = 0; i < blender->blends_count; i++) {
-    AnimationBlender::BlendSample& blend      = blender->blends[i];
-    ozz::animation::BlendingJob::Layer& layer = blender->blend_layers[i];
+  for(auto& blend : blender->blends) {
+    if(blend->weight <= 0.0f) {
+      continue;
+    }
 
-    layer.transform = make_span(blend.locals);
-    layer.weight    = blend.weight;
+    ozz::animation::BlendingJob::Layer layer;
+    layer.transform     = make_span(blend->locals);
+    layer.weight        = blend->weight;
+    layer.joint_weights = make_span(blend->joint_weights);
+
+    if(blend->mode == ANIMATION_BLEND_ADDITIVE) {
+      blender->additive_layers.push_back(layer);
+    }
+    else {
+      blender->blend_layers.push_back(layer);
+    }
   }
   
   // Blending job 
 
   ozz::animation::BlendingJob blending_job;
-  blending_job.threshold = blender->info.blending_threshold;
-  blending_job.layers    = make_span(blender->blend_layers);
+  blending_job.threshold       = blender->info.blending_threshold;
+  blending_job.layers          = make_span(blender->blend_layers);
+  blending_job.additive_layers = make_span(blender->additive_layers);
   blending_job.rest_pose = blender->skeleton->handle->joint_rest_poses();
   blending_job.output    = make_span(blender->locals);
 
@@ -587,6 +1032,9 @@ void animation_blender_update(AnimationBlender* blender, const f32 dt) {
     return;
   }
 
+  // Inverse kinematics
+  apply_ik_chains(blender->skeleton, blender->ik_chains, blender->locals, blender->models);
+
   // Convert the newly calculated models into our engine format
 
   for(sizei i = 0; i < blender->models.size(); i++) {
@@ -603,6 +1051,8 @@ void animation_blender_update(AnimationBlender* blender, const f32 dt) {
     // Set the skinning matrix
     blender->skinning_palette[i] = mat4_make(raw_mat) * blender->skeleton->inverse_bind_matrices[i];
   }
+
+  blender->has_pose = true;
 }
 
 /// AnimationBlender functions
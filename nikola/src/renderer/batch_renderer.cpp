@@ -13,9 +13,18 @@ namespace nikola { // Start of nikola
 /// ----------------------------------------------------------------------
 /// Consts
 
-const sizei MAX_DRAW_CALLS          = 1024;
+/// The maximum amount of quads that can be rendered in a single draw call.
+const sizei QUADS_MAX               = 8192;
 const sizei MATERIAL2D_BUFFER_INDEX = 5;
 
+/// The amount of segments in the frame region of the vertex, material, and command 
+/// buffers. Each flush within a frame writes into the next segment, so it never 
+/// touches the data of an in-flight draw call.
+///
+/// @NOTE: Once all the segments of a frame are used up, the batch renderer 
+/// waits for the GPU to go idle before starting over from the first segment.
+const sizei BATCH_RING_SEGMENTS     = 3;
+
 /// Consts
 /// ----------------------------------------------------------------------
 
@@ -45,14 +54,14 @@ struct Vertex2D {
 /// ----------------------------------------------------------------------
 /// Material2D
 struct Material2D {
+  u64 texture_handle = 0;
   Vec2 size; 
-  Vec2 __padding0;
 
-  f32 radius       = 0.0f; 
-  f32 sides_count  = 4.0f;
-  f32 shape_type = 0.0f; 
+  f32 radius      = 0.0f; 
+  f32 sides_count = 4.0f;
+  f32 shape_type  = 0.0f; 
   
-  f32 __padding1;
+  f32 __padding0;
 };
 /// Material2D
 /// ----------------------------------------------------------------------
@@ -73,15 +82,26 @@ struct BatchRenderer {
   GfxContextDesc ctx_desc = {}; 
 
   ShaderContext* batch_shader;
+  ShaderUniformID ortho_uniform;
 
   GfxPipelineDesc pipe_desc   = {};
   GfxPipeline* pipeline       = nullptr; 
   GfxBuffer* materials_buffer = nullptr;
+  GfxBuffer* command_buffer   = nullptr;
+
+  // @NOTE: Every texture is referenced by its bindless handle 
+  // in the materials buffer. Hence, all the quads, shapes, and text 
+  // can be rendered using only one batch (and one draw call).
+  Batch batch;
+  sizei ring_segment = 0;
 
-  DynamicArray<GfxTexture*> textures;
-  HashMap<GfxTexture*, Batch> textures_table;
+  // The stream region `ring_segment` belongs to
+  u32 stream_region = (u32)-1;
   
-  Mat4 ortho = Mat4(1.0f);
+  u64 default_handle = 0;
+  Mat4 ortho         = Mat4(1.0f);
+
+  GfxQuery* gpu_timer = nullptr;
 };
 
 static BatchRenderer s_batch;
@@ -96,14 +116,45 @@ static void init_defaults() {
   
   GfxBufferDesc buff_desc = {
     .data  = nullptr,
-    .size  = sizeof(Vertex2D) * (MAX_DRAW_CALLS * 6),
+    .size  = sizeof(Vertex2D) * (QUADS_MAX * 4) * BATCH_RING_SEGMENTS,
     .type  = GFX_BUFFER_VERTEX, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
 
   s_batch.pipe_desc.vertex_buffer  = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
   s_batch.pipe_desc.vertices_count = 0;
 
+  // Index buffer init 
+  //
+  // @NOTE: The indices of every quad follow the same pattern. So they 
+  // are only generated once and shared by all the quads.
+
+  DynamicArray<u32> indices;
+  indices.reserve(QUADS_MAX * 6);
+
+  for(u32 i = 0; i < (u32)QUADS_MAX; i++) {
+    u32 offset = i * 4;
+
+    indices.push_back(offset + 0);
+    indices.push_back(offset + 1);
+    indices.push_back(offset + 2);
+    
+    indices.push_back(offset + 2);
+    indices.push_back(offset + 3);
+    indices.push_back(offset + 0);
+  }
+
+  buff_desc = {
+    .data  = indices.data(),
+    .size  = sizeof(u32) * indices.size(),
+    .type  = GFX_BUFFER_INDEX, 
+    .usage = GFX_BUFFER_USAGE_STATIC_DRAW,
+  };
+
+  s_batch.pipe_desc.index_buffer  = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+  s_batch.pipe_desc.indices_count = indices.size();
+  s_batch.pipe_desc.indices_type  = GFX_LAYOUT_UINT1;
+
   // Layout init
   
   s_batch.pipe_desc.layouts[0].attributes[0]    = GFX_LAYOUT_FLOAT2;
@@ -122,72 +173,84 @@ static void init_defaults() {
 
   buff_desc = {
     .data  = nullptr,
-    .size  = sizeof(Material2D) * MAX_DRAW_CALLS,
+    .size  = sizeof(Material2D) * QUADS_MAX * BATCH_RING_SEGMENTS,
     .type  = GFX_BUFFER_SHADER_STORAGE, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
   s_batch.materials_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+
+  // Command buffer init
+  //
+  // @NOTE: The amount of indices changes every frame. Instead of updating the 
+  // pipeline every time, the count is sent through an indirect draw command.
+
+  buff_desc = {
+    .data  = nullptr,
+    .size  = sizeof(GfxDrawCommandIndirect) * BATCH_RING_SEGMENTS,
+    .type  = GFX_BUFFER_DRAW_INDIRECT, 
+    .usage = GFX_BUFFER_USAGE_STREAM,
+  };
+  s_batch.command_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
   
   // Default texture init
+  s_batch.default_handle = gfx_texture_get_bindless_id(renderer_get_defaults().albedo_texture);
 
-  GfxTexture* default_texture = renderer_get_defaults().albedo_texture;
+  // Batch init
 
-  s_batch.textures.push_back(default_texture);
-  s_batch.textures_table[default_texture] = Batch{};
+  s_batch.batch.vertices.reserve(QUADS_MAX * 4);
+  s_batch.batch.materials.reserve(QUADS_MAX);
   
   // Batch shader init
   
   ResourceID batch_shader      = resources_push_shader(RESOURCE_CACHE_ID, generate_batch_quad_shader());
   ResourceID shader_context_id = resources_push_shader_context(RESOURCE_CACHE_ID, batch_shader);
 
-  s_batch.batch_shader = resources_get_shader_context(shader_context_id);
+  s_batch.batch_shader  = resources_get_shader_context(shader_context_id);
+  s_batch.ortho_uniform = shader_context_cache_uniform(s_batch.batch_shader, "u_ortho");
 
   // Attach the material buffer
   gfx_buffer_bind_point(s_batch.materials_buffer, MATERIAL2D_BUFFER_INDEX);
 }
 
 static void generate_quad_batch(Batch* batch, const Rect2D& src, const Rect2D& dest, const Vec4& color, const Material2D& material) {
+  // The material index is absolute into the materials ring
+  f32 material_index = (f32)((s_batch.ring_segment * QUADS_MAX) + batch->materials.size());
+  
   // Top-left
  
-  Vertex2D v1 = {
+  batch->vertices.push_back(Vertex2D {
     .position       = dest.position,
     .texture_coords = src.position / src.size,
     .color          = color,
-    .material_index = (f32)batch->materials.size(),
-  };
-  batch->vertices.push_back(v1);
+    .material_index = material_index,
+  });
 
   // Top-right
   
-  Vertex2D v2 = {
+  batch->vertices.push_back(Vertex2D {
     .position       = Vec2(dest.position.x + dest.size.x, dest.position.y),
     .texture_coords = Vec2((src.position.x + src.size.x) / src.size.x, src.position.y / src.size.y),
     .color          = color,
-    .material_index = (f32)batch->materials.size(),
-  };
-  batch->vertices.push_back(v2);
+    .material_index = material_index,
+  });
 
   // Bottom-right
   
-  Vertex2D v3 = {
+  batch->vertices.push_back(Vertex2D {
     .position       = dest.position + dest.size,
     .texture_coords = (src.position + src.size) / src.size,
     .color          = color,
-    .material_index = (f32)batch->materials.size(),
-  };
-  batch->vertices.push_back(v3);
-  batch->vertices.push_back(v3);
+    .material_index = material_index,
+  });
 
   // Bottom-left
   
-  Vertex2D v4 = {
+  batch->vertices.push_back(Vertex2D {
     .position       = Vec2(dest.position.x, dest.position.y + dest.size.y),
     .texture_coords = Vec2(src.position.x / src.size.x, (src.position.y + src.size.y) / src.size.y),
     .color          = color,
-    .material_index = (f32)batch->materials.size(),
-  };
-  batch->vertices.push_back(v4);
-  batch->vertices.push_back(v1);
+    .material_index = material_index,
+  });
 
   // New material added!
   batch->materials.push_back(material);
@@ -207,66 +270,84 @@ static void generate_quad_batch(Batch* batch, const Vec2& pos, const Vec2& size,
   generate_quad_batch(batch, src, dest, color, material);
 }
 
-static void flush_batch(GfxTexture* texture) {
-  Batch& batch = s_batch.textures_table[texture];
+static void flush_batch() {
+  Batch& batch = s_batch.batch;
+  if(batch.materials.empty()) {
+    return;
+  }
 
   // Update the vertex buffer
   
+  sizei vertices_offset = s_batch.ring_segment * (QUADS_MAX * 4);
   gfx_buffer_upload_data(s_batch.pipe_desc.vertex_buffer, 
-                         0, 
+                         sizeof(Vertex2D) * vertices_offset, 
                          sizeof(Vertex2D) * batch.vertices.size(), 
                          batch.vertices.data());
-  
-  s_batch.pipe_desc.vertices_count = batch.vertices.size();
-  gfx_pipeline_update(s_batch.pipeline, s_batch.pipe_desc); 
 
   // Update the materials buffer
   
   gfx_buffer_upload_data(s_batch.materials_buffer, 
-                         0, 
+                         sizeof(Material2D) * (s_batch.ring_segment * QUADS_MAX), 
                          sizeof(Material2D) * batch.materials.size(), 
                          batch.materials.data());
 
+  // Update the command buffer
+
+  GfxDrawCommandIndirect command = {
+    .elements_count = (u32)(batch.materials.size() * 6), 
+    .instance_count = 1, 
+    .first_element  = 0, 
+    .base_vertex    = (i32)vertices_offset, 
+    .base_instance  = 0,
+  };
+  sizei command_offset = sizeof(GfxDrawCommandIndirect) * s_batch.ring_segment;
+  gfx_buffer_upload_data(s_batch.command_buffer, command_offset, sizeof(GfxDrawCommandIndirect), &command);
+
   // Use the resources
   
   GfxBindingDesc bind_desc = {
     .shader = s_batch.batch_shader->shader,
 
-    .textures       = &texture, 
-    .textures_count = 1,
+    .buffers       = &s_batch.command_buffer, 
+    .buffers_count = 1,
   };
   gfx_context_use_bindings(s_batch.context, bind_desc);
+  shader_context_flush(s_batch.batch_shader);
 
   // Render the batch
   
   gfx_context_use_pipeline(s_batch.context, s_batch.pipeline); 
-  gfx_context_draw(s_batch.context, 0);
+  gfx_context_draw_multi_indirect(s_batch.context, command_offset, 1);
 
   // Reset back to normal
   
   batch.vertices.clear();
   batch.materials.clear();
+
+  s_batch.ring_segment++;
 }
 
-static Batch* prepare_texture_batch(GfxTexture* texture) {
-  // Looks up the texture in the cache and pushes a 
-  // new batch if the given `texture` is new
+static Batch* prepare_batch() {
+  // We cannot render more than the maximum number of quads
   
-  if(s_batch.textures_table.find(texture) == s_batch.textures_table.end()) {
-    s_batch.textures.push_back(texture);
-    s_batch.textures_table[texture] = Batch{};
+  if(s_batch.batch.materials.size() >= QUADS_MAX) {
+    flush_batch();
   }
 
-  // Retrieve the batch from the texture table
-  Batch* batch = &s_batch.textures_table[texture]; 
+  // Every segment of this frame has a draw call in flight. The only 
+  // safe way to reuse them is to wait until the GPU is done with all of them.
+  //
+  // @NOTE: This has to happen before any quads get added, since 
+  // their material indices depend on the current segment.
 
-  // We cannot render more than the maximum number of calls
-  
-  if(batch->materials.size() >= MAX_DRAW_CALLS) {
-    flush_batch(texture);
+  if(s_batch.ring_segment >= BATCH_RING_SEGMENTS) {
+    NIKOLA_LOG_DEBUG("Ran out of batch segments in a single frame. Waiting for the GPU...");
+    
+    gfx_context_wait_idle(s_batch.context);
+    s_batch.ring_segment = 0;
   }
 
-  return batch;
+  return &s_batch.batch;
 }
 
 /// Private functions
@@ -284,13 +365,18 @@ void batch_renderer_init() {
 
   // Defaults init
   init_defaults();
+
+  // @NOTE: The batch renderer is usually used in the middle of other 
+  // measurements. Hence, the (nestable) timestamps.
+  s_batch.gpu_timer = gfx_query_create(s_batch.context, GFX_QUERY_TIMESTAMP);
 }
 
 void batch_renderer_shutdown() {
   gfx_pipeline_destroy(s_batch.pipeline);
+  gfx_query_destroy(s_batch.gpu_timer);
   
-  s_batch.textures.clear();
-  s_batch.textures_table.clear();
+  s_batch.batch.vertices.clear();
+  s_batch.batch.materials.clear();
 }
 
 void batch_renderer_begin() {
@@ -302,40 +388,45 @@ void batch_renderer_begin() {
   // Calculate the orthographic camera view and send it to the shader
   
   s_batch.ortho = mat4_ortho(0.0f, (f32)width, (f32)height, 0.0f);
-  shader_context_set_uniform(s_batch.batch_shader, "u_ortho", s_batch.ortho);
+  shader_context_set_uniform(s_batch.batch_shader, s_batch.ortho_uniform, s_batch.ortho);
+
+  // Every frame gets a new region in the stream buffers. Any other 
+  // begin within the same frame must carry on from the last used segment.
+
+  u32 region = gfx_context_get_stream_region(s_batch.context);
+  if(s_batch.stream_region != region) {
+    s_batch.stream_region = region;
+    s_batch.ring_segment  = 0;
+  }
 }
 
 void batch_renderer_end() {
   NIKOLA_PROFILE_FUNCTION();
 
-  // Render all of the batches 
-  
-  for(auto& texture : s_batch.textures) {
-    flush_batch(texture);
-  }
-
-  // Reset the textures state
+  // Render everything in one go
 
-  s_batch.textures.clear();
-  s_batch.textures_table.clear();
-  
-  GfxTexture* default_texture = renderer_get_defaults().albedo_texture;
-  s_batch.textures.push_back(default_texture);
+  gfx_query_begin(s_batch.gpu_timer);
+  flush_batch();
+  gfx_query_end(s_batch.gpu_timer);
+}
 
-  s_batch.textures_table[default_texture] = Batch{};
+const f64 batch_renderer_get_gpu_time() {
+  return gfx_query_get_elapsed(s_batch.gpu_timer);
 }
 
 void batch_render_texture(GfxTexture* texture, const Rect2D& src, const Rect2D& dest, const Vec4& tint) {
   NIKOLA_ASSERT(texture, "Trying to render a NULL texture in batch_render_texture");
+  NIKOLA_ASSERT(gfx_texture_get_desc(texture).is_bindless, "Only bindless textures can be rendered in batch_render_texture");
  
-  // Prepare the texture batch
-  Batch* batch = prepare_texture_batch(texture);
+  // Prepare the batch
+  Batch* batch = prepare_batch();
 
   // Generate vertices of a quad 
   
   Material2D material = {
-    .size       = dest.size, 
-    .shape_type = (f32)SHAPE_TYPE_QUAD, 
+    .texture_handle = gfx_texture_get_bindless_id(texture),
+    .size           = dest.size, 
+    .shape_type     = (f32)SHAPE_TYPE_QUAD, 
   };
   generate_quad_batch(batch, src, dest, tint, material);
 }
@@ -355,15 +446,16 @@ void batch_render_texture(GfxTexture* texture, const Vec2& position, const Vec2&
 }
 
 void batch_render_quad(const Vec2& position, const Vec2& size, const f32 radius, const Vec4& color) {
-  // Prepare the texture batch
-  Batch* batch = prepare_texture_batch(s_batch.textures[0]);
+  // Prepare the batch
+  Batch* batch = prepare_batch();
   
   // Generate vertices of a quad 
   
   Material2D material = {
-    .size       = size, 
-    .radius     = radius,
-    .shape_type = (f32)SHAPE_TYPE_QUAD, 
+    .texture_handle = s_batch.default_handle,
+    .size           = size, 
+    .radius         = radius,
+    .shape_type     = (f32)SHAPE_TYPE_QUAD, 
   };
   generate_quad_batch(batch, position, size, color, material);
 }
@@ -373,30 +465,32 @@ void batch_render_quad(const Vec2& position, const Vec2& size, const Vec4& color
 }
 
 void batch_render_circle(const Vec2& center, const f32 radius, const Vec4& color) {
-  // Prepare the texture batch
-  Batch* batch = prepare_texture_batch(s_batch.textures[0]);
+  // Prepare the batch
+  Batch* batch = prepare_batch();
   
   // Generate vertices of a quad 
   
   Material2D material = {
-    .size       = Vec2(radius), 
-    .radius     = radius,
-    .shape_type = (f32)SHAPE_TYPE_CIRCLE, 
+    .texture_handle = s_batch.default_handle,
+    .size           = Vec2(radius), 
+    .radius         = radius,
+    .shape_type     = (f32)SHAPE_TYPE_CIRCLE, 
   };
   generate_quad_batch(batch, center, Vec2(radius), color, material);
 }
 
 void batch_render_polygon(const Vec2& center, const f32 radius, const u32 sides, const Vec4& color) {
-  // Prepare the texture batch
-  Batch* batch = prepare_texture_batch(s_batch.textures[0]);
+  // Prepare the batch
+  Batch* batch = prepare_batch();
   
   // Generate vertices of a quad 
   
   Material2D material = {
-    .size        = Vec2(radius), 
-    .radius      = radius,
-    .sides_count = (f32)sides,
-    .shape_type  = (f32)SHAPE_TYPE_POLYGON, 
+    .texture_handle = s_batch.default_handle,
+    .size           = Vec2(radius), 
+    .radius         = radius,
+    .sides_count    = (f32)sides,
+    .shape_type     = (f32)SHAPE_TYPE_POLYGON, 
   };
   generate_quad_batch(batch, center, Vec2(radius), color, material);
 }
@@ -462,14 +556,15 @@ void batch_render_codepoint(Font* font, const char codepoint, const Vec2& positi
     .position = dest_pos,
   };
 
-  // Prepare the texture batch
-  Batch* batch = prepare_texture_batch(glyph.texture);
+  // Prepare the batch
+  Batch* batch = prepare_batch();
   
   // Generate vertices of a quad 
   
   Material2D material = {
-    .size       = Vec2(font_size), 
-    .shape_type = (f32)SHAPE_TYPE_TEXT, 
+    .texture_handle = gfx_texture_get_bindless_id(glyph.texture),
+    .size           = Vec2(font_size), 
+    .shape_type     = (f32)SHAPE_TYPE_TEXT, 
   };
   generate_quad_batch(batch, src, dest, color, material);
 }
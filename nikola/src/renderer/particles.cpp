@@ -90,10 +90,30 @@ void particle_emitter_create(ParticleEmitter* out_emitter, const ParticleEmitter
   out_emitter->mesh_id     = desc.mesh_id; 
   out_emitter->material_id = desc.material_id;
 
+  // Hold on to the resources for as long as the emitter lives, 
+  // so they never get evicted from under it
+
+  if(RESOURCE_IS_VALID(desc.mesh_id)) {
+    resources_acquire(desc.mesh_id);
+  }
+  
+  if(RESOURCE_IS_VALID(desc.material_id)) {
+    resources_acquire(desc.material_id);
+  }
+
   // Create the timer 
   timer_create(&out_emitter->lifetime, desc.lifetime, false);
 }
 
+void particle_emitter_destroy(ParticleEmitter& emitter) {
+  resources_release(emitter.mesh_id);
+  resources_release(emitter.material_id);
+
+  emitter.mesh_id     = {};
+  emitter.material_id = {};
+  emitter.is_active   = false;
+}
+
 void particle_emitter_update(ParticleEmitter& emitter, const f64 delta_time) {
   if(!emitter.is_active) {
     return;
@@ -103,9 +123,11 @@ void particle_emitter_update(ParticleEmitter& emitter, const f64 delta_time) {
 
   for(sizei i = 0; i < emitter.particles_count; i++) {
     emitter.transforms[i].position += (emitter.velocities[i] + Vec3(0.0f, emitter.gravity_factor, 0.0f)) * (f32)delta_time; 
-    transform_translate(emitter.transforms[i], emitter.transforms[i].position);
   }
 
+  // Rebuild all of the matrices in one go
+  transform_apply_batch(emitter.transforms, emitter.particles_count);
+
   // Update the timer 
 
   timer_update(emitter.lifetime, (f32)delta_time);
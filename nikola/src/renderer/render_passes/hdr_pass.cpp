@@ -9,6 +9,16 @@
 
 namespace nikola { // Start of nikola
 
+///---------------------------------------------------------------------------------------------------------------------
+/// HDRPassState
+struct HDRPassState {
+  ShaderUniformID exposure_uniform;
+};
+
+static HDRPassState s_state;
+/// HDRPassState
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// HDR pass functions
 
@@ -28,6 +38,9 @@ void hdr_pass_init(Window* window) {
 
   ResourceID hdr_shader       = resources_push_shader(RESOURCE_CACHE_ID, generate_hdr_shader());
   pass_desc.shader_context_id = resources_push_shader_context(RESOURCE_CACHE_ID, hdr_shader);
+  
+  ShaderContext* shader_context = resources_get_shader_context(pass_desc.shader_context_id);
+  s_state.exposure_uniform      = shader_context_cache_uniform(shader_context, "u_exposure");
 
   // Other init
 
@@ -71,7 +84,7 @@ void hdr_pass_prepare(RenderPass* pass, const FrameData& data) {
   gfx_context_clear(pass->gfx, col.r, col.g, col.b, col.a);
 
   // Sending this lonely uniform to the shader
-  shader_context_set_uniform(pass->shader_context, "u_exposure", data.camera.exposure); 
+  shader_context_set_uniform(pass->shader_context, s_state.exposure_uniform, data.camera.exposure); 
 }
 
 void hdr_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
@@ -86,6 +99,7 @@ void hdr_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
     .textures_count = 1,
   };
   gfx_context_use_bindings(pass->gfx, bind_desc);
+  shader_context_flush(pass->shader_context);
 
   // Rendering the scene
  
@@ -13,6 +13,10 @@ namespace nikola { // Start of nikola
 /// LightPassState
 struct LightPassState {
   ResourceID skybox_id = {};
+
+  ShaderUniformID light_space_uniforms[SHADOW_CASCADES_MAX]; 
+  ShaderUniformID cascade_splits_uniform; 
+  ShaderUniformID cascades_count_uniform; 
 };
 
 static LightPassState s_state;
@@ -39,6 +43,15 @@ void light_pass_init(Window* window) {
   ResourceID pbr_shader       = resources_push_shader(RESOURCE_CACHE_ID, generate_pbr_shader());
   pass_desc.shader_context_id = resources_push_shader_context(RESOURCE_CACHE_ID, pbr_shader);
 
+  ShaderContext* shader_context = resources_get_shader_context(pass_desc.shader_context_id);
+  s_state.cascade_splits_uniform = shader_context_cache_uniform(shader_context, "u_cascade_splits");
+  s_state.cascades_count_uniform = shader_context_cache_uniform(shader_context, "u_cascades_count");
+
+  for(sizei i = 0; i < SHADOW_CASCADES_MAX; i++) {
+    String name = "u_light_spaces[" + std::to_string(i) + "]";
+    s_state.light_space_uniforms[i] = shader_context_cache_uniform(shader_context, name);
+  }
+
   // Frame size and flags init
 
   i32 width, height; 
@@ -98,10 +111,18 @@ void light_pass_prepare(RenderPass* pass, const FrameData& data) {
   Vec4 col = renderer_get_clear_color();
   gfx_context_clear(pass->gfx, col.r, col.g, col.b, col.a);
 
-  // Turning the light space view into a texture coordinate
+  // Send over the shadow cascades 
   
-  ShaderContext* ctx = pass->shader_context;
-  shader_context_set_uniform(pass->shader_context, "u_light_space", shadow_pass_get_light_space(pass->previous));
+  const ShadowCascades& cascades = shadow_pass_get_cascades(pass->previous);
+  Vec4 splits                    = Vec4(0.0f);
+
+  for(sizei i = 0; i < cascades.count; i++) {
+    shader_context_set_uniform(pass->shader_context, s_state.light_space_uniforms[i], cascades.light_spaces[i]);
+    splits[(i32)i] = cascades.splits[i];
+  }
+
+  shader_context_set_uniform(pass->shader_context, s_state.cascade_splits_uniform, splits);
+  shader_context_set_uniform(pass->shader_context, s_state.cascades_count_uniform, (i32)cascades.count);
 
   // Set the light uniforms
 
@@ -167,16 +188,8 @@ void light_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
   gfx_buffer_bind_point(queue.transform_buffer, SHADER_MODELS_BUFFER_INDEX);
   gfx_buffer_bind_point(queue.material_buffer, SHADER_MATERIALS_BUFFER_INDEX);
   gfx_buffer_bind_point(queue.animation_buffer, SHADER_ANIMATION_BUFFER_INDEX);
+  gfx_buffer_bind_point(queue.joint_offsets_buffer, SHADER_JOINT_OFFSETS_BUFFER_INDEX);
   
-  // Send over the animation remap table (if there are any)
-
-  if(!queue.animation_remap_table.empty()) {
-    shader_context_set_uniform_array(pass->shader_context, 
-                                     "u_animation_remap_table", 
-                                     queue.animation_remap_table.data(), 
-                                     queue.animation_remap_table.size());
-  }
-
   // Render the skybox
 
   if(RESOURCE_IS_VALID(s_state.skybox_id)) {
@@ -196,6 +209,7 @@ void light_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
     .buffers_count = 1
   };
   gfx_context_use_bindings(pass->gfx, bind_desc);
+  shader_context_flush(pass->shader_context);
 
   // Render the scene
 
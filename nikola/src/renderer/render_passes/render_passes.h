@@ -66,6 +66,26 @@ struct LightBuffer {
 /// LightBuffer
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The maximum amount of shadow cascades the light pass can sample from.
+const sizei SHADOW_CASCADES_MAX = 4;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ShadowCascades
+struct ShadowCascades {
+  Mat4 light_spaces[SHADOW_CASCADES_MAX];
+  f32 splits[SHADOW_CASCADES_MAX]; // The view-space far distance of each cascade
+
+  sizei count = 0;
+};
+/// ShadowCascades
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Shadow pass functions
 
@@ -77,7 +97,7 @@ void shadow_pass_prepare(RenderPass* pass, const FrameData& data);
 
 void shadow_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue);
 
-Mat4 shadow_pass_get_light_space(RenderPass* pass);
+const ShadowCascades& shadow_pass_get_cascades(RenderPass* pass);
 
 /// Shadow pass functions
 ///---------------------------------------------------------------------------------------------------------------------
@@ -10,22 +10,192 @@
 
 namespace nikola { // Start of nikola
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The amount of cascades the view frustum gets split into.
+const sizei SHADOW_CASCADES_COUNT = 3;
+
+/// The furthest distance (from the camera) that can receive shadows.
+const f32 SHADOW_DISTANCE_MAX = 100.0f;
+
+/// How much the split distances lean towards a logarithmic distribution,
+/// with `0.0f` being fully linear and `1.0f` being fully logarithmic.
+const f32 SHADOW_SPLIT_LAMBDA = 0.75f;
+
+/// The extra distance (towards the light) each cascade takes into
+/// account, so that casters outside of the frustum still cast shadows into it.
+const f32 SHADOW_CASTER_MARGIN = 50.0f;
+
+/// The maximum amount of commands each cascade can issue.
+const sizei SHADOW_COMMANDS_MAX = KiB(256) / sizeof(GfxDrawCommandIndirect);
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShadowPassState
 struct ShadowPassState {
-  Mat4 light_view, light_projection;
-  Mat4 light_view_proj;
+  ShadowCascades cascades;
+  Mat4 light_views[SHADOW_CASCADES_MAX];
+  f32 cascade_radii[SHADOW_CASCADES_MAX];
+
+  DynamicArray<GfxDrawCommandIndirect> commands;
+  sizei commands_offsets[SHADOW_CASCADES_MAX];
+  sizei commands_counts[SHADOW_CASCADES_MAX];
+
+  GfxBuffer* command_buffer = nullptr;
+
+  ShaderUniformID light_space_uniform;
 };
 
 static ShadowPassState s_state;
 /// ShadowPassState
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static void calculate_splits(const Camera& camera) {
+  // @NOTE: The "practical" split scheme blends a logarithmic distribution
+  // (even texel density, but tiny near cascades) with a linear one (wasteful far away).
+
+  f32 near = camera.near;
+  f32 far  = min_float(camera.far, SHADOW_DISTANCE_MAX);
+
+  for(sizei i = 0; i < s_state.cascades.count; i++) {
+    f32 ratio = (f32)(i + 1) / (f32)s_state.cascades.count;
+
+    f32 log_split    = near * nikola::pow(far / near, ratio);
+    f32 linear_split = near + (far - near) * ratio;
+
+    s_state.cascades.splits[i] = lerp(linear_split, log_split, SHADOW_SPLIT_LAMBDA);
+  }
+}
+
+static void calculate_cascade(const Camera& camera, const Vec3& light_dir, const f32 texture_size, const sizei index) {
+  f32 split_near = (index == 0) ? camera.near : s_state.cascades.splits[index - 1];
+  f32 split_far  = s_state.cascades.splits[index];
+
+  // Get the corners of the slice of the frustum
+
+  f32 tan_y = nikola::tan(TO_RADIANS(camera.zoom) * 0.5f);
+  f32 tan_x = tan_y * camera.aspect_ratio;
+
+  Vec3 right = vec3_normalize(vec3_cross(camera.front, camera.up));
+  Vec3 up    = vec3_normalize(vec3_cross(right, camera.front));
+
+  Vec3 corners[8];
+  f32 distances[2] = {split_near, split_far};
+
+  for(sizei i = 0; i < 2; i++) {
+    Vec3 center = camera.position + (camera.front * distances[i]);
+    Vec3 top    = up * (tan_y * distances[i]);
+    Vec3 side   = right * (tan_x * distances[i]);
+
+    corners[i * 4 + 0] = center - top - side;
+    corners[i * 4 + 1] = center + top - side;
+    corners[i * 4 + 2] = center + top + side;
+    corners[i * 4 + 3] = center - top + side;
+  }
+
+  // Fit a bounding sphere around the slice.
+  //
+  // @NOTE: A sphere (unlike a box) does not change its size when the camera
+  // rotates, which keeps the texel size of the cascade constant.
+
+  Vec3 center = Vec3(0.0f);
+  for(sizei i = 0; i < 8; i++) {
+    center += corners[i];
+  }
+  center /= 8.0f;
+
+  f32 radius = 0.0f;
+  for(sizei i = 0; i < 8; i++) {
+    radius = max_float(radius, vec3_distance(center, corners[i]));
+  }
+  radius = (f32)nikola::floor(radius * 16.0f + 1.0f) / 16.0f;
+
+  // Calculate the light's matrices
+
+  Vec3 dir      = vec3_normalize(light_dir);
+  Vec3 world_up = (nikola::abs(dir.y) > 0.99f) ? Vec3(0.0f, 0.0f, 1.0f) : Vec3(0.0f, 1.0f, 0.0f);
+
+  Vec3 eye        = center - (dir * (radius + SHADOW_CASTER_MARGIN));
+  Mat4 light_view = mat4_look_at(eye, center, world_up);
+  Mat4 light_proj = mat4_ortho(-radius, radius, -radius, radius, 0.0f, (radius * 2.0f) + SHADOW_CASTER_MARGIN);
+
+  // Snap the projection to the texel grid to stop the shadows from
+  // shimmering whenever the camera moves.
+
+  Vec4 origin  = (light_proj * light_view) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+  Vec2 texel   = Vec2(origin.x, origin.y) * (texture_size * 0.5f);
+  Vec2 rounded = Vec2((f32)nikola::floor(texel.x + 0.5f), (f32)nikola::floor(texel.y + 0.5f));
+  Vec2 offset  = (rounded - texel) * (2.0f / texture_size);
+
+  light_proj[3][0] += offset.x;
+  light_proj[3][1] += offset.y;
+
+  s_state.light_views[index]           = light_view;
+  s_state.cascade_radii[index]         = radius;
+  s_state.cascades.light_spaces[index] = (light_proj * light_view);
+}
+
+static bool is_caster_visible(const Vec4& bounds, const sizei cascade) {
+  Vec3 center = Vec3(s_state.light_views[cascade] * Vec4(Vec3(bounds), 1.0f));
+  f32 radius  = s_state.cascade_radii[cascade];
+  f32 far     = (radius * 2.0f) + SHADOW_CASTER_MARGIN;
+
+  // @NOTE: The light's view looks down the negative Z axis
+
+  return (nikola::abs(center.x) - bounds.w) <= radius &&
+         (nikola::abs(center.y) - bounds.w) <= radius &&
+         (-center.z + bounds.w) >= 0.0f &&
+         (-center.z - bounds.w) <= far;
+}
+
+static void cull_casters(const RenderQueueEntry& queue, const sizei cascade) {
+  s_state.commands_offsets[cascade] = s_state.commands.size();
+  s_state.commands_counts[cascade]  = 0;
+
+  // Every command gets split into runs of visible instances,
+  // since instances are laid out contiguously in the transforms buffer.
+
+  for(auto& cmd : queue.commands) {
+    u32 run_start = cmd.base_instance;
+    u32 run_count = 0;
+
+    for(u32 i = cmd.base_instance; i <= (cmd.base_instance + cmd.instance_count); i++) {
+      bool is_last = (i == (cmd.base_instance + cmd.instance_count));
+
+      if(!is_last && is_caster_visible(queue.bounds[i], cascade)) {
+        run_count++;
+        continue;
+      }
+
+      if(run_count > 0 && s_state.commands_counts[cascade] < SHADOW_COMMANDS_MAX) {
+        GfxDrawCommandIndirect run_cmd = cmd;
+        run_cmd.base_instance          = run_start;
+        run_cmd.instance_count         = run_count;
+
+        s_state.commands.push_back(run_cmd);
+        s_state.commands_counts[cascade]++;
+      }
+
+      run_start = i + 1;
+      run_count = 0;
+    }
+  }
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// Shadow pass functions
 
 void shadow_pass_init(Window* window) {
-  RenderPassDesc pass_desc = {}; 
+  RenderPassDesc pass_desc = {};
 
   // Callbacks init
 
@@ -36,36 +206,53 @@ void shadow_pass_init(Window* window) {
   // Reosurce init
 
   pass_desc.res_group_id      = RESOURCE_CACHE_ID;
-  pass_desc.shader_context_id = resources_push_shader_context(RESOURCE_CACHE_ID,  
+  pass_desc.shader_context_id = resources_push_shader_context(RESOURCE_CACHE_ID,
                                                               resources_push_shader(RESOURCE_CACHE_ID, generate_shadow_shader()));
-  
+
+  ShaderContext* shader_context = resources_get_shader_context(pass_desc.shader_context_id);
+  s_state.light_space_uniform   = shader_context_cache_uniform(shader_context, "u_light_space");
+
+  s_state.cascades.count = SHADOW_CASCADES_COUNT;
+
   // Other init
 
-  i32 width, height; 
+  i32 width, height;
   window_get_size(window, &width, &height);
 
-  pass_desc.frame_size  = IVec2(1280, 1280);
-  pass_desc.clear_flags = (GFX_CLEAR_FLAGS_DEPTH_BUFFER); 
+  pass_desc.frame_size  = IVec2(2048, 2048);
+  pass_desc.clear_flags = (GFX_CLEAR_FLAGS_DEPTH_BUFFER);
   pass_desc.queue_type  = RENDER_QUEUE_OPAQUE;
 
-  // Depth buffer init
+  // Depth buffer init (a layer for each cascade)
 
   GfxTextureDesc target_desc = {
     .width  = (u32)pass_desc.frame_size.x,
     .height = (u32)pass_desc.frame_size.x,
+    .depth  = (u32)SHADOW_CASCADES_COUNT,
 
-    .type         = GFX_TEXTURE_2D, 
-    .format       = GFX_TEXTURE_FORMAT_DEPTH16, 
+    .type         = GFX_TEXTURE_2D_ARRAY,
+    .format       = GFX_TEXTURE_FORMAT_DEPTH24,
     .filter       = GFX_TEXTURE_FILTER_MIN_MAG_LINEAR,
     .wrap_mode    = GFX_TEXTURE_WRAP_CLAMP,
-    .compare_func = GFX_COMPARE_LESS_EQUAL, 
+    .compare_func = GFX_COMPARE_LESS_EQUAL,
 
     .is_bindless = false,
   };
   pass_desc.targets.push_back(target_desc);
-  
+
+  // Command buffer init
+
+  GfxBufferDesc buff_desc = {
+    .data  = nullptr,
+    .size  = SHADOW_COMMANDS_MAX * SHADOW_CASCADES_COUNT * sizeof(GfxDrawCommandIndirect),
+    .type  = GFX_BUFFER_DRAW_INDIRECT,
+    .usage = GFX_BUFFER_USAGE_STREAM,
+  };
+  s_state.command_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+  s_state.commands.reserve(128);
+
   // Render pass init
-  
+
   RenderPass* shadow_pass = renderer_create_pass(pass_desc, "Shadow pass");
   renderer_append_pass(shadow_pass);
 }
@@ -76,83 +263,75 @@ void shadow_pass_destroy(RenderPass* pass) {
 
 void shadow_pass_prepare(RenderPass* pass, const FrameData& data) {
   NIKOLA_PROFILE_FUNCTION();
-  
-  // Prepare the context for rendering 
 
+  // Prepare the context for rendering
   gfx_context_set_viewport(pass->gfx, 0, 0, pass->frame_size.x, pass->frame_size.y);
 
-  Vec4 col = renderer_get_clear_color();
-  gfx_context_clear(pass->gfx, col.r, col.g, col.b, col.a);
-
-  //
-  // Setup the light projection matrix
-  //
-
-  // Get the center of the frustrum by averaging the 
-  // frustrum's corners.
-
-  Vec3 center = Vec3(0.0f);
-  for(sizei i = 0; i < 8; i++) {
-    center += data.camera.corners[i]; 
-  }
-  center /= 8.0f;
-
-  // Calculate the light's view matrix for use later 
-  s_state.light_view = mat4_look_at(center + -data.dir_light.direction, center, Vec3(0.0f, 1.0f, 0.0f));
+  // Setup the light projection matrix of each cascade
 
-  // Calculate the extents of the frustrum
-
-  Vec3 min = Vec3(FLOAT_MAX);
-  Vec3 max = Vec3(FLOAT_MIN);
-
-  for(sizei i = 0; i < 8; i++) {
-    Vec3 center_light_space = Vec3(s_state.light_view * Vec4(data.camera.corners[i], 1.0f));
+  calculate_splits(data.camera);
 
-    min = vec3_min(min, center_light_space);
-    max = vec3_max(max, center_light_space);
+  for(sizei i = 0; i < s_state.cascades.count; i++) {
+    calculate_cascade(data.camera, data.dir_light.direction, (f32)pass->frame_size.x, i);
   }
-
-  // Calculate the projection and view matrices and 
-  // send the final result to the shader.
-
-  s_state.light_projection = mat4_ortho(min.x, max.x, min.y, max.y, min.z, max.z);
-  s_state.light_view_proj  = (s_state.light_projection * s_state.light_view);
-
-  shader_context_set_uniform(pass->shader_context, "u_light_space", s_state.light_view_proj);
 }
 
 void shadow_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
   NIKOLA_PROFILE_FUNCTION();
 
   // Buffer bind points
-  
+
   gfx_buffer_bind_point(queue.transform_buffer, SHADER_MODELS_BUFFER_INDEX);
   gfx_buffer_bind_point(queue.animation_buffer, SHADER_ANIMATION_BUFFER_INDEX);
-  
-  // Send over the animation remap table (if there are any)
-
-  if(!queue.animation_remap_table.empty()) {
-    shader_context_set_uniform_array(pass->shader_context, 
-                                     "u_animation_remap_table", 
-                                     queue.animation_remap_table.data(), 
-                                     queue.animation_remap_table.size());
+  gfx_buffer_bind_point(queue.joint_offsets_buffer, SHADER_JOINT_OFFSETS_BUFFER_INDEX);
+
+  // Cull the casters of each cascade and upload the surviving commands all at once
+
+  s_state.commands.clear();
+  for(sizei i = 0; i < s_state.cascades.count; i++) {
+    cull_casters(queue, i);
+  }
+
+  // Every caster might have been culled
+
+  if(!s_state.commands.empty()) {
+    gfx_buffer_upload_data(s_state.command_buffer,
+                           0,
+                           s_state.commands.size() * sizeof(GfxDrawCommandIndirect),
+                           s_state.commands.data());
   }
 
   // Use the required resources
 
-  GfxBuffer* command_buff  = queue.command_buffer;
+  GfxBuffer* command_buff  = s_state.command_buffer;
   GfxBindingDesc bind_desc = {
     .shader = pass->shader_context->shader,
 
-    .buffers       = &command_buff, 
+    .buffers       = &command_buff,
     .buffers_count = 1
   };
   gfx_context_use_bindings(pass->gfx, bind_desc);
-
-  // Render the scene
-  
   gfx_context_use_pipeline(pass->gfx, queue.pipe);
-  gfx_context_draw_multi_indirect(pass->gfx, 0, queue.commands.size());
+
+  // Render the scene into each cascade
+
+  Vec4 col = renderer_get_clear_color();
+
+  for(sizei i = 0; i < s_state.cascades.count; i++) {
+    gfx_framebuffer_set_layer(pass->framebuffer, (u32)i);
+    gfx_context_clear(pass->gfx, col.r, col.g, col.b, col.a);
+
+    if(s_state.commands_counts[i] == 0) {
+      continue;
+    }
+
+    shader_context_set_uniform(pass->shader_context, s_state.light_space_uniform, s_state.cascades.light_spaces[i]);
+    shader_context_flush(pass->shader_context);
+
+    gfx_context_draw_multi_indirect(pass->gfx,
+                                    (u32)(s_state.commands_offsets[i] * sizeof(GfxDrawCommandIndirect)),
+                                    s_state.commands_counts[i]);
+  }
 
   // Setting the output textures
 
@@ -160,8 +339,8 @@ void shadow_pass_sumbit(RenderPass* pass, const RenderQueueEntry& queue) {
   pass->outputs_count = 1;
 }
 
-Mat4 shadow_pass_get_light_space(RenderPass* pass) {
-  return s_state.light_view_proj;
+const ShadowCascades& shadow_pass_get_cascades(RenderPass* pass) {
+  return s_state.cascades;
 }
 
 /// Shadow pass functions
@@ -170,4 +349,3 @@ Mat4 shadow_pass_get_light_space(RenderPass* pass) {
 } // End of nikola
 
 //////////////////////////////////////////////////////////////////////////
-
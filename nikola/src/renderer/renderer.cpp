@@ -21,6 +21,7 @@ namespace nikola { // Start of nikola
 const sizei TRANSFORMS_BUFFER_SIZE = MiB(1);
 const sizei MATERIALS_BUFFER_SIZE  = MiB(1);
 const sizei ANIMATIONS_BUFFER_SIZE = MiB(1);
+const sizei OFFSETS_BUFFER_SIZE    = KiB(64);
 const sizei COMMANDS_BUFFER_SIZE   = KiB(256);
 
 const sizei VERTICES_BUFFER_SIZE   = MiB(64);
@@ -38,6 +39,68 @@ struct MatrixUniformBuffer {
 /// MatrixUniformBuffer
 /// ----------------------------------------------------------------------
 
+/// ----------------------------------------------------------------------
+/// RenderDraw
+struct RenderDraw {
+  u64 sort_key; 
+
+  Mesh* mesh         = nullptr;
+  Material* material = nullptr;
+  
+  // The material is captured at the time of the submission, since 
+  // models can "influence" their materials between submissions.
+  MaterialInterface material_interface;
+
+  u32 first_transform  = 0;
+  u32 transforms_count = 0;
+};
+/// RenderDraw
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// RenderSortKey
+struct RenderSortKey {
+  u64 key; 
+  u32 draw_index;
+};
+/// RenderSortKey
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// MeshRange
+struct MeshRange {
+  u32 first_element; 
+  i32 base_vertex;
+
+  Vec4 bounds; // Local bounding sphere
+};
+/// MeshRange
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// RenderQueueStaging
+
+// @NOTE: The draws are not written into the `RenderQueueEntry` directly. 
+// They are staged here first, and then sorted and merged at the end of 
+// the frame (see `render_queue_build`).
+
+struct RenderQueueStaging {
+  DynamicArray<RenderDraw> draws;
+  DynamicArray<Mat4> transforms;
+  DynamicArray<i32> joint_offsets; // Parallel to `transforms`
+  
+  DynamicArray<RenderSortKey> keys; 
+  DynamicArray<RenderSortKey> scratch_keys;
+
+  HashMap<const void*, u16> sort_ids;
+  HashMap<const Mesh*, MeshRange> mesh_ranges;
+  HashMap<const void*, i32> palette_offsets;
+
+  bool has_animations = false;
+};
+/// RenderQueueStaging
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Renderer
 struct Renderer {
@@ -69,6 +132,9 @@ struct Renderer {
   RenderPass* tail_pass = nullptr;
 
   RenderQueueEntry queues[RENDER_QUEUES_MAX];
+  RenderQueueStaging stagings[RENDER_QUEUES_MAX];
+
+  DynamicArray<i32> joint_offsets_scratch;
 };
 
 static Renderer s_renderer{};
@@ -102,7 +168,7 @@ static void init_defaults() {
     .data  = nullptr, 
     .size  = sizeof(MatrixUniformBuffer),
     .type  = GFX_BUFFER_UNIFORM,
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
 
   s_renderer.defaults.matrices_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
@@ -160,7 +226,7 @@ static void init_defaults() {
     .data  = nullptr,
     .size  = sizeof(LightBuffer),
     .type  = GFX_BUFFER_SHADER_STORAGE, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
   s_renderer.defaults.lights_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
 
@@ -261,7 +327,7 @@ static void render_queue_create(const RenderQueueType type) {
     .data  = nullptr,
     .size  = TRANSFORMS_BUFFER_SIZE,
     .type  = GFX_BUFFER_SHADER_STORAGE, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
   queue->transform_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
 
@@ -269,7 +335,7 @@ static void render_queue_create(const RenderQueueType type) {
     .data  = nullptr,
     .size  = MATERIALS_BUFFER_SIZE,
     .type  = GFX_BUFFER_SHADER_STORAGE, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
   queue->material_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
   
@@ -278,16 +344,24 @@ static void render_queue_create(const RenderQueueType type) {
       .data  = nullptr,
       .size  = ANIMATIONS_BUFFER_SIZE,
       .type  = GFX_BUFFER_SHADER_STORAGE, 
-      .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+      .usage = GFX_BUFFER_USAGE_STREAM,
     };
     queue->animation_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
+    
+    buff_desc = {
+      .data  = nullptr,
+      .size  = OFFSETS_BUFFER_SIZE,
+      .type  = GFX_BUFFER_SHADER_STORAGE, 
+      .usage = GFX_BUFFER_USAGE_STREAM,
+    };
+    queue->joint_offsets_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
   }
 
   buff_desc = {
     .data  = nullptr,
     .size  = COMMANDS_BUFFER_SIZE,
     .type  = GFX_BUFFER_DRAW_INDIRECT, 
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
+    .usage = GFX_BUFFER_USAGE_STREAM,
   };
   queue->command_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
   
@@ -333,33 +407,8 @@ static void render_queue_create(const RenderQueueType type) {
   queue->pipe = gfx_pipeline_create(s_renderer.context, queue->pipe_desc);
 }
 
-static void render_queue_push(const RenderQueueType type, Mesh* mesh, const Transform& transform, Material* material) {
-  RenderQueueEntry* entry = &s_renderer.queues[type];
-  
-  // 
-  // @TODO (Renderer): Implement frustum culling test here..
-  //
-
-  // Command
-
-  GfxDrawCommandIndirect cmd = {
-    .elements_count = (u32)mesh->indices.size(),
-
-    .first_element  = (u32)entry->indices.size(),
-    .base_vertex    = (i32)(entry->vertices.size() / vertex_get_components_count(entry->vertex_flags)),
-    .base_instance  = (u32)entry->transforms.size(),
-  };
-  entry->commands.push_back(cmd);
- 
-  // Vertices, indices, and transforms
-
-  entry->vertices.insert(entry->vertices.end(), mesh->vertices.begin(), mesh->vertices.end());
-  entry->indices.insert(entry->indices.end(), mesh->indices.begin(), mesh->indices.end());
-  entry->transforms.push_back(transform.transform);
-
-  // Material
-
-  MaterialInterface interface = {
+static MaterialInterface get_material_interface(const Material* material) {
+  return MaterialInterface {
     .albedo_handle    = gfx_texture_get_bindless_id(material->albedo_map),
     .metallic_handle  = gfx_texture_get_bindless_id(material->metallic_map),
     .roughness_handle = gfx_texture_get_bindless_id(material->roughness_map),
@@ -372,55 +421,304 @@ static void render_queue_push(const RenderQueueType type, Mesh* mesh, const Tran
     .transparency = material->transparency,
     .color        = material->color, 
   };
+}
+
+static u64 get_sort_id(RenderQueueStaging* staging, const void* ptr) {
+  // Pointers are too wide to fit in a key, so each unique 
+  // mesh and material is given a small ID for this frame instead
 
-  entry->materials.push_back(interface); 
+  auto it = staging->sort_ids.find(ptr);
+  if(it != staging->sort_ids.end()) {
+    return it->second;
+  }
+
+  u16 id                  = (u16)staging->sort_ids.size();
+  staging->sort_ids[ptr] = id;
+
+  return id;
 }
 
-static void render_queue_push_instanced(const RenderQueueType type, 
-                                        Mesh* mesh, 
-                                        Material* material,
-                                        const Transform* transforms, 
-                                        const sizei count) {
-  RenderQueueEntry* entry = &s_renderer.queues[type];
+static u64 get_depth_bits(const f32 distance) {
+  // Positive floats keep their order when compared as integers. 
+  // Only the top 24 bits are needed to get a good enough order.
+  
+  u32 bits = 0; 
+  memory_copy(&bits, &distance, sizeof(f32));
+
+  return (bits >> 8) & 0xffffff;
+}
+
+static u64 get_sort_key(RenderQueueStaging* staging, const RenderDraw& draw, const Vec3& position) {
+  // The key layout (from the most significant bit):
+  //
+  // Opaque      = [0][material: 16][mesh: 16][depth: 24][unused: 7]
+  // Transparent = [1][inverse depth: 24][material: 16][mesh: 16][unused: 7]
+  //
+  // Opaque draws are grouped by their state first and then rendered front-to-back, 
+  // while transparent draws must always be rendered back-to-front. 
+  // 
+  // @NOTE: Every queue has exactly one pipeline, so the pipeline is implied by the queue itself.
 
-  // Command
+  u64 material_id = get_sort_id(staging, draw.material);
+  u64 mesh_id     = get_sort_id(staging, draw.mesh);
+  u64 depth       = get_depth_bits(vec3_distance(s_renderer.frame_data->camera.position, position));
 
-  GfxDrawCommandIndirect cmd = {
-    .elements_count = (u32)mesh->indices.size(),
-    .instance_count = (u32)count, 
+  if(draw.material_interface.transparency >= 1.0f) {
+    return (material_id << 47) | (mesh_id << 31) | (depth << 7);
+  }
+  
+  u64 inverse_depth = 0xffffff - depth;
+  return (1ull << 63) | (inverse_depth << 39) | (material_id << 23) | (mesh_id << 7);
+}
+
+static void radix_sort_keys(DynamicArray<RenderSortKey>& keys, DynamicArray<RenderSortKey>& scratch) {
+  scratch.resize(keys.size());
+
+  RenderSortKey* src = keys.data(); 
+  RenderSortKey* dst = scratch.data();
+
+  // Sort 8 bits at a time, starting from the least significant byte
+
+  for(u32 shift = 0; shift < 64; shift += 8) {
+    sizei offsets[256] = {};
+
+    for(sizei i = 0; i < keys.size(); i++) {
+      offsets[(src[i].key >> shift) & 0xff]++;
+    }
+
+    // All the keys share the same byte, so this pass would change nothing
+
+    if(offsets[(src[0].key >> shift) & 0xff] == keys.size()) {
+      continue;
+    }
+
+    sizei total = 0; 
+    for(sizei i = 0; i < 256; i++) {
+      sizei count = offsets[i];
+      offsets[i]  = total; 
+      total      += count;
+    }
+
+    for(sizei i = 0; i < keys.size(); i++) {
+      dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+    }
+
+    RenderSortKey* temp = src;
+    src                 = dst; 
+    dst                 = temp;
+  }
+
+  // Make sure the result ends up in `keys`
+  
+  if(src != keys.data()) {
+    memory_copy(keys.data(), src, sizeof(RenderSortKey) * keys.size());
+  }
+}
+
+static bool can_merge_draws(const RenderDraw& prev, const RenderDraw& draw) {
+  return (prev.mesh == draw.mesh) && 
+         (prev.material == draw.material) &&
+         (prev.material_interface.transparency == draw.material_interface.transparency);
+}
+
+static Vec4 get_world_bounds(const Vec4& local_bounds, const Mat4& transform) {
+  Vec3 center = Vec3(transform * Vec4(Vec3(local_bounds), 1.0f));
+
+  // The radius grows with the biggest scale axis of the transform
+
+  f32 scale_sq = max_float(vec3_dot(Vec3(transform[0]), Vec3(transform[0])), 
+                           max_float(vec3_dot(Vec3(transform[1]), Vec3(transform[1])), 
+                                     vec3_dot(Vec3(transform[2]), Vec3(transform[2]))));
 
-    .first_element  = (u32)entry->indices.size(),
-    .base_vertex    = (i32)(entry->vertices.size() / vertex_get_components_count(entry->vertex_flags)),
-    .base_instance  = (u32)entry->transforms.size(),
+  return Vec4(center, local_bounds.w * (f32)nikola::sqrt(scale_sq));
+}
+
+static MeshRange get_mesh_range(RenderQueueEntry* entry, RenderQueueStaging* staging, const Mesh* mesh) {
+  // Every mesh is only uploaded once per frame, no matter how many draws reference it
+
+  auto it = staging->mesh_ranges.find(mesh);
+  if(it != staging->mesh_ranges.end()) {
+    return it->second;
+  }
+
+  sizei stride = vertex_get_components_count(entry->vertex_flags);
+
+  MeshRange range = {
+    .first_element = (u32)entry->indices.size(),
+    .base_vertex   = (i32)(entry->vertices.size() / stride),
+    .bounds        = mesh->bounds,
   };
-  entry->commands.push_back(cmd);
- 
-  // Vertices, indices, and transforms
 
   entry->vertices.insert(entry->vertices.end(), mesh->vertices.begin(), mesh->vertices.end());
   entry->indices.insert(entry->indices.end(), mesh->indices.begin(), mesh->indices.end());
 
+  staging->mesh_ranges[mesh] = range;
+  return range;
+}
+
+static void render_queue_push(const RenderQueueType type, 
+                              Mesh* mesh, 
+                              Material* material,
+                              const Transform* transforms, 
+                              const sizei count, 
+                              const i32* joint_offsets = nullptr) {
+  RenderQueueStaging* staging = &s_renderer.stagings[type];
+  
+  // @NOTE: Stale resources (evicted or cleared) come back as `nullptr`. 
+  // There is nothing to draw with them.
+
+  if(count == 0 || !mesh || !material) {
+    return;
+  }
+  
+  // 
+  // @TODO (Renderer): Implement frustum culling test here..
+  //
+
+  RenderDraw draw = {
+    .mesh               = mesh, 
+    .material           = material, 
+    .material_interface = get_material_interface(material),
+    
+    .first_transform  = (u32)staging->transforms.size(),
+    .transforms_count = (u32)count,
+  };
+  draw.sort_key = get_sort_key(staging, draw, transforms[0].position);
+
   for(sizei i = 0; i < count; i++) {
-    entry->transforms.emplace_back(transforms[i].transform);
+    staging->transforms.push_back(transforms[i].transform);
+    staging->joint_offsets.push_back(joint_offsets ? joint_offsets[i] : 0);
   }
 
-  // Material
+  staging->has_animations |= (joint_offsets != nullptr);
+  staging->draws.push_back(draw);
+}
 
-  MaterialInterface interface = {
-    .albedo_handle    = gfx_texture_get_bindless_id(material->albedo_map),
-    .metallic_handle  = gfx_texture_get_bindless_id(material->metallic_map),
-    .roughness_handle = gfx_texture_get_bindless_id(material->roughness_map),
-    .normal_handle    = gfx_texture_get_bindless_id(material->normal_map),
-    .emissive_handle  = gfx_texture_get_bindless_id(material->emissive_map),
+static void render_queue_push_model(const RenderQueueType type, 
+                                    Model* model, 
+                                    Material* material,
+                                    const Transform* transforms, 
+                                    const sizei count, 
+                                    const i32* joint_offsets = nullptr) {
+  if(!model || !material) {
+    return;
+  }
 
-    .metallic     = material->metallic,
-    .roughness    = material->roughness, 
-    .emissive     = material->emissive,
-    .transparency = material->transparency,
-    .color        = material->color, 
-  };
+  for(sizei i = 0; i < model->meshes.size(); i++) {
+    Mesh* mesh    = model->meshes[i];
+    Material* mat = model->materials[mesh->material_index]; 
+    
+    // Let the main given material "influence" the model's material 
+    
+    mat->transparency = material->transparency;
+    mat->depth_mask   = material->depth_mask;
+
+    render_queue_push(type, mesh, mat, transforms, count, joint_offsets); 
+  }  
+}
+
+static i32 push_skinning_palette(const void* owner, const Array<Mat4, JOINTS_MAX>& palette, const sizei joints_count) {
+  RenderQueueEntry* entry     = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
+  RenderQueueStaging* staging = &s_renderer.stagings[RENDER_QUEUE_OPAQUE];
+
+  // Samplers (or blenders) shared between many instances only get written once per frame
+
+  auto it = staging->palette_offsets.find(owner);
+  if(it != staging->palette_offsets.end()) {
+    return it->second;
+  }
+
+  // Only the joints the skeleton actually has make it into the buffer
 
-  entry->materials.push_back(interface); 
+  i32 offset = (i32)entry->joints.size();
+  entry->joints.insert(entry->joints.end(), palette.begin(), palette.begin() + joints_count);
+
+  staging->palette_offsets[owner] = offset;
+  return offset;
+}
+
+static void render_queue_build(const RenderQueueType type) {
+  RenderQueueEntry* entry     = &s_renderer.queues[type];
+  RenderQueueStaging* staging = &s_renderer.stagings[type];
+
+  if(staging->draws.empty()) {
+    return;
+  }
+
+  // Sort the draws
+
+  staging->keys.resize(staging->draws.size());
+  for(sizei i = 0; i < staging->draws.size(); i++) {
+    staging->keys[i] = RenderSortKey{staging->draws[i].sort_key, (u32)i};
+  }
+
+  radix_sort_keys(staging->keys, staging->scratch_keys);
+
+  // Merge identical draws into instanced commands with contiguous transforms
+
+  const RenderDraw* prev_draw = nullptr;
+  for(auto& key : staging->keys) {
+    const RenderDraw& draw = staging->draws[key.draw_index];
+
+    MeshRange range = get_mesh_range(entry, staging, draw.mesh);
+    
+    if(!prev_draw || !can_merge_draws(*prev_draw, draw)) {
+
+      GfxDrawCommandIndirect cmd = {
+        .elements_count = (u32)draw.mesh->indices.size(),
+        .instance_count = 0,
+
+        .first_element  = range.first_element,
+        .base_vertex    = range.base_vertex,
+        .base_instance  = (u32)entry->transforms.size(),
+      };
+
+      entry->commands.push_back(cmd);
+      entry->materials.push_back(draw.material_interface);
+    }
+
+    // Transforms
+
+    const Mat4* transforms = &staging->transforms[draw.first_transform];
+    entry->transforms.insert(entry->transforms.end(), transforms, transforms + draw.transforms_count);
+
+    for(u32 i = 0; i < draw.transforms_count; i++) {
+      entry->bounds.push_back(get_world_bounds(range.bounds, transforms[i]));
+    }
+    
+    entry->commands.back().instance_count += draw.transforms_count;
+
+    // Each transform points to the start of its own skinning palette (if it has one)
+
+    if(staging->has_animations) {
+      const i32* offsets = &staging->joint_offsets[draw.first_transform];
+      entry->joint_offsets.insert(entry->joint_offsets.end(), offsets, offsets + draw.transforms_count);
+    }
+
+    prev_draw = &draw;
+  }
+}
+
+static void render_queue_clear(const RenderQueueType type) {
+  RenderQueueEntry* entry     = &s_renderer.queues[type];
+  RenderQueueStaging* staging = &s_renderer.stagings[type];
+
+  entry->vertices.clear();
+  entry->indices.clear();
+  entry->transforms.clear();
+  entry->bounds.clear();
+  entry->materials.clear();
+  entry->joints.clear();
+  entry->joint_offsets.clear();
+  entry->commands.clear();
+
+  staging->draws.clear();
+  staging->transforms.clear();
+  staging->joint_offsets.clear();
+  staging->sort_ids.clear();
+  staging->mesh_ranges.clear();
+  staging->palette_offsets.clear();
+  staging->has_animations = false;
 }
 
 /// Private functions
@@ -507,6 +805,8 @@ void renderer_shutdown() {
     if(pass->destroy_func) {
       pass->destroy_func(pass);
     }
+
+    gfx_query_destroy(pass->gpu_timer);
   }
  
   // Destroy the queues
@@ -542,15 +842,7 @@ void renderer_begin(FrameData& data) {
   // Clear the data from the previous frame
 
   for(sizei i = 0; i < RENDER_QUEUES_MAX; i++) {
-    RenderQueueEntry* entry = &s_renderer.queues[i];
-
-    entry->vertices.clear();
-    entry->indices.clear();
-    entry->transforms.clear();
-    entry->materials.clear();
-    entry->animations.clear();
-    entry->animation_remap_table.clear();
-    entry->commands.clear();
+    render_queue_clear((RenderQueueType)i);
   }
 }
 
@@ -560,6 +852,9 @@ void renderer_end() {
   // Update the buffers of each queue
 
   for(sizei i = 0; i < RENDER_QUEUES_MAX; i++) {
+    // Sort and merge the draws of the frame first
+    render_queue_build((RenderQueueType)i);
+
     // Update buffers if there is data
  
     RenderQueueEntry* queue = &s_renderer.queues[i];
@@ -598,10 +893,19 @@ void renderer_end() {
     // Update the animation buffer (just for the opaque queue)
 
     if(queue->animation_buffer) {
-      gfx_buffer_upload_data(queue->animation_buffer,
+      // No animated meshes were submitted this frame
+      
+      if(!queue->joints.empty()) {
+        gfx_buffer_upload_data(queue->animation_buffer,
+                               0,
+                               queue->joints.size() * sizeof(Mat4), 
+                               queue->joints.data());
+      }
+      
+      gfx_buffer_upload_data(queue->joint_offsets_buffer,
                              0,
-                             queue->animations.size() * (sizeof(Mat4) * JOINTS_MAX), 
-                             queue->animations.data());
+                             queue->joint_offsets.size() * sizeof(i32), 
+                             queue->joint_offsets.data());
     }
 
     // Update the command buffer
@@ -621,11 +925,14 @@ void renderer_end() {
 
     // Initiating the render pass callbacks
 
+    gfx_query_begin(current->gpu_timer);
+
     if(current->prepare_func) {
       current->prepare_func(current, *s_renderer.frame_data);
     }
 
     current->sumbit_func(current, s_renderer.queues[current->queue_type]);
+    gfx_query_end(current->gpu_timer);
     
     // Advance to the next pass if it exists
     
@@ -697,6 +1004,7 @@ RenderPass* renderer_create_pass(const RenderPassDesc& desc, const String& debug
   pass->queue_type   = desc.queue_type;
   pass->debug_name   = debug_name;
   pass->frame_size   = desc.frame_size;
+  pass->gpu_timer    = gfx_query_create(pass->gfx, GFX_QUERY_TIME_ELAPSED);
 
   // Retrieve the context
   pass->shader_context = resources_get_shader_context(desc.shader_context_id);
@@ -865,7 +1173,7 @@ void renderer_queue_mesh_instanced(const ResourceID& res_id,
   }
 
   // Issuing the draw command 
-  render_queue_push_instanced(RENDER_QUEUE_OPAQUE, mesh, material, transforms, count); 
+  render_queue_push(RENDER_QUEUE_OPAQUE, mesh, material, transforms, count); 
 }
 
 void renderer_queue_model_instanced(const ResourceID& res_id, 
@@ -882,18 +1190,7 @@ void renderer_queue_model_instanced(const ResourceID& res_id,
   }
  
   // Issuing the draw command 
-  
-  for(sizei i = 0; i < model->meshes.size(); i++) {
-    Mesh* mesh    = model->meshes[i];
-    Material* mat = model->materials[mesh->material_index]; 
-    
-    // Let the main given material "influence" the model's material 
-    
-    mat->transparency = material->transparency;
-    mat->depth_mask   = material->depth_mask;
-
-    render_queue_push_instanced(RENDER_QUEUE_OPAQUE, mesh, mat, transforms, count); 
-  }  
+  render_queue_push_model(RENDER_QUEUE_OPAQUE, model, material, transforms, count);
 }
 
 void renderer_queue_animation_instanced(const ResourceID& model_id,
@@ -901,17 +1198,21 @@ void renderer_queue_animation_instanced(const ResourceID& model_id,
                                         const AnimationSampler** samplers,
                                         const sizei count, 
                                         const ResourceID& mat_id) {
-  // Queue the skinned model first
-  renderer_queue_model_instanced(model_id, transforms, count, mat_id);
-
-  // Queue the animation 
+  // Queue the animations first
 
-  RenderQueueEntry* entry = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
-  entry->animation_remap_table.emplace_back((i32)entry->animations.size());
+  DynamicArray<i32>& offsets = s_renderer.joint_offsets_scratch;
+  offsets.resize(count);
 
   for(sizei i = 0; i < count; i++) {
-    entry->animations.emplace_back(animation_sampler_get_skinning_palette(samplers[i]));
+    offsets[i] = push_skinning_palette(samplers[i], 
+                                       animation_sampler_get_skinning_palette(samplers[i]), 
+                                       animation_sampler_get_joints_count(samplers[i]));
   }
+
+  // Queue the skinned model
+
+  Material* material = RESOURCE_IS_VALID(mat_id) ? resources_get_material(mat_id) : s_renderer.defaults.material;
+  render_queue_push_model(RENDER_QUEUE_OPAQUE, resources_get_model(model_id), material, transforms, count, offsets.data());
 }
 
 void renderer_queue_animation_instanced(const ResourceID& model_id,
@@ -919,89 +1220,43 @@ void renderer_queue_animation_instanced(const ResourceID& model_id,
                                         const AnimationBlender** blenders,
                                         const sizei count, 
                                         const ResourceID& mat_id) {
-  // Queue the skinned model first
-  renderer_queue_model_instanced(model_id, transforms, count, mat_id);
+  // Queue the animations first
 
-  // Queue the animation 
-
-  RenderQueueEntry* entry = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
-  entry->animation_remap_table.emplace_back((i32)entry->animations.size());
+  DynamicArray<i32>& offsets = s_renderer.joint_offsets_scratch;
+  offsets.resize(count);
 
   for(sizei i = 0; i < count; i++) {
-    RenderQueueEntry* entry = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
-    entry->animations.emplace_back(animation_blender_get_skinning_palette(blenders[i]));
+    offsets[i] = push_skinning_palette(blenders[i], 
+                                       animation_blender_get_skinning_palette(blenders[i]), 
+                                       animation_blender_get_joints_count(blenders[i]));
   }
+
+  // Queue the skinned model
+  
+  Material* material = RESOURCE_IS_VALID(mat_id) ? resources_get_material(mat_id) : s_renderer.defaults.material;
+  render_queue_push_model(RENDER_QUEUE_OPAQUE, resources_get_model(model_id), material, transforms, count, offsets.data());
 }
 
 void renderer_queue_mesh(const ResourceID& res_id, const Transform& transform, const ResourceID& mat_id) {
-  // Retrieving the necessary resources
-
-  Mesh* mesh         = resources_get_mesh(res_id);
-  Material* material = s_renderer.defaults.material;
-
-  if(RESOURCE_IS_VALID(mat_id)) {
-    material = resources_get_material(mat_id);
-  }
-
-  // Issuing the draw command 
-  render_queue_push(RENDER_QUEUE_OPAQUE, mesh, transform, material); 
+  renderer_queue_mesh_instanced(res_id, &transform, 1, mat_id);
 }
 
 void renderer_queue_model(const ResourceID& res_id, const Transform& transform, const ResourceID& mat_id) {
-  // Retrieving the necessary resources
-  
-  Material* material = s_renderer.defaults.material;
-  Model* model       = resources_get_model(res_id);
-
-  if(RESOURCE_IS_VALID(mat_id)) {
-    material = resources_get_material(mat_id);
-  }
- 
-  // Issuing the draw command 
-  
-  for(sizei i = 0; i < model->meshes.size(); i++) {
-    Mesh* mesh    = model->meshes[i];
-    Material* mat = model->materials[mesh->material_index]; 
-    
-    // Let the main given material "influence" the model's material 
-    
-    mat->transparency = material->transparency;
-    mat->depth_mask   = material->depth_mask;
-
-    render_queue_push(RENDER_QUEUE_OPAQUE, mesh, transform, mat); 
-  }  
+  renderer_queue_model_instanced(res_id, &transform, 1, mat_id);
 }
 
 void renderer_queue_animation(const ResourceID& model_id,
                               const Transform& transform, 
                               const AnimationSampler* sampler,
                               const ResourceID& mat_id) {
-  RenderQueueEntry* entry = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
-  
-  // Queue the skinned model first
-  renderer_queue_model(model_id, transform, mat_id);
-
-  // Add the remap index
-  entry->animation_remap_table.emplace_back((i32)entry->animations.size());
-
-  // Queue the animation
-  entry->animations.emplace_back(animation_sampler_get_skinning_palette(sampler));
+  renderer_queue_animation_instanced(model_id, &transform, &sampler, 1, mat_id);
 }
 
 void renderer_queue_animation(const ResourceID& model_id,
                               const Transform& transform, 
                               const AnimationBlender* blender,
                               const ResourceID& mat_id) {
-  RenderQueueEntry* entry = &s_renderer.queues[RENDER_QUEUE_OPAQUE];
-  
-  // Queue the skinned model first
-  renderer_queue_model(model_id, transform, mat_id);
-
-  // Add the remap index
-  entry->animation_remap_table.emplace_back((i32)entry->animations.size());
-
-  // Queue the animation
-  entry->animations.emplace_back(animation_blender_get_skinning_palette(blender));
+  renderer_queue_animation_instanced(model_id, &transform, &blender, 1, mat_id);
 }
 
 void renderer_queue_particles(const ParticleEmitter& emitter) {
@@ -1015,7 +1270,7 @@ void renderer_queue_particles(const ParticleEmitter& emitter) {
   }
   
   // Issuing the draw command
-  render_queue_push_instanced(RENDER_QUEUE_PARTICLE, mesh, material, emitter.transforms, emitter.particles_count); 
+  render_queue_push(RENDER_QUEUE_PARTICLE, mesh, material, emitter.transforms, emitter.particles_count); 
 }
 
 void renderer_queue_debug_cube_instanced(const Transform* transforms, const sizei count, const ResourceID& mat_id) {
@@ -1029,7 +1284,7 @@ void renderer_queue_debug_cube_instanced(const Transform* transforms, const size
   }
 
   // Issuing the draw command
-  render_queue_push_instanced(RENDER_QUEUE_DEBUG, mesh, material, transforms, count); 
+  render_queue_push(RENDER_QUEUE_DEBUG, mesh, material, transforms, count); 
 }
 
 void renderer_queue_debug_sphere_instanced(const Transform* transforms, const sizei count, const ResourceID& mat_id) {
@@ -1043,35 +1298,15 @@ void renderer_queue_debug_sphere_instanced(const Transform* transforms, const si
   }
 
   // Issuing the draw command
-  render_queue_push_instanced(RENDER_QUEUE_DEBUG, mesh, material, transforms, count); 
+  render_queue_push(RENDER_QUEUE_DEBUG, mesh, material, transforms, count); 
 }
 
 void renderer_queue_debug_cube(const Transform& transform, const ResourceID& mat_id) {
-  // Retrieving the necessary resources
-
-  Material* material = s_renderer.defaults.debug_material;
-  Mesh* mesh         =  s_renderer.geometries[GEOMETRY_SIMPLE_CUBE];
-  
-  if(RESOURCE_IS_VALID(mat_id)) {
-    material = resources_get_material(mat_id);
-  }
-
-  // Issuing the draw command
-  render_queue_push(RENDER_QUEUE_DEBUG, mesh, transform, material); 
+  renderer_queue_debug_cube_instanced(&transform, 1, mat_id);
 }
 
 void renderer_queue_debug_sphere(const Transform& transform, const ResourceID& mat_id) {
-  // Retrieving the necessary resources
-
-  Material* material = s_renderer.defaults.debug_material;
-  Mesh* mesh         =  s_renderer.geometries[GEOMETRY_SIMPLE_SPHERE];
-  
-  if(RESOURCE_IS_VALID(mat_id)) {
-    material = resources_get_material(mat_id);
-  }
-
-  // Issuing the draw command
-  render_queue_push(RENDER_QUEUE_DEBUG, mesh, transform, material); 
+  renderer_queue_debug_sphere_instanced(&transform, 1, mat_id);
 }
 
 void renderer_draw_skybox(const ResourceID& skybox_id) {
@@ -10,7 +10,14 @@ namespace nikola {
 ///---------------------------------------------------------------------------------------------------------------------
 /// Private functions
 
-static void cache_uniform(ShaderContext* ctx, const String& name) {
+static ShaderUniformID cache_uniform(ShaderContext* ctx, const String& name) {
+  // Already cached
+  
+  auto cached = ctx->uniforms_cache.find(name);
+  if(cached != ctx->uniforms_cache.end()) {
+    return cached->second;
+  }
+
   GfxShader* shader = ctx->shader; 
   
   // Get the new uniform location, first
@@ -20,39 +27,170 @@ static void cache_uniform(ShaderContext* ctx, const String& name) {
   
   if(location == -1) {
     NIKOLA_LOG_WARN("Could not find uniform \'%s\' in ShaderContext", name.c_str());
-    return;
+    return SHADER_UNIFORM_INVALID;
   }
 
   // New uniform!
+  //
+  // @NOTE: The uniform's space in the shadow buffer only gets 
+  // allocated on its first write, since its type is not known yet.
   
-  ctx->uniforms_cache[name] = location; 
+  ShaderUniformID id = (ShaderUniformID)ctx->uniforms.size();
+  ctx->uniforms.push_back(ShaderUniform{.location = location});
+
+  ctx->uniforms_cache[name] = id; 
   NIKOLA_LOG_DEBUG("Cache uniform \'%s\' with location \'%i\' in ShaderContext...", name.c_str(), location);
+
+  return id;
 }
 
-static void check_and_send_uniform(ShaderContext* ctx, const String& name, GfxLayoutType type, const void* data) {
-  GfxShader* shader = ctx->shader; 
+static sizei layout_type_size(const GfxLayoutType type) {
+  switch(type) {
+    case GFX_LAYOUT_FLOAT1:
+    case GFX_LAYOUT_INT1:
+      return sizeof(f32);
+    case GFX_LAYOUT_FLOAT2:
+      return sizeof(Vec2);
+    case GFX_LAYOUT_FLOAT3:
+      return sizeof(Vec3);
+    case GFX_LAYOUT_FLOAT4:
+      return sizeof(Vec4);
+    case GFX_LAYOUT_MAT4:
+      return sizeof(Mat4);
+    default:
+      NIKOLA_ASSERT(false, "Unsupported uniform type in ShaderContext");
+      return 0;
+  }
+}
+
+static void grow_uniform(ShaderContext* ctx, ShaderUniform* uniform, const sizei size) {
+  DynamicArray<u8>& buffer = ctx->uniforms_buffer;
+
+  // The uniform at the end of the buffer can just grow in place
+
+  if(uniform->size > 0 && (uniform->offset + uniform->size) == buffer.size()) {
+    uniform->size = size;
+    buffer.resize(uniform->offset + size);
 
-  // Send the uniform (only if it is valid)
-  
-  if(ctx->uniforms_cache.find(name) != ctx->uniforms_cache.end()) {
-    gfx_shader_upload_uniform(shader, ctx->uniforms_cache[name], type, data);
     return;
   }
+
+  // Otherwise, its old space is left behind...
+
+  uniform->offset = buffer.size(); 
+  uniform->size   = size;
+  buffer.resize(buffer.size() + size);
+
+  // ...and only reclaimed once there is more dead space than live space
+
+  sizei live_size = 0;
+  for(auto& other : ctx->uniforms) {
+    live_size += other.size;
+  }
+
+  if(buffer.size() <= (live_size * 2)) {
+    return;
+  }
+
+  DynamicArray<u8> packed;
+  packed.reserve(live_size);
+
+  for(auto& other : ctx->uniforms) {
+    if(other.size == 0) {
+      continue;
+    }
+
+    sizei offset = packed.size();
+    packed.insert(packed.end(), buffer.begin() + other.offset, buffer.begin() + other.offset + other.size);
+
+    other.offset = offset;
+  }
+
+  buffer = std::move(packed);
+}
+
+static bool write_uniform(ShaderContext* ctx, const ShaderUniformID id, GfxLayoutType type, const void* data, const sizei count) {
+  // The uniform was either never found or optimized away by the driver. 
+  // Either way, there's nowhere to send the value.
+
+  if(id == SHADER_UNIFORM_INVALID) {
+    return false;
+  }
+
+  NIKOLA_ASSERT((id < ctx->uniforms.size()), "Invalid uniform ID given to ShaderContext");
+  
+  ShaderUniform* uniform = &ctx->uniforms[id];
+  sizei size             = layout_type_size(type) * count;
+
+  // Allocate (or grow) the uniform's space in the shadow buffer
+  
+  if(size > uniform->size) {
+    grow_uniform(ctx, uniform, size);
+  }
+  else if(uniform->type == type && uniform->count == count && !uniform->is_dirty) {
+    // Nothing changed. No need to send the same value again.
+    
+    if(memcmp(&ctx->uniforms_buffer[uniform->offset], data, size) == 0) {
+      return false;
+    }
+  }
+
+  memcpy(&ctx->uniforms_buffer[uniform->offset], data, size);
   
-  // @TODO (ShaderContext): Silent error??
+  uniform->type     = type;
+  uniform->count    = count;
+  uniform->is_dirty = true;
+
+  return true;
 }
 
-static void check_and_send_uniform_array(ShaderContext* ctx, const String& name, GfxLayoutType type, const void* data, const sizei count) {
-  GfxShader* shader = ctx->shader; 
+static void upload_uniform(ShaderContext* ctx, ShaderUniform& uniform) {
+  // The uniform was removed from the shader by a reload
+  
+  if(uniform.location == -1) {
+    uniform.is_dirty = false;
+    return;
+  }
 
+  gfx_shader_upload_uniform_array(ctx->shader, 
+                                  uniform.location, 
+                                  uniform.type, 
+                                  &ctx->uniforms_buffer[uniform.offset], 
+                                  uniform.count);
+  
+  uniform.is_dirty = false;
+}
+
+static void check_and_send_uniform(ShaderContext* ctx, const String& name, GfxLayoutType type, const void* data) {
   // Send the uniform (only if it is valid)
   
-  if(ctx->uniforms_cache.find(name) != ctx->uniforms_cache.end()) {
-    gfx_shader_upload_uniform_array(shader, ctx->uniforms_cache[name], type, data, count);
+  auto cached = ctx->uniforms_cache.find(name);
+  if(cached == ctx->uniforms_cache.end()) {
+    // @TODO (ShaderContext): Silent error??
     return;
   }
+
+  // Uniforms set by name are sent right away
+
+  if(write_uniform(ctx, cached->second, type, data, 1)) {
+    upload_uniform(ctx, ctx->uniforms[cached->second]);
+  }
+}
+
+static void check_and_send_uniform_array(ShaderContext* ctx, const String& name, GfxLayoutType type, const void* data, const sizei count) {
+  // Send the uniform (only if it is valid)
   
-  // @TODO (ShaderContext): Silent error??
+  auto cached = ctx->uniforms_cache.find(name);
+  if(cached == ctx->uniforms_cache.end()) {
+    // @TODO (ShaderContext): Silent error??
+    return;
+  }
+
+  // Uniforms set by name are sent right away
+
+  if(write_uniform(ctx, cached->second, type, data, count)) {
+    upload_uniform(ctx, ctx->uniforms[cached->second]);
+  }
 }
 
 /// Private functions
@@ -61,11 +199,86 @@ static void check_and_send_uniform_array(ShaderContext* ctx, const String& name,
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShaderContext functions
 
-void shader_context_cache_uniform(ShaderContext* ctx, const String& uniform_name) {
+ShaderUniformID shader_context_cache_uniform(ShaderContext* ctx, const String& uniform_name) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_cache_uniform");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_cache_uniform");
+  
+  return cache_uniform(ctx, uniform_name);
+}
+
+void shader_context_reload(ShaderContext* ctx) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_reload");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_reload");
+
+  for(auto& [name, id] : ctx->uniforms_cache) {
+    ShaderUniform& uniform = ctx->uniforms[id];
+
+    uniform.location = gfx_shader_uniform_lookup(ctx->shader, name.c_str());
+    uniform.is_dirty = (uniform.size > 0);
+
+    if(uniform.location == -1) {
+      NIKOLA_LOG_WARN("Uniform \'%s\' is no longer in the reloaded shader of the ShaderContext", name.c_str());
+    }
+  }
+}
+
+void shader_context_flush(ShaderContext* ctx) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_flush");
+  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_flush");
+
+  for(auto& uniform : ctx->uniforms) {
+    if(uniform.is_dirty) {
+      upload_uniform(ctx, uniform);
+    }
+  }
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const i32 value) {
   NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
-  NIKOLA_ASSERT(ctx->shader, "Invalid shader in ShaderContext passed to shader_context_set_uniform");
   
-  cache_uniform(ctx, uniform_name);
+  write_uniform(ctx, uniform, GFX_LAYOUT_INT1, &value, 1);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const f32 value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_FLOAT1, &value, 1);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec2& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_FLOAT2, &value, 1);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec3& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_FLOAT3, &value, 1);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Vec4& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_FLOAT4, &value, 1);
+}
+
+void shader_context_set_uniform(ShaderContext* ctx, const ShaderUniformID uniform, const Mat4& value) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_MAT4, &value, 1);
+}
+
+void shader_context_set_uniform_array(ShaderContext* ctx, const ShaderUniformID uniform, const i32* values, const sizei count) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform_array");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_INT1, values, count);
+}
+
+void shader_context_set_uniform_array(ShaderContext* ctx, const ShaderUniformID uniform, const f32* values, const sizei count) {
+  NIKOLA_ASSERT(ctx, "Invalid ShaderContext passed to shader_context_set_uniform_array");
+  
+  write_uniform(ctx, uniform, GFX_LAYOUT_FLOAT1, values, count);
 }
 
 void shader_context_set_uniform(ShaderContext* ctx, const String& uniform_name, const i32 value) {
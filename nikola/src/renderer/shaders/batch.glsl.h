@@ -39,6 +39,7 @@ inline nikola::GfxShaderDesc generate_batch_quad_shader() {
  
     .pixel_source = R"(
       #version 460 core
+      #extension GL_ARB_bindless_texture : require
      
       // Outputs
       layout (location = 0) out vec4 frag_color;
@@ -61,23 +62,20 @@ inline nikola::GfxShaderDesc generate_batch_quad_shader() {
       // Material2D
 
       struct Material2D {
+        sampler2D texture_handle;
         vec2 size; 
-        vec2 __padding0;
 
         float radius;
         float sides_count; 
         float shape_type;
 
-        float __padding1;
+        float __padding0;
       };
 
-      // Uniforms
-      uniform sampler2D u_texture;
-
       // Buffers 
 
       layout(std430, binding = 5) readonly buffer Material2DBuffer {
-        Material2D u_materials[1024];
+        Material2D u_materials[];
       };
 
       // Functions
@@ -96,7 +94,7 @@ inline nikola::GfxShaderDesc generate_batch_quad_shader() {
           discard;
         }
 
-        return texture(u_texture, fs_in.tex_coords) * fs_in.out_color;
+        return texture(material.texture_handle, fs_in.tex_coords) * fs_in.out_color;
       }
 
       vec4 circle_shape(Material2D material) {
@@ -107,7 +105,7 @@ inline nikola::GfxShaderDesc generate_batch_quad_shader() {
           discard;
         }
 
-        return texture(u_texture, fs_in.tex_coords) * fs_in.out_color;
+        return texture(material.texture_handle, fs_in.tex_coords) * fs_in.out_color;
       }
 
       vec4 polygon_shape(Material2D material) {
@@ -123,11 +121,11 @@ inline nikola::GfxShaderDesc generate_batch_quad_shader() {
           discard;
         }
 
-        return texture(u_texture, fs_in.tex_coords) * fs_in.out_color;
+        return texture(material.texture_handle, fs_in.tex_coords) * fs_in.out_color;
       }
 
       vec4 text_shape(Material2D material) {
-        vec4 color = vec4(1.0, 1.0, 1.0, texture(u_texture, fs_in.tex_coords).r);
+        vec4 color = vec4(1.0, 1.0, 1.0, texture(material.texture_handle, fs_in.tex_coords).r);
         return fs_in.out_color * color;
       }
 
@@ -29,11 +29,12 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
       };
       
       layout(std430, binding = 4) readonly buffer AnimationBuffer {
-        mat4 u_skinning_palette[256][256]; // @TODO: Probably not the best count to have here
+        mat4 u_joints[];
+      };
+      
+      layout(std430, binding = 6) readonly buffer JointOffsetsBuffer {
+        int u_joint_offsets[];
       };
-
-      uniform int u_animation_remap_table[256]; 
-      uniform mat4 u_light_space;
   
       // Outputs
       
@@ -47,20 +48,20 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         vec3 camera_pos;
         vec3 pixel_pos;
 
-        vec4 shadow_pos;
+        float view_depth;
 
         flat int material_index;
       } vs_out;
 
       // Utility functions 
      
-      vec4 animate_vertex(const int index) {
+      vec4 animate_vertex(const int offset) {
         vec4 result = vec4(0.0, 0.0, 0.0, 1.0);
 
-        result += u_skinning_palette[index][int(aJointId[0])] * vec4(aPos, 1.0) * aJointWeight[0];
-        result += u_skinning_palette[index][int(aJointId[1])] * vec4(aPos, 1.0) * aJointWeight[1];
-        result += u_skinning_palette[index][int(aJointId[2])] * vec4(aPos, 1.0) * aJointWeight[2];
-        result += u_skinning_palette[index][int(aJointId[3])] * vec4(aPos, 1.0) * aJointWeight[3];
+        result += u_joints[offset + int(aJointId[0])] * vec4(aPos, 1.0) * aJointWeight[0];
+        result += u_joints[offset + int(aJointId[1])] * vec4(aPos, 1.0) * aJointWeight[1];
+        result += u_joints[offset + int(aJointId[2])] * vec4(aPos, 1.0) * aJointWeight[2];
+        result += u_joints[offset + int(aJointId[3])] * vec4(aPos, 1.0) * aJointWeight[3];
 
         return result;
       }
@@ -73,7 +74,7 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
 
         vec4 vertex_pos = vec4(aPos, 1.0);
         if(aJointId[0] != -2.0) { // -2.0 is just a simple value to indicate a static mesh
-          vertex_pos = animate_vertex(u_animation_remap_table[index]);
+          vertex_pos = animate_vertex(u_joint_offsets[index]);
         }
 
         vec4 model_space = u_model[index] * vertex_pos;
@@ -100,7 +101,7 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         vs_out.camera_pos     = u_camera_pos;
         vs_out.pixel_pos      = vec3(model_space);
         vs_out.tex_coords     = aTexCoords;
-        vs_out.shadow_pos     = u_light_space * vec4(vs_out.pixel_pos, 1.0);
+        vs_out.view_depth     = -(u_view * model_space).z;
         vs_out.material_index = gl_DrawID;
 
         gl_Position = u_projection * u_view * model_space;
@@ -123,13 +124,14 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         vec3 camera_pos;
         vec3 pixel_pos;
 
-        vec4 shadow_pos;
+        float view_depth;
 
         flat int material_index;
       } fs_in;
    
-      #define LIGHTS_MAX 16
-      #define PI         3.14159265359
+      #define LIGHTS_MAX   16
+      #define CASCADES_MAX 4
+      #define PI           3.14159265359
   
       struct Material {
         sampler2D albedo_handle;
@@ -216,8 +218,14 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         int u_points_count, u_spots_count;
       };
       
+      // Uniforms
+
+      uniform mat4 u_light_spaces[CASCADES_MAX];
+      uniform vec4 u_cascade_splits;
+      uniform int u_cascades_count;
+
       // Textures
-      layout (binding = 0) uniform sampler2D u_shadow_map;
+      layout (binding = 0) uniform sampler2DArrayShadow u_shadow_map;
    
       // BRDF terms 
 
@@ -287,32 +295,49 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         return normalize(TBN * mapped_normal);
       }
 
-      float calculate_shadow() {
-        // Converting the shadow space position to texture coordinates
+      float calculate_shadow(const vec3 normal) {
+        // Pick the closest cascade that covers this pixel
+
+        int cascade = u_cascades_count - 1;
+        for(int i = 0; i < u_cascades_count; i++) {
+          if(fs_in.view_depth < u_cascade_splits[i]) {
+            cascade = i;
+            break;
+          }
+        }
+
+        if(fs_in.view_depth > u_cascade_splits[u_cascades_count - 1]) { // Early out for pixels too far away
+          return 0.0;
+        }
+
+        // Converting the pixel's position into the cascade's texture coordinates
         
-        vec3 proj_coords = (fs_in.shadow_pos.xyz / fs_in.shadow_pos.w) * 0.5f + 0.5f;
-        if(proj_coords.z > 1.0) { // Early out for objects too far away
+        vec4 shadow_pos  = u_light_spaces[cascade] * vec4(fs_in.pixel_pos, 1.0);
+        vec3 proj_coords = (shadow_pos.xyz / shadow_pos.w) * 0.5f + 0.5f;
+        if(proj_coords.z > 1.0) { 
           return 0.0;
         }
 
-        // @TEMP (Shadows): Have a better bias setup here...
-        float bias = 0.005;
+        // @NOTE: The further cascades cover more area per texel, so they need a bigger bias.
+        
+        float slope = 1.0 - max(dot(normal, normalize(-u_dir_light.direction)), 0.0);
+        float bias  = max(0.005 * slope, 0.0005) * (cascade + 1);
 
-        // Applying a simple PCF (Percentage-closer filtering)
-        // @TEMP (Shadows): Have a better PCF algo here...
+        // Applying a simple PCF (Percentage-closer filtering) 
+        // with the hardware depth comparison
 
         float shadow_factor = 0.0; 
-        vec2 texture_size   = 1.0 / textureSize(u_shadow_map, 0);
+        vec2 texture_size   = 1.0 / textureSize(u_shadow_map, 0).xy;
 
-        for(int x = -1; x < 1; x++) {
-          for(int y = -1; y < 1; y++) {
-            float pcf_depth = texture(u_shadow_map, proj_coords.xy + vec2(x, y) * texture_size).r;
-            shadow_factor  += (proj_coords.z - bias) > pcf_depth ? 1.0 : 0.0;
+        for(int x = -1; x <= 1; x++) {
+          for(int y = -1; y <= 1; y++) {
+            vec2 uv        = proj_coords.xy + vec2(x, y) * texture_size;
+            shadow_factor += texture(u_shadow_map, vec4(uv, cascade, proj_coords.z - bias));
           }
         }
 
-        // Final shadow value
-        return (shadow_factor /= 9.0);
+        // Final shadow value (the comparison returns 1.0 for lit texels)
+        return 1.0 - (shadow_factor / 9.0);
       }  
 
       // Lights
@@ -414,7 +439,7 @@ inline nikola::GfxShaderDesc generate_pbr_shader() {
         // Add it all together...
         
         vec3 final_color = (emissive_texel + (dir_light_factor + point_lights_factor + spot_lights_factor)) * u_ambient;
-        frag_color       = vec4((1 - calculate_shadow()) * final_color, material.transparency);
+        frag_color       = vec4((1 - calculate_shadow(brdf.normal)) * final_color, material.transparency);
       }
     )"
   };
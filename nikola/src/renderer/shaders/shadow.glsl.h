@@ -23,23 +23,26 @@ inline nikola::GfxShaderDesc generate_shadow_shader() {
       };
       
       layout(std430, binding = 4) readonly buffer AnimationBuffer {
-        mat4 u_skinning_palette[256][256]; // @TODO: Probably not the best count to have here
+        mat4 u_joints[];
+      };
+      
+      layout(std430, binding = 6) readonly buffer JointOffsetsBuffer {
+        int u_joint_offsets[];
       };
       
       // Uniforms
       
-      uniform int u_animation_remap_table[256]; 
       uniform mat4 u_light_space;
 
       // Utility functions 
      
-      vec4 animate_vertex(const int index) {
+      vec4 animate_vertex(const int offset) {
         vec4 result = vec4(0.0, 0.0, 0.0, 1.0);
 
-        result += u_skinning_palette[index][int(aJointId[0])] * vec4(aPos, 1.0) * aJointWeight[0];
-        result += u_skinning_palette[index][int(aJointId[1])] * vec4(aPos, 1.0) * aJointWeight[1];
-        result += u_skinning_palette[index][int(aJointId[2])] * vec4(aPos, 1.0) * aJointWeight[2];
-        result += u_skinning_palette[index][int(aJointId[3])] * vec4(aPos, 1.0) * aJointWeight[3];
+        result += u_joints[offset + int(aJointId[0])] * vec4(aPos, 1.0) * aJointWeight[0];
+        result += u_joints[offset + int(aJointId[1])] * vec4(aPos, 1.0) * aJointWeight[1];
+        result += u_joints[offset + int(aJointId[2])] * vec4(aPos, 1.0) * aJointWeight[2];
+        result += u_joints[offset + int(aJointId[3])] * vec4(aPos, 1.0) * aJointWeight[3];
 
         return result;
       }
@@ -51,7 +54,7 @@ inline nikola::GfxShaderDesc generate_shadow_shader() {
         // Animate the vertex if that's possible
 
         if(aJointId[0] != -2.0) { // -2.0 is just a simple value to indicate a static mesh
-          vertex_pos = animate_vertex(u_animation_remap_table[index]);
+          vertex_pos = animate_vertex(u_joint_offsets[index]);
         }
         
         gl_Position = u_light_space * u_model[index] * vertex_pos;
@@ -19,15 +19,6 @@
 
 namespace nikola { // Start of nikola
 
-///---------------------------------------------------------------------------------------------------------------------
-/// Consts
-
-const sizei VERTEX_BUFFER_SIZE = KiB(256);
-const sizei INDEX_BUFFER_SIZE  = KiB(256);
-
-/// Consts
-///---------------------------------------------------------------------------------------------------------------------
-
 ///---------------------------------------------------------------------------------------------------------------------
 /// ShaderID
 enum ShaderID {
@@ -53,12 +44,33 @@ class NKRenderInterface;
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
-/// UIBatch
-struct UIBatch {
-  DynamicArray<Rml::Vertex> vertices; 
-  DynamicArray<i32> indices;
+/// UIGeometry
+struct UIGeometry {
+  GfxBuffer* vertex_buffer = nullptr; 
+  GfxBuffer* index_buffer  = nullptr;
+
+  GfxPipeline* pipeline = nullptr;
+};
+/// UIGeometry
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// UIScissor
+struct UIScissor {
+  bool is_enabled = false;
+  IVec4 rect      = IVec4(0);
 };
-/// UIBatch
+/// UIScissor
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// UIShaderState
+struct UIShaderState {
+  ShaderUniformID translate_uniform; 
+  ShaderUniformID transform_uniform; 
+  ShaderUniformID projection_uniform; 
+};
+/// UIShaderState
 ///---------------------------------------------------------------------------------------------------------------------
 
 ///---------------------------------------------------------------------------------------------------------------------
@@ -69,8 +81,9 @@ struct UIDrawCall {
 
   Vec2 translation = Vec2(0.0f);
   Mat4 transform   = Mat4(1.0f);
+  UIScissor scissor;
 
-  sizei batch_index = 0;
+  sizei geometry_index = 0;
 };
 /// UIDrawCall
 ///---------------------------------------------------------------------------------------------------------------------
@@ -83,22 +96,48 @@ struct UIRenderer {
 
   GfxContext* gfx;
   Window* window;
-  GfxPipeline* pipeline; 
 
-  ShaderContext* shaders[SHADERS_MAX]; // Pre-compiled shader contexts
+  ShaderContext* shaders[SHADERS_MAX];      // Pre-compiled shader contexts
+  UIShaderState shader_states[SHADERS_MAX]; // Cached uniforms of each shader
+
+  DynamicArray<UIGeometry> geometries;     // Compiled geometry (resident on the GPU)
+  DynamicArray<sizei> free_geometries;     // Released geometry slots (ready to be reused)
+  DynamicArray<sizei> released_geometries; // Geometry released in the current frame
+  DynamicArray<GfxTexture*> textures;      // Textures in use
+  DynamicArray<UIDrawCall> draw_calls;     // Recorded draw calls
 
-  DynamicArray<UIBatch> batches;       // Compiled batches
-  DynamicArray<GfxTexture*> textures;  // Textures in use
-  DynamicArray<UIDrawCall> draw_calls; // Compiled draw calls
+  Mat4 transform    = Mat4(1.0f);
+  Mat4 ortho        = Mat4(1.0f);
+  UIScissor scissor = {};
 
-  Mat4 transform = Mat4(1.0f);
-  Mat4 ortho     = Mat4(1.0f);
+  GfxQuery* gpu_timer = nullptr;
 };
 
 static UIRenderer s_renderer;
 /// UIRenderer
 ///---------------------------------------------------------------------------------------------------------------------
 
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static void destroy_released_geometries() {
+  for(auto& index : s_renderer.released_geometries) {
+    UIGeometry& geo = s_renderer.geometries[index];
+
+    gfx_pipeline_destroy(geo.pipeline);
+    gfx_buffer_destroy(geo.vertex_buffer);
+    gfx_buffer_destroy(geo.index_buffer);
+
+    geo = UIGeometry{};
+    s_renderer.free_geometries.push_back(index);
+  }
+
+  s_renderer.released_geometries.clear();
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
 ///---------------------------------------------------------------------------------------------------------------------
 /// NKSystemInterface
 class NKSystemInterface : public Rml::SystemInterface {
@@ -142,27 +181,79 @@ public:
 
 public:
   Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override {
-    UIBatch batch = {}; 
-    batch.vertices.assign(vertices.data(), vertices.data() + vertices.size());
-    batch.indices.assign(indices.data(), indices.data() + indices.size());
+    // Upload the geometry to the GPU once. It will stay 
+    // there until RmlUi releases it.
+
+    UIGeometry geo = {};
+
+    GfxBufferDesc buff_desc = {
+      .data  = (void*)vertices.data(), 
+      .size  = sizeof(Rml::Vertex) * vertices.size(),
+      .type  = GFX_BUFFER_VERTEX,
+      .usage = GFX_BUFFER_USAGE_STATIC_DRAW,
+    };
+    geo.vertex_buffer = gfx_buffer_create(renderer.gfx);
+    gfx_buffer_load(geo.vertex_buffer, buff_desc);
+
+    buff_desc = {
+      .data  = (void*)indices.data(), 
+      .size  = sizeof(i32) * indices.size(),
+      .type  = GFX_BUFFER_INDEX,
+      .usage = GFX_BUFFER_USAGE_STATIC_DRAW,
+    };
+    geo.index_buffer = gfx_buffer_create(renderer.gfx);
+    gfx_buffer_load(geo.index_buffer, buff_desc);
+
+    // Pipeline init
+
+    GfxPipelineDesc pipe_desc = {
+      .vertex_buffer  = geo.vertex_buffer, 
+      .vertices_count = vertices.size(), 
+      
+      .index_buffer   = geo.index_buffer, 
+      .indices_count  = indices.size(),
+    };
+
+    pipe_desc.layouts[0].attributes[0]    = GFX_LAYOUT_FLOAT2; // Position
+    pipe_desc.layouts[0].attributes[1]    = GFX_LAYOUT_UBYTE4; // Color
+    pipe_desc.layouts[0].attributes[2]    = GFX_LAYOUT_FLOAT2; // Texture coords
+    pipe_desc.layouts[0].attributes_count = 3;
+    
+    pipe_desc.draw_mode = GFX_DRAW_MODE_TRIANGLE; 
+    geo.pipeline        = gfx_pipeline_create(renderer.gfx, pipe_desc);
+
+    // Reuse any released slots first
 
-    renderer.batches.push_back(batch);
-    return (Rml::CompiledGeometryHandle)(renderer.batches.size());
+    if(!renderer.free_geometries.empty()) {
+      sizei index = renderer.free_geometries.back();
+      renderer.free_geometries.pop_back();
+
+      renderer.geometries[index] = geo;
+      return (Rml::CompiledGeometryHandle)(index + 1);
+    }
+
+    renderer.geometries.push_back(geo);
+    return (Rml::CompiledGeometryHandle)(renderer.geometries.size());
   }
   
   void RenderGeometry(Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation, Rml::TextureHandle texture) override {
+    // Only record the draw. The geometry is already on the GPU.
+
     UIDrawCall call{};
-    call.texture     = (texture == 0) ? nullptr : renderer.textures[(sizei)(texture - 1)];
-    call.shader_id   = (texture == 0) ? SHADER_COLOR : SHADER_TEXTURE;
-    call.translation = Vec2(translation.x, translation.y);
-    call.transform   = renderer.transform;
-    call.batch_index = (sizei)(geometry - 1);
+    call.texture        = (texture == 0) ? nullptr : renderer.textures[(sizei)(texture - 1)];
+    call.shader_id      = (texture == 0) ? SHADER_COLOR : SHADER_TEXTURE;
+    call.translation    = Vec2(translation.x, translation.y);
+    call.transform      = renderer.transform;
+    call.scissor        = renderer.scissor;
+    call.geometry_index = (sizei)(geometry - 1);
 
     renderer.draw_calls.push_back(call);
   }
   
   void ReleaseGeometry(Rml::CompiledGeometryHandle geometry) override {
-    // @TODO (UI)
+    // @NOTE: The geometry might still be used by a recorded draw call. 
+    // Therefore, it only gets destroyed after the draw calls are submitted.
+    renderer.released_geometries.push_back((sizei)(geometry - 1));
   }
 
   Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override {
@@ -261,14 +352,16 @@ public:
   }
 
   void EnableScissorRegion(bool enable) override {
-    gfx_context_set_state(renderer.gfx, GFX_STATE_SCISSOR, enable);
+    // @NOTE: The scissor state is recorded with each draw call and only applied 
+    // when the draw calls are actually submitted.
+    renderer.scissor.is_enabled = enable;
   }
 
   void SetScissorRegion(Rml::Rectanglei region) {
     Rml::Vector2i position = region.Position();
     Rml::Vector2i size     = region.Size();
 
-    gfx_context_set_scissor_rect(renderer.gfx, position.x, position.y, size.x, size.y);
+    renderer.scissor.rect = IVec4(position.x, position.y, size.x, size.y);
   }
 
   void SetTransform(const Rml::Matrix4f* transform) {
@@ -321,44 +414,6 @@ bool ui_renderer_init(GfxContext* gfx) {
   s_renderer.gfx    = gfx;
   s_renderer.window = gfx_context_get_desc(gfx).window;
 
-  //
-  // Pipeline init
-  //
-
-  GfxPipelineDesc pipe_desc{};
-
-  // Vertex buffer init
-
-  GfxBufferDesc buff_desc = {
-    .data  = nullptr, 
-    .size  = VERTEX_BUFFER_SIZE,
-    .type  = GFX_BUFFER_VERTEX,
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
-  };
-  pipe_desc.vertex_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
-
-  // Index buffer init
-
-  buff_desc = {
-    .data  = nullptr, 
-    .size  = INDEX_BUFFER_SIZE,
-    .type  = GFX_BUFFER_INDEX,
-    .usage = GFX_BUFFER_USAGE_DYNAMIC_DRAW,
-  };
-  pipe_desc.index_buffer = resources_get_buffer(resources_push_buffer(RESOURCE_CACHE_ID, buff_desc));
-
-  // Layouts init
-
-  pipe_desc.layouts[0].attributes[0]    = GFX_LAYOUT_FLOAT2; // Position
-  pipe_desc.layouts[0].attributes[1]    = GFX_LAYOUT_UBYTE4; // Color
-  pipe_desc.layouts[0].attributes[2]    = GFX_LAYOUT_FLOAT2; // Texture coords
-  pipe_desc.layouts[0].attributes_count = 3;
-  
-  // Create the pipeline 
-
-  pipe_desc.draw_mode = GFX_DRAW_MODE_TRIANGLE; 
-  s_renderer.pipeline = gfx_pipeline_create(gfx, pipe_desc);
-
   //
   // Shaders init
   //
@@ -373,7 +428,14 @@ bool ui_renderer_init(GfxContext* gfx) {
   };
 
   for(sizei i = 0; i < SHADERS_MAX; i++) {
-    s_renderer.shaders[i] = resources_get_shader_context(resources_push_shader_context(RESOURCE_CACHE_ID, shader_ids[i]));
+    ShaderContext* shader = resources_get_shader_context(resources_push_shader_context(RESOURCE_CACHE_ID, shader_ids[i]));
+
+    s_renderer.shaders[i]       = shader;
+    s_renderer.shader_states[i] = UIShaderState {
+      .translate_uniform  = shader_context_cache_uniform(shader, "u_translate"),
+      .transform_uniform  = shader_context_cache_uniform(shader, "u_transform"),
+      .projection_uniform = shader_context_cache_uniform(shader, "u_projection"),
+    };
   }
 
   //
@@ -386,7 +448,14 @@ bool ui_renderer_init(GfxContext* gfx) {
   // Pre-allocating some memory for better performance
   //
 
-  s_renderer.batches.reserve(128);
+  s_renderer.geometries.reserve(128);
+  s_renderer.draw_calls.reserve(128);
+
+  //
+  // GPU timer init
+  //
+
+  s_renderer.gpu_timer = gfx_query_create(gfx, GFX_QUERY_TIMESTAMP);
 
   //
   // Interfaces init
@@ -417,15 +486,28 @@ void ui_renderer_shutdown() {
   delete s_renderer.system_interface;
 
   // Clearing all the resources
+  //
+  // @NOTE: RmlUi should release all of its geometry on shutdown. 
+  // This is just in case it did not.
 
-  for(auto& batch : s_renderer.batches) {
-    batch.vertices.clear();
-    batch.indices.clear();
+  destroy_released_geometries();
+
+  for(auto& geo : s_renderer.geometries) {
+    if(!geo.pipeline) {
+      continue;
+    }
+
+    gfx_pipeline_destroy(geo.pipeline);
+    gfx_buffer_destroy(geo.vertex_buffer);
+    gfx_buffer_destroy(geo.index_buffer);
   }
 
-  s_renderer.batches.clear();
+  s_renderer.geometries.clear();
+  s_renderer.free_geometries.clear();
   s_renderer.draw_calls.clear();
 
+  gfx_query_destroy(s_renderer.gpu_timer);
+
   // Done!
   NIKOLA_LOG_INFO("Successfully shutdown the ui renderer");
 }
@@ -449,16 +531,37 @@ void ui_renderer_end() {
 
   // Initiating the draw calls
 
+  gfx_query_begin(s_renderer.gpu_timer);
+
+  UIScissor scissor = {};
+  gfx_context_set_state(s_renderer.gfx, GFX_STATE_SCISSOR, false);
+
   for(auto& call : s_renderer.draw_calls) {
     // Retrieve the correct shader
 
     ShaderContext* shader = s_renderer.shaders[call.shader_id];
+    UIShaderState& state  = s_renderer.shader_states[call.shader_id];
 
     // Setting uniforms 
+    //
+    // @NOTE: The projection and the transform rarely change between 
+    // draw calls. The shader context will only upload what was changed.
+
+    shader_context_set_uniform(shader, state.translate_uniform, call.translation);
+    shader_context_set_uniform(shader, state.transform_uniform, call.transform);
+    shader_context_set_uniform(shader, state.projection_uniform, s_renderer.ortho);
 
-    shader_context_set_uniform(shader, "u_translate", call.translation);
-    shader_context_set_uniform(shader, "u_transform", call.transform);
-    shader_context_set_uniform(shader, "u_projection", s_renderer.ortho);
+    // Apply the scissor state (only if it changed)
+
+    if(scissor.is_enabled != call.scissor.is_enabled) {
+      gfx_context_set_state(s_renderer.gfx, GFX_STATE_SCISSOR, call.scissor.is_enabled);
+    }
+
+    if(call.scissor.is_enabled && scissor.rect != call.scissor.rect) {
+      gfx_context_set_scissor_rect(s_renderer.gfx, call.scissor.rect.x, call.scissor.rect.y, call.scissor.rect.z, call.scissor.rect.w);
+    }
+
+    scissor = call.scissor;
 
     // Use the resources
 
@@ -471,35 +574,30 @@ void ui_renderer_end() {
     }
 
     gfx_context_use_bindings(s_renderer.gfx, bind_desc);
+    shader_context_flush(shader);
 
-    // Update the required resources
-    
-    GfxPipelineDesc& pipe_desc = gfx_pipeline_get_desc(s_renderer.pipeline);
-
-    UIBatch& batch = s_renderer.batches[call.batch_index];
-    if(!batch.vertices.empty()) {
-      gfx_buffer_upload_data(pipe_desc.vertex_buffer, 
-                             0, 
-                             sizeof(Rml::Vertex) * batch.vertices.size(), 
-                             batch.vertices.data());
-    }
+    // Render the geometry
+   
+    UIGeometry& geo = s_renderer.geometries[call.geometry_index];
 
-    if(!batch.indices.empty()) {
-      gfx_buffer_upload_data(pipe_desc.index_buffer, 
-                             0, 
-                             sizeof(i32) * batch.indices.size(), 
-                             batch.indices.data());
-    }
+    gfx_context_use_pipeline(s_renderer.gfx, geo.pipeline); 
+    gfx_context_draw(s_renderer.gfx, 0);
+  }
 
-    pipe_desc.vertices_count = batch.vertices.size();
-    pipe_desc.indices_count  = batch.indices.size();
-    gfx_pipeline_update(s_renderer.pipeline, pipe_desc);
-    
-    // Render the batch
+  // Reset back to normal
 
-    gfx_context_use_pipeline(s_renderer.gfx, s_renderer.pipeline); 
-    gfx_context_draw(s_renderer.gfx, 0);
+  if(scissor.is_enabled) {
+    gfx_context_set_state(s_renderer.gfx, GFX_STATE_SCISSOR, false);
   }
+
+  gfx_query_end(s_renderer.gpu_timer);
+
+  // Nothing references the released geometry anymore
+  destroy_released_geometries();
+}
+
+const f64 ui_renderer_get_gpu_time() {
+  return gfx_query_get_elapsed(s_renderer.gpu_timer);
 }
 
 bool ui_renderer_load_font(const FilePath& path) {
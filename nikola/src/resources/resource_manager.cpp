@@ -4,10 +4,57 @@
 #include "nikola/nikola_file.h"
 #include "nikola/nikola_thread.h"
 
+#include <algorithm>
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
 
+/// ----------------------------------------------------------------------
+/// ResourceSlot 
+struct ResourceSlot {
+  /// Incremented every time the slot gets freed. Any `ResourceID` 
+  /// with an older generation is considered stale.
+  u16 generation = 0;
+  bool is_alive  = false;
+
+  /// The amount of references held to the resource. 
+  /// Only resources with no references can be evicted.
+  u32 ref_count = 0;
+
+  /// The last frame the resource was retrieved in.
+  u64 last_used = 0;
+
+  /// The amount of memory (in bytes) consumed by the resource.
+
+  sizei cpu_bytes = 0;
+  sizei gpu_bytes = 0;
+
+  /// Any resources referenced by this resource, which 
+  /// will be released once this resource is freed.
+  DynamicArray<ResourceID> dependencies;
+};
+/// ResourceSlot 
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// ResourceTableBase 
+struct ResourceTableBase {
+  DynamicArray<ResourceSlot> slots;
+  DynamicArray<u16> free_slots;
+};
+/// ResourceTableBase 
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// ResourceTable 
+template<typename T>
+struct ResourceTable : public ResourceTableBase {
+  DynamicArray<T> resources;
+};
+/// ResourceTable 
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// ResourceGroup 
 struct ResourceGroup {
@@ -15,22 +62,26 @@ struct ResourceGroup {
   FilePath parent_dir;
   ResourceGroupID id;
 
-  DynamicArray<GfxBuffer*> buffers;
-  DynamicArray<GfxTexture*> textures;
-  DynamicArray<GfxCubemap*> cubemaps;
-  DynamicArray<GfxShader*> shaders;
-  DynamicArray<AudioBufferID> audio_buffers;
-  
-  DynamicArray<Mesh*> meshes;
-  DynamicArray<Material*> materials;
-  DynamicArray<ShaderContext*> shader_contexts;
-  DynamicArray<Skybox*> skyboxes;
-  DynamicArray<Model*> models;
-  DynamicArray<Skeleton*> skeletons;
-  DynamicArray<Animation*> animations;
-  DynamicArray<Font*> fonts;
+  bool is_active = false;
+
+  ResourceTable<GfxBuffer*> buffers;
+  ResourceTable<GfxTexture*> textures;
+  ResourceTable<GfxCubemap*> cubemaps;
+  ResourceTable<GfxShader*> shaders;
+  ResourceTable<AudioBufferID> audio_buffers;
+  
+  ResourceTable<Mesh*> meshes;
+  ResourceTable<Material*> materials;
+  ResourceTable<ShaderContext*> shader_contexts;
+  ResourceTable<Skybox*> skyboxes;
+  ResourceTable<Model*> models;
+  ResourceTable<Skeleton*> skeletons;
+  ResourceTable<Animation*> animations;
+  ResourceTable<Font*> fonts;
 
   HashMap<String, ResourceID> named_ids;
+
+  ResourceMemoryInfo memory_info = {};
 };
 /// ResourceGroup 
 /// ----------------------------------------------------------------------
@@ -38,7 +89,16 @@ struct ResourceGroup {
 /// ----------------------------------------------------------------------
 /// ResourceManager 
 struct ResourceManager {
-  HashMap<ResourceGroupID, ResourceGroup> groups;
+  // @NOTE: The ID of each group is its index into this array. 
+  // Destroyed groups are never reused, so their IDs stay invalid.
+  DynamicArray<ResourceGroup> groups;
+
+  /// The memory budget of each resource type across all groups. 
+  /// A budget of `0` means there is no budget at all.
+  sizei budgets[RESOURCE_TYPES_MAX]     = {};
+  sizei total_bytes[RESOURCE_TYPES_MAX] = {};
+
+  u64 frame_index = 1;
 };
 
 static ResourceManager s_manager;
@@ -49,22 +109,23 @@ static ResourceManager s_manager;
 /// Macros (Unfortunately)
 
 #define DESTROY_CORE_RESOURCE_MAP(group, map, clear_func) { \
-  for(auto& res : group->map) {                             \
-    clear_func(res);                                        \
-  }                                                         \
+  for(sizei i = 0; i < group->map.slots.size(); i++) {     \
+    if(group->map.slots[i].is_alive) {                     \
+      clear_func(group->map.resources[i]);                 \
+    }                                                      \
+  }                                                        \
 }
 
-#define DESTROY_COMP_RESOURCE_MAP(group, map) { \
-  for(auto& res : group->map) {                 \
-    delete res;                                 \
-  }                                             \
+#define DESTROY_COMP_RESOURCE_MAP(group, map) {          \
+  for(sizei i = 0; i < group->map.slots.size(); i++) { \
+    if(group->map.slots[i].is_alive) {                 \
+      delete group->map.resources[i];                  \
+    }                                                  \
+  }                                                    \
 }
 
 #define PUSH_RESOURCE(group, resources, res, type, res_id) { \
-  group->resources.push_back(res);                           \
-  res_id._type = type;                                       \
-  res_id._id   = (u16)group->resources.size() - 1;           \
-  res_id.group = group->id;                                  \
+  res_id = push_resource(group, group->resources, res, type); \
 }
 
 #define GROUP_CHECK(group_id) NIKOLA_ASSERT((group_id != RESOURCE_GROUP_INVALID), "Cannot push a resource to an invalid group")
@@ -157,13 +218,455 @@ static const char* audio_format_str(const AudioBufferFormat format) {
   }
 }
 
+static ResourceGroup* get_group(const ResourceGroupID& group_id) {
+  NIKOLA_ASSERT((group_id < (ResourceGroupID)s_manager.groups.size()), "Invalid resource group ID");
+  
+  ResourceGroup* group = &s_manager.groups[group_id];
+  NIKOLA_ASSERT(group->is_active, "Cannot use a resource group that was already destroyed");
+
+  return group;
+}
+
+static ResourceTableBase* get_table(ResourceGroup* group, const ResourceType type) {
+  switch(type) {
+    case RESOURCE_TYPE_BUFFER:
+      return &group->buffers;
+    case RESOURCE_TYPE_TEXTURE:
+      return &group->textures;
+    case RESOURCE_TYPE_CUBEMAP:
+      return &group->cubemaps;
+    case RESOURCE_TYPE_SHADER:
+      return &group->shaders;
+    case RESOURCE_TYPE_MESH:
+      return &group->meshes;
+    case RESOURCE_TYPE_MATERIAL:
+      return &group->materials;
+    case RESOURCE_TYPE_SKYBOX:
+      return &group->skyboxes;
+    case RESOURCE_TYPE_MODEL:
+      return &group->models;
+    case RESOURCE_TYPE_SKELETON:
+      return &group->skeletons;
+    case RESOURCE_TYPE_ANIMATION:
+      return &group->animations;
+    case RESOURCE_TYPE_FONT:
+      return &group->fonts;
+    case RESOURCE_TYPE_SHADER_CONTEXT:
+      return &group->shader_contexts;
+    case RESOURCE_TYPE_AUDIO_BUFFER:
+      return &group->audio_buffers;
+    default:
+      return nullptr;
+  }
+}
+
+static ResourceSlot* find_slot(const ResourceID& id) {
+  // @NOTE: Unlike `get_resource`, this function does not assert, since it's 
+  // perfectly valid to release a resource whose group was already cleared.
+  
+  if(!RESOURCE_IS_VALID(id) || id.group >= (ResourceGroupID)s_manager.groups.size()) {
+    return nullptr;
+  }
+
+  ResourceGroup* group = &s_manager.groups[id.group];
+  if(!group->is_active) {
+    return nullptr;
+  }
+
+  ResourceTableBase* table = get_table(group, id._type);
+  if(!table || id._id >= (u16)table->slots.size()) {
+    return nullptr;
+  }
+
+  ResourceSlot* slot = &table->slots[id._id];
+  if(!slot->is_alive || slot->generation != id._generation) {
+    return nullptr;
+  }
+
+  return slot;
+}
+
+static sizei texture_format_size(const GfxTextureFormat format) {
+  switch(format) {
+    case GFX_TEXTURE_FORMAT_R8:
+    case GFX_TEXTURE_FORMAT_STENCIL8:
+      return 1;
+    case GFX_TEXTURE_FORMAT_R16:
+    case GFX_TEXTURE_FORMAT_R16F:
+    case GFX_TEXTURE_FORMAT_RG8:
+    case GFX_TEXTURE_FORMAT_DEPTH16:
+      return 2;
+    case GFX_TEXTURE_FORMAT_DEPTH24:
+      return 3;
+    case GFX_TEXTURE_FORMAT_R32F:
+    case GFX_TEXTURE_FORMAT_RG16:
+    case GFX_TEXTURE_FORMAT_RG16F:
+    case GFX_TEXTURE_FORMAT_RGBA8:
+    case GFX_TEXTURE_FORMAT_DEPTH32F:
+    case GFX_TEXTURE_FORMAT_DEPTH_STENCIL_24_8:
+      return 4;
+    case GFX_TEXTURE_FORMAT_RG32F:
+    case GFX_TEXTURE_FORMAT_RGBA16:
+    case GFX_TEXTURE_FORMAT_RGBA16F:
+      return 8;
+    case GFX_TEXTURE_FORMAT_RGBA32F:
+      return 16;
+    default:
+      return 4;
+  }
+}
+
+static sizei texture_memory_size(GfxTexture* texture) {
+  GfxTextureDesc& desc = gfx_texture_get_desc(texture);
+  return desc.width * desc.height * glm::max(desc.depth, 1u) * texture_format_size(desc.format);
+}
+
+static sizei cubemap_memory_size(GfxCubemap* cubemap) {
+  GfxCubemapDesc& desc = gfx_cubemap_get_desc(cubemap);
+  return desc.width * desc.height * desc.faces_count * texture_format_size(desc.format);
+}
+
+static sizei mesh_memory_size(const Mesh* mesh) {
+  return (mesh->vertices.size() * sizeof(f32)) + (mesh->indices.size() * sizeof(u32));
+}
+
+static void track_memory(ResourceGroup* group, const ResourceID& id, const sizei cpu_bytes, const sizei gpu_bytes) {
+  ResourceSlot* slot       = &get_table(group, id._type)->slots[id._id];
+  ResourceMemoryInfo* info = &group->memory_info;
+
+  // Remove the old sizes first...
+
+  info->cpu_bytes[id._type]         -= slot->cpu_bytes;
+  info->gpu_bytes[id._type]         -= slot->gpu_bytes;
+  s_manager.total_bytes[id._type]   -= (slot->cpu_bytes + slot->gpu_bytes);
+
+  // ...and then add the new ones
+  
+  slot->cpu_bytes = cpu_bytes;
+  slot->gpu_bytes = gpu_bytes;
+  
+  info->cpu_bytes[id._type]         += slot->cpu_bytes;
+  info->gpu_bytes[id._type]         += slot->gpu_bytes;
+  s_manager.total_bytes[id._type]   += (slot->cpu_bytes + slot->gpu_bytes);
+}
+
+static void track_mesh_memory(ResourceGroup* group, const ResourceID& id, const Mesh* mesh) {
+  // @NOTE: Meshes do not own any GPU buffers. Their data gets copied as is into the 
+  // vertex and index buffers of the renderer, taking up the same size there as well.
+
+  sizei size = mesh_memory_size(mesh);
+  track_memory(group, id, size, size);
+}
+
+static void compute_mesh_bounds(Mesh* mesh, const sizei stride) {
+  mesh->bounds = Vec4(0.0f);
+  if(mesh->vertices.empty() || stride == 0) {
+    return;
+  }
+
+  // @NOTE: The position is always the first attribute of every vertex
+
+  Vec3 min = Vec3(FLOAT_MAX);
+  Vec3 max = Vec3(-FLOAT_MAX);
+
+  for(sizei i = 0; (i + 2) < mesh->vertices.size(); i += stride) {
+    Vec3 pos = Vec3(mesh->vertices[i + 0], mesh->vertices[i + 1], mesh->vertices[i + 2]);
+
+    min = vec3_min(min, pos);
+    max = vec3_max(max, pos);
+  }
+
+  Vec3 center  = (min + max) * 0.5f;
+  mesh->bounds = Vec4(center, vec3_distance(center, max));
+}
+
+static sizei geometry_vertex_stride(const GeometryType type) {
+  // @NOTE: This has to match the layouts in `geometry_loader_set_vertex_layout`
+
+  switch(type) {
+    case GEOMETRY_CUBE:
+    case GEOMETRY_SPHERE:
+      return vertex_get_components_count(VERTEX_COMPONENT_POSITION | 
+                                         VERTEX_COMPONENT_NORMAL | 
+                                         VERTEX_COMPONENT_TANGENT | 
+                                         VERTEX_COMPONENT_JOINT_ID | 
+                                         VERTEX_COMPONENT_JOINT_WEIGHT | 
+                                         VERTEX_COMPONENT_TEXTURE_COORDS);
+    case GEOMETRY_SKYBOX:
+      return vertex_get_components_count(VERTEX_COMPONENT_POSITION);
+    case GEOMETRY_QUAD:
+      return vertex_get_components_count(VERTEX_COMPONENT_POSITION | VERTEX_COMPONENT_TEXTURE_COORDS);
+    case GEOMETRY_SIMPLE_CUBE:
+    case GEOMETRY_SIMPLE_SPHERE:
+      return vertex_get_components_count(VERTEX_COMPONENT_POSITION | 
+                                         VERTEX_COMPONENT_NORMAL | 
+                                         VERTEX_COMPONENT_TEXTURE_COORDS);
+    default:
+      return 0;
+  }
+}
+
+static void add_dependency(ResourceGroup* group, const ResourceID& owner_id, const ResourceID& dep_id) {
+  if(!RESOURCE_IS_VALID(dep_id)) {
+    return;
+  }
+
+  resources_acquire(dep_id);
+  get_table(group, owner_id._type)->slots[owner_id._id].dependencies.push_back(dep_id);
+}
+
 template<typename T> 
-static T get_resource(const ResourceID& id, DynamicArray<T>& res, const ResourceType type) {
+static ResourceID push_resource(ResourceGroup* group, ResourceTable<T>& table, const T& res, const ResourceType type) {
+  // Reuse any freed slots first
+
+  u16 index = 0;
+  if(!table.free_slots.empty()) {
+    index = table.free_slots.back();
+    table.free_slots.pop_back();
+
+    table.resources[index] = res;
+  }
+  else {
+    table.slots.push_back(ResourceSlot{});
+    table.resources.push_back(res);
+
+    index = (u16)table.slots.size() - 1;
+  }
+
+  ResourceSlot* slot = &table.slots[index];
+  slot->is_alive     = true;
+  slot->ref_count    = 0;
+  slot->last_used    = s_manager.frame_index;
+
+  group->memory_info.resources_count[type]++;
+
+  return ResourceID {
+    ._type       = type, 
+    ._id         = index, 
+    ._generation = slot->generation,
+    .group       = group->id,
+  };
+}
+
+template<typename T> 
+static T get_resource(const ResourceID& id, ResourceTable<T>& table, const ResourceType type) {
   NIKOLA_ASSERT((id._type == type), "Invalid type when trying to retrieve a resource");
-  NIKOLA_ASSERT((id._id >= 0 && id._id <= (u16)res.size()), "Invalid ID when trying to retrieve a resource");
-  NIKOLA_ASSERT(RESOURCE_IS_VALID(id), "Cannot retrieve a resource from an invalid group");
+  NIKOLA_ASSERT((id._id < (u16)table.slots.size()), "Invalid ID when trying to retrieve a resource");
+  
+  // @NOTE: With a memory budget, any resource that was never acquired can be evicted 
+  // at any point. Stale IDs are therefore expected, and should not bring the whole app down.
+
+  ResourceSlot& slot = table.slots[id._id];
+  if(!slot.is_alive || slot.generation != id._generation) {
+    NIKOLA_LOG_DEBUG("Trying to retrieve a stale resource that was already cleared or evicted");
+    return T{};
+  }
 
-  return res[id._id];
+  slot.last_used = s_manager.frame_index;
+  return table.resources[id._id];
+}
+
+static void free_slot(ResourceGroup* group, const ResourceType type, const u16 index) {
+  ResourceTableBase* table = get_table(group, type);
+  ResourceSlot* slot       = &table->slots[index];
+
+  // Let go of any resources this resource was holding on to
+
+  for(auto& dep : slot->dependencies) {
+    resources_release(dep);
+  }
+  slot->dependencies.clear();
+
+  // No more memory consumed
+
+  track_memory(group, ResourceID{._type = type, ._id = index, ._generation = slot->generation, .group = group->id}, 0, 0);
+  group->memory_info.resources_count[type]--;
+
+  // Every time a slot gets freed, it gets a new generation, 
+  // making any previous IDs pointing to it stale.
+
+  slot->is_alive  = false;
+  slot->ref_count = 0;
+  slot->generation++;
+
+  table->free_slots.push_back(index);
+}
+
+static void clear_table(ResourceGroup* group, const ResourceType type) {
+  ResourceTableBase* table = get_table(group, type);
+
+  for(i32 i = (i32)table->slots.size() - 1; i >= 0; i--) {
+    if(table->slots[i].is_alive) {
+      free_slot(group, type, (u16)i);
+    }
+  }
+}
+
+static void destroy_group_resources(ResourceGroup* group) {
+  // Destroy compound resources
+  
+  DESTROY_COMP_RESOURCE_MAP(group, meshes);
+  DESTROY_COMP_RESOURCE_MAP(group, materials);
+  DESTROY_COMP_RESOURCE_MAP(group, shader_contexts);
+  DESTROY_COMP_RESOURCE_MAP(group, skyboxes);
+  DESTROY_COMP_RESOURCE_MAP(group, models);
+  DESTROY_COMP_RESOURCE_MAP(group, fonts);
+
+  // Destroy core resources
+  
+  DESTROY_CORE_RESOURCE_MAP(group, buffers, gfx_buffer_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, textures, gfx_texture_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, cubemaps, gfx_cubemap_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, shaders, gfx_shader_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, audio_buffers, audio_buffer_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, skeletons, skeleton_destroy);
+  DESTROY_CORE_RESOURCE_MAP(group, animations, animation_destroy);
+
+  // Free all the slots 
+  
+  for(i32 type = RESOURCE_TYPE_BUFFER; type < RESOURCE_TYPES_MAX; type++) {
+    clear_table(group, (ResourceType)type);
+  }
+
+  // All the named IDs are stale now
+  group->named_ids.clear();
+}
+
+static bool is_evictable_type(const ResourceType type) {
+  return type == RESOURCE_TYPE_TEXTURE || 
+         type == RESOURCE_TYPE_MESH    || 
+         type == RESOURCE_TYPE_AUDIO_BUFFER;
+}
+
+static void evict_resource(ResourceGroup* group, const ResourceType type, const u16 index) {
+  switch(type) {
+    case RESOURCE_TYPE_TEXTURE:
+      gfx_texture_destroy(group->textures.resources[index]);
+      break;
+    case RESOURCE_TYPE_MESH:
+      delete group->meshes.resources[index];
+      break;
+    case RESOURCE_TYPE_AUDIO_BUFFER:
+      audio_buffer_destroy(group->audio_buffers.resources[index]);
+      break;
+    default:
+      return;
+  }
+
+  // Named IDs should not point to evicted resources
+
+  for(auto it = group->named_ids.begin(); it != group->named_ids.end();) {
+    if(it->second._type == type && it->second._id == index) {
+      it = group->named_ids.erase(it);
+      continue;
+    }
+
+    it++;
+  }
+
+  free_slot(group, type, index);
+}
+
+static void enforce_budget(const ResourceType type) {
+  sizei budget = s_manager.budgets[type];
+  if(budget == 0 || s_manager.total_bytes[type] <= budget) {
+    return;
+  }
+
+  // Collect any unreferenced resources that were not used this frame. 
+  //
+  // @NOTE: Resources in the cache are used internally by raw pointers, 
+  // so they can never be evicted.
+
+  struct EvictEntry {
+    ResourceGroupID group_id; 
+    u16 index;
+    u64 last_used;
+  };
+  DynamicArray<EvictEntry> entries;
+
+  for(auto& group : s_manager.groups) {
+    if(!group.is_active || group.id == RESOURCE_CACHE_ID) {
+      continue;
+    }
+
+    ResourceTableBase* table = get_table(&group, type);
+    for(sizei i = 0; i < table->slots.size(); i++) {
+      ResourceSlot* slot = &table->slots[i];
+      if(!slot->is_alive || slot->ref_count > 0 || slot->last_used >= s_manager.frame_index) {
+        continue;
+      }
+
+      entries.push_back(EvictEntry{group.id, (u16)i, slot->last_used});
+    }
+  }
+
+  // Least-recently-used first
+
+  std::sort(entries.begin(), entries.end(), [](const EvictEntry& e1, const EvictEntry& e2) {
+    return e1.last_used < e2.last_used;
+  });
+
+  sizei evicted_count = 0;
+  for(auto& entry : entries) {
+    if(s_manager.total_bytes[type] <= budget) {
+      break;
+    }
+
+    evict_resource(&s_manager.groups[entry.group_id], type, entry.index);
+    evicted_count++;
+  }
+
+  NIKOLA_LOG_DEBUG("Evicted %zu resources to fit into the budget (%zu/%zu bytes)", 
+                   evicted_count, s_manager.total_bytes[type], budget);
+
+  if(s_manager.total_bytes[type] > budget) {
+    NIKOLA_LOG_WARN("Resources still exceed the memory budget (%zu/%zu bytes) with nothing left to evict", 
+                    s_manager.total_bytes[type], budget);
+  }
+}
+
+static GfxTextureDesc model_texture_desc(const NBRTexture* nbr_texture) {
+  GfxTextureDesc desc; 
+  desc.format    = GFX_TEXTURE_FORMAT_RGBA8; 
+  desc.filter    = GFX_TEXTURE_FILTER_MIN_MAG_LINEAR; 
+  desc.wrap_mode = GFX_TEXTURE_WRAP_CLAMP;
+  desc.width     = nbr_texture->width; 
+  desc.height    = nbr_texture->height; 
+  desc.depth     = 0; 
+  desc.mips      = 1; 
+  desc.type      = GFX_TEXTURE_2D; 
+  desc.data      = nbr_texture->pixels;
+
+  return desc;
+}
+
+static void free_model_nbr(NBRModel& nbr_model) {
+  for(sizei i = 0; i < nbr_model.textures_count; i++) {
+    memory_free(nbr_model.textures[i].pixels);
+  }
+
+  memory_free(nbr_model.meshes);
+  memory_free(nbr_model.materials);
+  memory_free(nbr_model.textures);
+}
+
+static void free_animation_nbr(NBRAnimation& nbr_anim) {
+  for(u16 i = 0; i < nbr_anim.tracks_count; i++) {
+    if(nbr_anim.tracks[i].position_samples) {
+      memory_free(nbr_anim.tracks[i].position_samples);
+    }
+
+    if(nbr_anim.tracks[i].rotation_samples) {
+      memory_free(nbr_anim.tracks[i].rotation_samples);
+    }
+
+    if(nbr_anim.tracks[i].scale_samples) {
+      memory_free(nbr_anim.tracks[i].scale_samples);
+    }
+  } 
+
+  memory_free(nbr_anim.tracks);
 }
 
 static bool load_texture_nbr(ResourceGroup* group, GfxTexture* texture, const FilePath& nbr_path) {
@@ -325,6 +828,7 @@ static void load_mesh_nbr(ResourceGroup* group, Mesh* mesh, NBRMesh& nbr_mesh) {
   mesh->indices.assign(nbr_mesh.indices, nbr_mesh.indices + nbr_mesh.indices_count);
   
   mesh->material_index = nbr_mesh.material_index;
+  compute_mesh_bounds(mesh, vertex_get_components_count(nbr_mesh.vertex_component_bits));
 
   // Freeing NBR data
   
@@ -332,7 +836,7 @@ static void load_mesh_nbr(ResourceGroup* group, Mesh* mesh, NBRMesh& nbr_mesh) {
   memory_free(nbr_mesh.indices);
 }
 
-static bool load_model_nbr(ResourceGroup* group, Model* model, const FilePath& nbr_path) {
+static bool load_model_nbr(ResourceGroup* group, Model* model, const FilePath& nbr_path, DynamicArray<ResourceID>& out_deps) {
   //
   // Load the NBR model
   // 
@@ -359,19 +863,7 @@ static bool load_model_nbr(ResourceGroup* group, Model* model, const FilePath& n
   // Convert the textures
   
   for(sizei i = 0; i < nbr_model.textures_count; i++) {
-    NBRTexture* nbr_texture = &nbr_model.textures[i];
-
-    GfxTextureDesc desc; 
-    desc.format    = GFX_TEXTURE_FORMAT_RGBA8; 
-    desc.filter    = GFX_TEXTURE_FILTER_MIN_MAG_LINEAR; 
-    desc.wrap_mode = GFX_TEXTURE_WRAP_CLAMP;
-    desc.width     = nbr_texture->width; 
-    desc.height    = nbr_texture->height; 
-    desc.depth     = 0; 
-    desc.mips      = 1; 
-    desc.type      = GFX_TEXTURE_2D; 
-    desc.data      = nbr_texture->pixels;
-  
+    GfxTextureDesc desc = model_texture_desc(&nbr_model.textures[i]);
     texture_ids.push_back(resources_push_texture(group->id, desc));
   }
   
@@ -380,61 +872,201 @@ static bool load_model_nbr(ResourceGroup* group, Model* model, const FilePath& n
   for(sizei i = 0; i < nbr_model.materials_count; i++) {
     NBRMaterial* nbr_mat = &nbr_model.materials[i];
 
-    Vec3 color = Vec3(nbr_mat->color[0], 
-                      nbr_mat->color[1], 
-                      nbr_mat->color[2]);
-    
-    i8 albedo_index    = nbr_mat->albedo_index;
-    i8 roughness_index = nbr_mat->roughness_index;
-    i8 metallic_index  = nbr_mat->metallic_index;
-    i8 normal_index    = nbr_mat->normal_index;
-    i8 emissive_index  = nbr_mat->emissive_index;
+    Vec3 color = Vec3(nbr_mat->color[0], 
+                      nbr_mat->color[1], 
+                      nbr_mat->color[2]);
+    
+    i8 albedo_index    = nbr_mat->albedo_index;
+    i8 roughness_index = nbr_mat->roughness_index;
+    i8 metallic_index  = nbr_mat->metallic_index;
+    i8 normal_index    = nbr_mat->normal_index;
+    i8 emissive_index  = nbr_mat->emissive_index;
+
+    MaterialDesc mat_desc = {
+      .albedo_id    = albedo_index    != -1 ? texture_ids[albedo_index]    : ResourceID{}, 
+      .roughness_id = roughness_index != -1 ? texture_ids[roughness_index] : ResourceID{},
+      .metallic_id  = metallic_index  != -1 ? texture_ids[metallic_index]  : ResourceID{},
+      .normal_id    = normal_index    != -1 ? texture_ids[normal_index]    : ResourceID{},
+      .emissive_id  = emissive_index  != -1 ? texture_ids[emissive_index]  : ResourceID{},
+
+      .color     = color,
+      .roughness = nbr_mat->roughness, 
+      .metallic  = nbr_mat->metallic, 
+      .emissive  = nbr_mat->emissive,
+    };
+    ResourceID mat_id = resources_push_material(group->id, mat_desc);
+
+    model->materials.push_back(resources_get_material(mat_id)); 
+    out_deps.push_back(mat_id);
+  }
+  
+  // Convert the meshes 
+  
+  for(sizei i = 0; i < nbr_model.meshes_count; i++) {
+    ResourceID mesh_id = resources_push_mesh(group->id, nbr_model.meshes[i]);
+
+    model->meshes.push_back(resources_get_mesh(mesh_id));
+    out_deps.push_back(mesh_id);
+  }
+
+  // Freeing NBR data
+
+  free_model_nbr(nbr_model);
+  file_close(file); 
+
+  // Some useful info dump
+
+  NIKOLA_LOG_DEBUG("Group \'%s\' pushed model:", group->name.c_str());
+  NIKOLA_LOG_DEBUG("     Meshes    = %zu", model->meshes.size());
+  NIKOLA_LOG_DEBUG("     Materials = %zu", model->materials.size());
+  NIKOLA_LOG_DEBUG("     Textures  = %i", nbr_model.textures_count);
+  NIKOLA_LOG_DEBUG("     Path      = %s", nbr_path.c_str());
+  
+  // done!
+  return true;
+}
+
+static void reload_material_map(ResourceGroup* group, 
+                                GfxTexture** map, 
+                                GfxTexture* default_map, 
+                                const i8 texture_index, 
+                                const NBRModel& nbr_model, 
+                                DynamicArray<ResourceID>& out_deps) {
+  // The map was removed from the material
+
+  if(texture_index == -1) {
+    *map = default_map;
+    return;
+  }
+
+  // Reload the texture in place if the material already owns one. 
+  // Otherwise, the material gets a brand new texture.
+
+  GfxTextureDesc desc = model_texture_desc(&nbr_model.textures[texture_index]);
+
+  if(*map != default_map) {
+    gfx_texture_reload(*map, desc);
+    return;
+  }
+    
+  ResourceID texture_id = resources_push_texture(group->id, desc);
+  
+  *map = resources_get_texture(texture_id);
+  out_deps.push_back(texture_id);
+}
+
+static bool reload_model_nbr(ResourceGroup* group, Model* model, const FilePath& nbr_path, DynamicArray<ResourceID>& out_deps) {
+  //
+  // Load the NBR model
+  // 
+ 
+  File file;
+  if(!nbr_file_is_valid(file, filepath_append(group->parent_dir, nbr_path), RESOURCE_TYPE_MODEL)) {
+    return false;
+  }
+
+  NBRModel nbr_model;
+  file_read_bytes(file, &nbr_model);
+
+  //
+  // Update the materials in place
+  //
+
+  const RendererDefaults& defaults = renderer_get_defaults();
+
+  for(sizei i = 0; i < nbr_model.materials_count; i++) {
+    NBRMaterial* nbr_mat = &nbr_model.materials[i];
+
+    // A new material was added to the model
+
+    if(i >= model->materials.size()) {
+      MaterialDesc mat_desc = {
+        .color     = Vec3(nbr_mat->color[0], nbr_mat->color[1], nbr_mat->color[2]),
+        .roughness = nbr_mat->roughness, 
+        .metallic  = nbr_mat->metallic, 
+        .emissive  = nbr_mat->emissive,
+      };
+      
+      ResourceID mat_id = resources_push_material(group->id, mat_desc);
+
+      model->materials.push_back(resources_get_material(mat_id)); 
+      out_deps.push_back(mat_id);
+    }
+
+    Material* material = model->materials[i];
+
+    material->color     = Vec3(nbr_mat->color[0], nbr_mat->color[1], nbr_mat->color[2]);
+    material->roughness = nbr_mat->roughness;
+    material->metallic  = nbr_mat->metallic;
+    material->emissive  = nbr_mat->emissive;
 
-    MaterialDesc mat_desc = {
-      .albedo_id    = albedo_index    != -1 ? texture_ids[albedo_index]    : ResourceID{}, 
-      .roughness_id = roughness_index != -1 ? texture_ids[roughness_index] : ResourceID{},
-      .metallic_id  = metallic_index  != -1 ? texture_ids[metallic_index]  : ResourceID{},
-      .normal_id    = normal_index    != -1 ? texture_ids[normal_index]    : ResourceID{},
-      .emissive_id  = emissive_index  != -1 ? texture_ids[emissive_index]  : ResourceID{},
+    reload_material_map(group, &material->albedo_map, defaults.albedo_texture, nbr_mat->albedo_index, nbr_model, out_deps);
+    reload_material_map(group, &material->roughness_map, defaults.roughness_texture, nbr_mat->roughness_index, nbr_model, out_deps);
+    reload_material_map(group, &material->metallic_map, defaults.metallic_texture, nbr_mat->metallic_index, nbr_model, out_deps);
+    reload_material_map(group, &material->normal_map, defaults.normal_texture, nbr_mat->normal_index, nbr_model, out_deps);
+    reload_material_map(group, &material->emissive_map, defaults.emissive_texture, nbr_mat->emissive_index, nbr_model, out_deps);
 
-      .color     = color,
-      .roughness = nbr_mat->roughness, 
-      .metallic  = nbr_mat->metallic, 
-      .emissive  = nbr_mat->emissive,
-    };
-    ResourceID mat_id = resources_push_material(group->id, mat_desc);
+    // Re-evaluate the flags, since maps could have been added or removed
 
-    model->materials.push_back(resources_get_material(mat_id)); 
+    material->map_flags = 0;
+    
+    if(nbr_mat->albedo_index != -1) {
+      SET_BIT(material->map_flags, MATERIAL_TEXTURE_ALBEDO);
+    }
+    
+    if(nbr_mat->roughness_index != -1) {
+      SET_BIT(material->map_flags, MATERIAL_TEXTURE_ROUGHNESS);
+    }
+    
+    if(nbr_mat->metallic_index != -1) {
+      SET_BIT(material->map_flags, MATERIAL_TEXTURE_METALLIC);
+    }
+    
+    if(nbr_mat->normal_index != -1) {
+      SET_BIT(material->map_flags, MATERIAL_TEXTURE_NORMAL);
+    }
+    
+    if(nbr_mat->emissive_index != -1) {
+      SET_BIT(material->map_flags, MATERIAL_TEXTURE_EMISSIVE);
+    }
   }
-  
-  // Convert the meshes 
-  
+
+  //
+  // Update the meshes in place
+  //
+
   for(sizei i = 0; i < nbr_model.meshes_count; i++) {
+    if(i < model->meshes.size()) {
+      load_mesh_nbr(group, model->meshes[i], nbr_model.meshes[i]);
+      continue;
+    }
+
     ResourceID mesh_id = resources_push_mesh(group->id, nbr_model.meshes[i]);
+
     model->meshes.push_back(resources_get_mesh(mesh_id));
+    out_deps.push_back(mesh_id);
   }
 
-  // Freeing NBR data
+  // Any extra meshes are still owned by the group. 
+  // The model just won't render them anymore.
 
-  for(sizei i = 0; i < nbr_model.textures_count; i++) {
-    memory_free(nbr_model.textures[i].pixels);
+  if(nbr_model.meshes_count < model->meshes.size()) {
+    model->meshes.resize(nbr_model.meshes_count);
   }
 
-  memory_free(nbr_model.meshes);
-  memory_free(nbr_model.materials);
-  memory_free(nbr_model.textures);
-  
+  // Freeing NBR data
+
+  free_model_nbr(nbr_model);
   file_close(file); 
 
   // Some useful info dump
 
-  NIKOLA_LOG_DEBUG("Group \'%s\' pushed model:", group->name.c_str());
+  NIKOLA_LOG_DEBUG("Group \'%s\' reloaded model:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Meshes    = %zu", model->meshes.size());
   NIKOLA_LOG_DEBUG("     Materials = %zu", model->materials.size());
-  NIKOLA_LOG_DEBUG("     Textures  = %i", nbr_model.textures_count);
   NIKOLA_LOG_DEBUG("     Path      = %s", nbr_path.c_str());
-  
-  // done!
+
+  // Done!
   return true;
 }
 
@@ -467,7 +1099,7 @@ static bool load_animation_nbr(ResourceGroup* group, NBRAnimation* out_anim, con
   return true;
 }
 
-static bool load_font_nbr(ResourceGroup* group, Font* font, const FilePath& nbr_path) {
+static bool load_font_nbr(ResourceGroup* group, Font* font, const FilePath& nbr_path, DynamicArray<ResourceID>& out_deps) {
   // 
   // Load the NBR file 
   //
@@ -525,10 +1157,23 @@ static bool load_font_nbr(ResourceGroup* group, Font* font, const FilePath& nbr_
       .filter    = GFX_TEXTURE_FILTER_MIN_MAG_LINEAR, 
       .wrap_mode = GFX_TEXTURE_WRAP_CLAMP,
 
-      .is_bindless = false,
+      .is_bindless = true, // The batch renderer references glyphs by their handles
       .data        = (void*)nbr_glyph->pixels,
     };
-    glyph.texture = resources_get_texture(resources_push_texture(group->id, face_desc));
+    
+    // Reloading an existing glyph will reuse its texture
+
+    auto existing_glyph = font->glyphs.find(glyph.codepoint);
+    if(existing_glyph != font->glyphs.end() && existing_glyph->second.texture) {
+      glyph.texture = existing_glyph->second.texture;
+      gfx_texture_reload(glyph.texture, face_desc);
+    }
+    else {
+      ResourceID texture_id = resources_push_texture(group->id, face_desc);
+      
+      glyph.texture = resources_get_texture(texture_id);
+      out_deps.push_back(texture_id);
+    }
 
     font->glyphs[glyph.codepoint] = glyph;
   }
@@ -581,11 +1226,9 @@ static bool load_audio_nbr(ResourceGroup* group, AudioBufferDesc* desc, const Fi
   desc->size        = nbr_audio.size;
   desc->data        = (void*)nbr_audio.samples;
 
-  // 
-  // Freeing NBR data
-  // 
-
-  memory_free(nbr_audio.samples);
+  // @NOTE: The samples are owned by `desc` from now on, and 
+  // should be freed by the caller once they are uploaded.
+  
   file_close(file); 
  
   // Some useful info dump
@@ -656,65 +1299,124 @@ static void resource_entry_iterate(const FilePath& base, const FilePath& path, v
   }
 }
 
+static void reload_shader_contexts(const GfxShader* shader) {
+  // @NOTE: Contexts can live in any group, not just the group of their shader.
+
+  for(auto& group : s_manager.groups) {
+    if(!group.is_active) {
+      continue;
+    }
+
+    ResourceTable<ShaderContext*>& table = group.shader_contexts;
+    for(sizei i = 0; i < table.slots.size(); i++) {
+      if(table.slots[i].is_alive && table.resources[i]->shader == shader) {
+        shader_context_reload(table.resources[i]);
+      }
+    }
+  }
+}
+
 static void resource_entry_update(const FileStatus status, const FilePath& path, void* user_data) {
-  // We only care if the resource was modified 
+  // Deleted resources stay alive until their group gets destroyed. 
+  // Otherwise, any references to them would be left dangling.
   
-  if(status != FILE_STATUS_MODIFIED) {
+  if(status == FILE_STATUS_DELETED) {
     return;
   }
+
+  // We only care about NBR files
   
-  // Load the NBR header
-  
-  File file;
-  NBRHeader header;
-  
-  if(!file_open(&file, path, (i32)(FILE_OPEN_READ | FILE_OPEN_BINARY))) {
-    NIKOLA_LOG_ERROR("Cannot load NBR file at \'%s\'", path.c_str());
+  if(filepath_is_dir(path) || filepath_extension(path) != ".nbr") {
+    return;
+  }
 
-    file_close(file);
+  // The group might have been destroyed while its directory was still being watched
+  
+  ResourceGroupID group_id = (ResourceGroupID)(uintptr_t)user_data;
+  if(!s_manager.groups[group_id].is_active) {
     return;
   }
 
-  file_read_bytes(file, &header);
-  file_close(file);
+  ResourceGroup* group = &s_manager.groups[group_id];
  
-  // Get the stem of the path to identify the resource
+  // A new resource was added to the group's directory. Just push it like any other.
   
   FilePath filename = filepath_stem(path); 
+  auto named_id     = group->named_ids.find(filename);
 
-  ResourceGroup* group = (ResourceGroup*)user_data;
-  ResourceID res_id    = resources_get_id(group->id, filename);
+  if(named_id == group->named_ids.end()) {
+    resource_entry_iterate(filepath_parent_path(path), path, group);
+    return;
+  }
+  
+  ResourceID res_id = named_id->second;
+  DynamicArray<ResourceID> new_deps; 
 
-  // Reload the the resource based on its type
+  // Reload the the resource in place based on its type. 
+  // That way, any references to the resource will still be valid.
   
-  switch (header.resource_type) {
-    case RESOURCE_TYPE_TEXTURE:
-      load_texture_nbr(group, resources_get_texture(res_id), path);
-      break;
-    case RESOURCE_TYPE_CUBEMAP:
-      load_cubemap_nbr(group, resources_get_cubemap(res_id), path);
-      break;
-    case RESOURCE_TYPE_SHADER:
-      load_shader_nbr(group, resources_get_shader(res_id), path);
-      break;
+  switch (res_id._type) {
+    case RESOURCE_TYPE_TEXTURE: {
+      GfxTexture* texture = resources_get_texture(res_id);
+      
+      load_texture_nbr(group, texture, path);
+      track_memory(group, res_id, 0, texture_memory_size(texture));
+    } break;
+    case RESOURCE_TYPE_CUBEMAP: {
+      GfxCubemap* cubemap = resources_get_cubemap(res_id);
+      
+      load_cubemap_nbr(group, cubemap, path);
+      track_memory(group, res_id, 0, cubemap_memory_size(cubemap));
+    } break;
+    case RESOURCE_TYPE_SHADER: {
+      GfxShader* shader = resources_get_shader(res_id);
+      if(!load_shader_nbr(group, shader, path)) {
+        break;
+      }
+
+      // Relinking the shader resets all of its uniforms, and could 
+      // move them around. Every context using it needs to know.
+      reload_shader_contexts(shader);
+    } break;
     case RESOURCE_TYPE_MODEL:
-      // @TODO (Resource)
-      break;
-    case RESOURCE_TYPE_ANIMATION:
-      // @TODO (Resource)
+      reload_model_nbr(group, resources_get_model(res_id), path, new_deps);
       break;
+    case RESOURCE_TYPE_ANIMATION: {
+      NBRAnimation nbr_anim;
+      if(!load_animation_nbr(group, &nbr_anim, path)) {
+        break;
+      }
+
+      animation_reload(resources_get_animation(res_id), nbr_anim);
+      free_animation_nbr(nbr_anim);
+    } break;
     case RESOURCE_TYPE_FONT:
-      // @TODO (Resource)
-      break;
-    case RESOURCE_TYPE_AUDIO_BUFFER:
-      // @TODO (Resource)
+      load_font_nbr(group, resources_get_font(res_id), path, new_deps);
       break;
+    case RESOURCE_TYPE_AUDIO_BUFFER: {
+      AudioBufferDesc desc = {};
+      if(!load_audio_nbr(group, &desc, path)) {
+        break;
+      }
+
+      AudioBufferID buffer = resources_get_audio_buffer(res_id);
+      audio_buffer_update(buffer, desc);
+      track_memory(group, res_id, desc.size, 0);
+
+      memory_free(desc.data);
+    } break;
     default:
       NIKOLA_LOG_ERROR("Unsupported resource type for reloading");
-      break;
+      return;
   }
 
-  file_close(file);
+  // Any new resources created during the reload belong to the reloaded resource
+
+  for(auto& dep : new_deps) {
+    add_dependency(group, res_id, dep);
+  }
+
+  NIKOLA_LOG_INFO("Resource group \'%s\' reloaded \'%s\'", group->name.c_str(), filename.c_str());
 }
 
 /// Callbacks
@@ -724,11 +1426,12 @@ static void resource_entry_update(const FileStatus status, const FilePath& path,
 /// Resource manager functions
 
 void resource_manager_init() {
-  s_manager.groups[RESOURCE_CACHE_ID] = ResourceGroup {
+  s_manager.groups.push_back(ResourceGroup {
     .name       = "cache", 
     .parent_dir = "resource_cache",
     .id         = RESOURCE_CACHE_ID,
-  };
+    .is_active  = true,
+  });
 
   NIKOLA_LOG_INFO("Successfully initialized the resource manager");
 }
@@ -739,12 +1442,15 @@ void resource_manager_shutdown() {
 }
 
 u16 resources_create_group(const String& name, const FilePath& parent_dir) {
-  ResourceGroupID group_id   = random_u32(RESOURCE_CACHE_ID + 1, RESOURCE_GROUP_INVALID - 1); 
-  s_manager.groups[group_id] = ResourceGroup {
+  NIKOLA_ASSERT((s_manager.groups.size() < RESOURCE_GROUP_INVALID), "Exceeded the maximum amount of resource groups");
+
+  ResourceGroupID group_id = (ResourceGroupID)s_manager.groups.size(); 
+  s_manager.groups.push_back(ResourceGroup {
     .name       = name, 
     .parent_dir = parent_dir,
     .id         = group_id,
-  };
+    .is_active  = true,
+  });
 
   // Create the parent directory if it doesn't exist
   if(!filesystem_exists(parent_dir)) {
@@ -752,7 +1458,10 @@ u16 resources_create_group(const String& name, const FilePath& parent_dir) {
   }
 
   // Add a file watcher to the parent directory
-  filewatcher_add_dir(parent_dir, resource_entry_update, &s_manager.groups[group_id]);
+  // 
+  // @NOTE: The ID is passed instead of the group itself since 
+  // the group can be destroyed before the watcher gets shutdown.
+  filewatcher_add_dir(parent_dir, resource_entry_update, (void*)(uintptr_t)group_id);
 
   NIKOLA_LOG_INFO("Successfully created a resource group \'%s\' at \'%s\'", name.c_str(), parent_dir.c_str());
   return group_id;
@@ -760,21 +1469,9 @@ u16 resources_create_group(const String& name, const FilePath& parent_dir) {
 
 void resources_clear_group(const ResourceGroupID& group_id) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
-
-  group->buffers.clear();
-  group->textures.clear();
-  group->cubemaps.clear();
-  group->shaders.clear();
-  group->audio_buffers.clear();
+  ResourceGroup* group = get_group(group_id);
 
-  group->meshes.clear();
-  group->materials.clear();
-  group->shader_contexts.clear();
-  group->skyboxes.clear();
-  group->models.clear();
-  group->animations.clear();
-  group->fonts.clear();
+  destroy_group_resources(group);
   
   NIKOLA_LOG_INFO("Resource group \'%s\' was successfully cleared", group->name.c_str());
 }
@@ -785,34 +1482,97 @@ void resources_destroy_group(const ResourceGroupID& group_id) {
     return;
   }
 
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
+  destroy_group_resources(group);
 
-  // Destroy compound resources
+  NIKOLA_LOG_INFO("Resource group \'%s\' was successfully destroyed", group->name.c_str());
   
-  DESTROY_COMP_RESOURCE_MAP(group, meshes);
-  DESTROY_COMP_RESOURCE_MAP(group, materials);
-  DESTROY_COMP_RESOURCE_MAP(group, shader_contexts);
-  DESTROY_COMP_RESOURCE_MAP(group, skyboxes);
-  DESTROY_COMP_RESOURCE_MAP(group, models);
-  DESTROY_COMP_RESOURCE_MAP(group, fonts);
-
-  // Destroy core resources
+  // The slot of the group is kept around (but inactive) so 
+  // that any IDs still pointing to it can be caught.
   
-  DESTROY_CORE_RESOURCE_MAP(group, buffers, gfx_buffer_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, textures, gfx_texture_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, cubemaps, gfx_cubemap_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, shaders, gfx_shader_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, audio_buffers, audio_buffer_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, skeletons, skeleton_destroy);
-  DESTROY_CORE_RESOURCE_MAP(group, animations, animation_destroy);
+  *group = ResourceGroup {
+    .id        = group_id,
+    .is_active = false,
+  };
+}
 
-  NIKOLA_LOG_INFO("Resource group \'%s\' was successfully destroyed", group->name.c_str());
-  s_manager.groups.erase(group_id);
+void resource_manager_update() {
+  for(i32 type = RESOURCE_TYPE_BUFFER; type < RESOURCE_TYPES_MAX; type++) {
+    if(is_evictable_type((ResourceType)type)) {
+      enforce_budget((ResourceType)type);
+    }
+  }
+
+  s_manager.frame_index++;
+}
+
+void resources_set_memory_budget(const ResourceType type, const sizei bytes) {
+  if(!is_evictable_type(type)) {
+    NIKOLA_LOG_WARN("Memory budgets are only supported for textures, meshes, and audio buffers");
+    return;
+  }
+
+  s_manager.budgets[type] = bytes;
+}
+
+const sizei resources_get_memory_budget(const ResourceType type) {
+  return s_manager.budgets[type];
+}
+
+ResourceMemoryInfo resources_get_memory_info(const ResourceGroupID& group_id) {
+  GROUP_CHECK(group_id);
+  return get_group(group_id)->memory_info;
+}
+
+ResourceMemoryInfo resources_get_memory_info() {
+  ResourceMemoryInfo info = {};
+
+  for(auto& group : s_manager.groups) {
+    if(!group.is_active) {
+      continue;
+    }
+
+    for(sizei i = 0; i < RESOURCE_TYPES_MAX; i++) {
+      info.cpu_bytes[i]       += group.memory_info.cpu_bytes[i];
+      info.gpu_bytes[i]       += group.memory_info.gpu_bytes[i];
+      info.resources_count[i] += group.memory_info.resources_count[i];
+    }
+  }
+
+  return info;
+}
+
+void resources_acquire(const ResourceID& id) {
+  ResourceSlot* slot = find_slot(id);
+  if(!slot) {
+    NIKOLA_LOG_WARN("Cannot acquire an invalid or stale resource");
+    return;
+  }
+
+  slot->ref_count++;
+}
+
+void resources_release(const ResourceID& id) {
+  ResourceSlot* slot = find_slot(id);
+  if(!slot || slot->ref_count == 0) {
+    return;
+  }
+
+  slot->ref_count--;
+}
+
+bool resources_is_valid(const ResourceID& id) {
+  return find_slot(id) != nullptr;
+}
+
+const u32 resources_get_ref_count(const ResourceID& id) {
+  ResourceSlot* slot = find_slot(id);
+  return slot ? slot->ref_count : 0;
 }
 
 ResourceID resources_push_buffer(const ResourceGroupID& group_id, const GfxBufferDesc& buff_desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create the buffer
 
@@ -822,8 +1582,17 @@ ResourceID resources_push_buffer(const ResourceGroupID& group_id, const GfxBuffe
   PUSH_RESOURCE(group, buffers, buffer, RESOURCE_TYPE_BUFFER, id);
 
   // Load the buffer's data
+  
   gfx_buffer_load(buffer, buff_desc);
 
+  // Stream buffers keep a region for each frame in flight
+  
+  sizei gpu_size = buff_desc.size;
+  if(buff_desc.usage == GFX_BUFFER_USAGE_STREAM) {
+    gpu_size *= STREAM_BUFFER_REGIONS_MAX;
+  }
+  track_memory(group, id, 0, gpu_size);
+
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed buffer:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Size = %zu", buff_desc.size);
   NIKOLA_LOG_DEBUG("     Type = %s", buffer_type_str(buff_desc.type));
@@ -832,7 +1601,7 @@ ResourceID resources_push_buffer(const ResourceGroupID& group_id, const GfxBuffe
 
 ResourceID resources_push_texture(const ResourceGroupID& group_id, const GfxTextureDesc& desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create and push the texture
   
@@ -842,6 +1611,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id, const GfxText
   PUSH_RESOURCE(group, textures, texture, RESOURCE_TYPE_TEXTURE, id);
   
   gfx_texture_load(texture, desc);
+  track_memory(group, id, 0, texture_memory_size(texture));
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed texture:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Size = %i X %i", desc.width, desc.height);
@@ -851,7 +1621,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id, const GfxText
 
 ResourceID resources_push_texture(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create the texture
  
@@ -864,12 +1634,14 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id, const FilePat
   group->named_ids[filepath_stem(nbr_path)] = id;
   
   load_texture_nbr(group, texture, nbr_path);
+  track_memory(group, id, 0, texture_memory_size(texture));
+
   return id;
 }
 
 ResourceID resources_push_texture(const ResourceGroupID& group_id, const MaterialTextureType& type) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   GfxTextureDesc tex_desc = {
     .width  = 16, 
@@ -921,7 +1693,7 @@ ResourceID resources_push_texture(const ResourceGroupID& group_id, const Materia
 
 ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const GfxCubemapDesc& cubemap_desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create and push the cubemap
   
@@ -931,7 +1703,9 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const GfxCube
   PUSH_RESOURCE(group, cubemaps, cubemap, RESOURCE_TYPE_CUBEMAP, id);
  
   // Load the cubemap's data
+  
   gfx_cubemap_load(cubemap, cubemap_desc); 
+  track_memory(group, id, 0, cubemap_memory_size(cubemap));
   
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed cubemap:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Size  = %i X %i", cubemap_desc.width, cubemap_desc.height);
@@ -941,7 +1715,7 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const GfxCube
 
 ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create the cubemap
   
@@ -954,12 +1728,14 @@ ResourceID resources_push_cubemap(const ResourceGroupID& group_id, const FilePat
   group->named_ids[filepath_stem(nbr_path)] = id;
 
   load_cubemap_nbr(group, cubemap, nbr_path); 
+  track_memory(group, id, 0, cubemap_memory_size(cubemap));
+
   return id;
 }
 
 ResourceID resources_push_shader(const ResourceGroupID& group_id, const GfxShaderDesc& shader_desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create and load the shader
   
@@ -984,7 +1760,7 @@ ResourceID resources_push_shader(const ResourceGroupID& group_id, const GfxShade
 
 ResourceID resources_push_shader(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create and load the shader
   
@@ -1003,7 +1779,7 @@ ResourceID resources_push_shader(const ResourceGroupID& group_id, const FilePath
 
 ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const ResourceID& shader_id) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
   
   // Allocate the context
   
@@ -1014,6 +1790,7 @@ ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const
   
   ResourceID id; 
   PUSH_RESOURCE(group, shader_contexts, ctx, RESOURCE_TYPE_SHADER_CONTEXT, id);
+  add_dependency(group, id, shader_id);
 
   // Query the shader for uniform information
 
@@ -1026,7 +1803,7 @@ ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const
       continue;
     }
     
-    ctx->uniforms_cache[uniform->name] = uniform->location;
+    shader_context_cache_uniform(ctx, uniform->name);
   }
 
   // New context added!
@@ -1040,7 +1817,7 @@ ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const
 
 ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const FilePath& shader_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
  
   // Get the shader first
   ResourceID shader_id = resources_push_shader(group_id, shader_path);
@@ -1051,7 +1828,7 @@ ResourceID resources_push_shader_context(const ResourceGroupID& group_id, const
 
 ResourceID resources_push_mesh(const ResourceGroupID& group_id, NBRMesh& nbr_mesh) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Allocate and load the mesh
   
@@ -1062,6 +1839,7 @@ ResourceID resources_push_mesh(const ResourceGroupID& group_id, NBRMesh& nbr_mes
   
   ResourceID id; 
   PUSH_RESOURCE(group, meshes, mesh, RESOURCE_TYPE_MESH, id);
+  track_mesh_memory(group, id, mesh);
   
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed mesh:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Vertices = %zu", mesh->vertices.size());
@@ -1071,17 +1849,19 @@ ResourceID resources_push_mesh(const ResourceGroupID& group_id, NBRMesh& nbr_mes
 
 ResourceID resources_push_mesh(const ResourceGroupID& group_id, const GeometryType type, const String& name) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
   
   // Allocate and load the mesh
   
   Mesh* mesh = new Mesh{};
   geometry_loader_load(mesh->vertices, mesh->indices, type);
+  compute_mesh_bounds(mesh, geometry_vertex_stride(type));
 
   // New mesh added!
   
   ResourceID id; 
   PUSH_RESOURCE(group, meshes, mesh, RESOURCE_TYPE_MESH, id);
+  track_mesh_memory(group, id, mesh);
 
   // Some useful info dump
 
@@ -1103,7 +1883,7 @@ ResourceID resources_push_mesh(const ResourceGroupID& group_id, const GeometryTy
 
 ResourceID resources_push_material(const ResourceGroupID& group_id, const MaterialDesc& desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
   
   // Allocate the material
   Material* material = new Material{};
@@ -1159,6 +1939,14 @@ ResourceID resources_push_material(const ResourceGroupID& group_id, const Materi
   ResourceID id;
   PUSH_RESOURCE(group, materials, material, RESOURCE_TYPE_MATERIAL, id);
 
+  // The material holds on to its textures
+
+  add_dependency(group, id, desc.albedo_id);
+  add_dependency(group, id, desc.roughness_id);
+  add_dependency(group, id, desc.metallic_id);
+  add_dependency(group, id, desc.normal_id);
+  add_dependency(group, id, desc.emissive_id);
+
   // New material added
   
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed material:", group->name.c_str());
@@ -1179,7 +1967,7 @@ ResourceID resources_push_material(const ResourceGroupID& group_id, const Materi
 ResourceID resources_push_skybox(const ResourceGroupID& group_id, const ResourceID& cubemap_id, const String& name) {
   NIKOLA_ASSERT(RESOURCE_IS_VALID(cubemap_id), "Cannot push a new skybox with an invalid cubemap");
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Allocate and load the skybox
 
@@ -1195,6 +1983,9 @@ ResourceID resources_push_skybox(const ResourceGroupID& group_id, const Resource
   
   ResourceID id;
   PUSH_RESOURCE(group, skyboxes, skybox, RESOURCE_TYPE_SKYBOX, id);
+  
+  add_dependency(group, id, cubemap_id);
+  track_memory(group, id, skybox->vertices.size() * sizeof(f32), 0);
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed skybox:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Vertices = %zu", skybox->vertices.size());
@@ -1216,14 +2007,15 @@ ResourceID resources_push_skybox(const ResourceGroupID& group_id, const FilePath
 
 ResourceID resources_push_model(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Allocate the model
   Model* model = new Model{};
 
   // Load the NBR data into the model
   
-  if(!load_model_nbr(group, model, nbr_path)) {
+  DynamicArray<ResourceID> deps;
+  if(!load_model_nbr(group, model, nbr_path, deps)) {
     delete model;
     NIKOLA_LOG_ERROR("Failed to load NBR model file at \'%s\'", nbr_path.c_str());
 
@@ -1235,6 +2027,12 @@ ResourceID resources_push_model(const ResourceGroupID& group_id, const FilePath&
   ResourceID id;
   PUSH_RESOURCE(group, models, model, RESOURCE_TYPE_MODEL, id);
 
+  // The model holds on to its meshes and materials
+  
+  for(auto& dep : deps) {
+    add_dependency(group, id, dep);
+  }
+
   group->named_ids[filepath_stem(nbr_path)] = id;
 
   return id;
@@ -1242,7 +2040,7 @@ ResourceID resources_push_model(const ResourceGroupID& group_id, const FilePath&
 
 ResourceID resources_push_skeleton(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Load the NBR data into the skeleton
 
@@ -1284,7 +2082,7 @@ ResourceID resources_push_skeleton(const ResourceGroupID& group_id, const FilePa
 
 ResourceID resources_push_animation(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Load the NBR data into the animation
 
@@ -1298,22 +2096,7 @@ ResourceID resources_push_animation(const ResourceGroupID& group_id, const FileP
   Animation* anim = animation_create(nbr_anim);
   
   // Free the NBR data
-  
-  for(u16 i = 0; i < nbr_anim.tracks_count; i++) {
-    if(nbr_anim.tracks[i].position_samples) {
-      memory_free(nbr_anim.tracks[i].position_samples);
-    }
-
-    if(nbr_anim.tracks[i].rotation_samples) {
-      memory_free(nbr_anim.tracks[i].rotation_samples);
-    }
-
-    if(nbr_anim.tracks[i].scale_samples) {
-      memory_free(nbr_anim.tracks[i].scale_samples);
-    }
-  } 
-
-  memory_free(nbr_anim.tracks);
+  free_animation_nbr(nbr_anim);
   
   // New animation added!
   
@@ -1334,14 +2117,15 @@ ResourceID resources_push_animation(const ResourceGroupID& group_id, const FileP
 
 ResourceID resources_push_font(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Allocate the model
   Font* font = new Font{};
 
   // Load the NBR data into the font
 
-  if(!load_font_nbr(group, font, nbr_path)) {
+  DynamicArray<ResourceID> deps;
+  if(!load_font_nbr(group, font, nbr_path, deps)) {
     delete font;
     NIKOLA_LOG_ERROR("Failed to load NBR font at \'%s\'", nbr_path.c_str());
 
@@ -1353,6 +2137,12 @@ ResourceID resources_push_font(const ResourceGroupID& group_id, const FilePath&
   ResourceID id;
   PUSH_RESOURCE(group, fonts, font, RESOURCE_TYPE_FONT, id);
   
+  // The font holds on to its glyph textures
+  
+  for(auto& dep : deps) {
+    add_dependency(group, id, dep);
+  }
+  
   group->named_ids[filepath_stem(nbr_path)] = id;
 
   return id;
@@ -1360,7 +2150,7 @@ ResourceID resources_push_font(const ResourceGroupID& group_id, const FilePath&
 
 ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const AudioBufferDesc& desc) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Create a new audio buffer
   AudioBufferID buffer = audio_buffer_create(desc);
@@ -1369,6 +2159,7 @@ ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const Au
   
   ResourceID id;
   PUSH_RESOURCE(group, audio_buffers, buffer, RESOURCE_TYPE_AUDIO_BUFFER, id);
+  track_memory(group, id, desc.size, 0);
 
   NIKOLA_LOG_DEBUG("Group \'%s\' pushed an audio buffer:", group->name.c_str());
   NIKOLA_LOG_DEBUG("     Format      = %s", audio_format_str(desc.format));
@@ -1380,7 +2171,7 @@ ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const Au
 
 ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const FilePath& nbr_path) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
 
   // Load the NBR data into the audio buffer
 
@@ -1394,13 +2185,16 @@ ResourceID resources_push_audio_buffer(const ResourceGroupID& group_id, const Fi
  
   ResourceID id = resources_push_audio_buffer(group_id, desc);
   group->named_ids[filepath_stem(nbr_path)] = id;
+
+  // Free the NBR data
+  memory_free(desc.data);
   
   return id;
 }
 
 void resources_push_dir(const ResourceGroupID& group_id, const FilePath& dir, const bool async) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
  
   // Retrieve all of the paths
   filesystem_directory_iterate(filepath_append(group->parent_dir, dir), resource_entry_iterate, group);
@@ -1408,7 +2202,7 @@ void resources_push_dir(const ResourceGroupID& group_id, const FilePath& dir, co
 
 ResourceID& resources_get_id(const ResourceGroupID& group_id, const nikola::String& filename) {
   GROUP_CHECK(group_id);
-  ResourceGroup* group = &s_manager.groups[group_id];
+  ResourceGroup* group = get_group(group_id);
  
   // The resource was not found
   
@@ -1421,67 +2215,67 @@ ResourceID& resources_get_id(const ResourceGroupID& group_id, const nikola::Stri
 }
 
 GfxBuffer* resources_get_buffer(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->buffers, RESOURCE_TYPE_BUFFER);
 }
 
 GfxTexture* resources_get_texture(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->textures, RESOURCE_TYPE_TEXTURE);
 }
 
 GfxCubemap* resources_get_cubemap(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->cubemaps, RESOURCE_TYPE_CUBEMAP);
 }
 
 GfxShader* resources_get_shader(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->shaders, RESOURCE_TYPE_SHADER);
 }
 
 ShaderContext* resources_get_shader_context(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->shader_contexts, RESOURCE_TYPE_SHADER_CONTEXT);
 }
 
 Mesh* resources_get_mesh(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->meshes, RESOURCE_TYPE_MESH);
 }
 
 Material* resources_get_material(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->materials, RESOURCE_TYPE_MATERIAL);
 }
 
 Skybox* resources_get_skybox(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->skyboxes, RESOURCE_TYPE_SKYBOX);
 }
 
 Model* resources_get_model(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->models, RESOURCE_TYPE_MODEL);
 }
 
 Skeleton* resources_get_skeleton(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->skeletons, RESOURCE_TYPE_SKELETON);
 }
 
 Animation* resources_get_animation(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->animations, RESOURCE_TYPE_ANIMATION);
 }
 
 Font* resources_get_font(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->fonts, RESOURCE_TYPE_FONT);
 }
 
 AudioBufferID resources_get_audio_buffer(const ResourceID& id) {
-  ResourceGroup* group = &s_manager.groups[id.group];
+  ResourceGroup* group = get_group(id.group);
   return get_resource(id, group->audio_buffers, RESOURCE_TYPE_AUDIO_BUFFER);
 }
 
@@ -1,13 +1,45 @@
 #include "nikola/nikola_thread.h"
 
+#include <atomic>
+
 //////////////////////////////////////////////////////////////////////////
 
 namespace nikola { // Start of nikola
 
+/// ----------------------------------------------------------------------
+/// Consts
+
+/// The amount of times an idle worker checks the queue again 
+/// before going to sleep.
+const sizei WORKER_SPIN_COUNT = 64;
+
+/// Consts
+/// ----------------------------------------------------------------------
+
+/// ----------------------------------------------------------------------
+/// Private functions
+
+static void wake_workers(ThreadPool& pool) {
+  // @NOTE: Taking the lock here (even for nothing) makes sure that a worker is 
+  // either still checking the queue or already asleep. Otherwise, a task 
+  // enqueued right between the two would never wake anyone up.
+
+  {
+    std::lock_guard<std::mutex> lock(pool.wait_mutex);
+  }
+
+  pool.wait_condition.notify_all();
+}
+
+/// Private functions
+/// ----------------------------------------------------------------------
+
 /// ----------------------------------------------------------------------
 /// Callbacks
 
 static void worker_callback(ThreadPool* pool, const sizei worker_index) {
+  sizei spins = 0;
+
   while(true) {
     if(!pool->is_active) { // Not working anymore! Go back home...
       break;
@@ -20,7 +52,29 @@ static void worker_callback(ThreadPool* pool, const sizei worker_index) {
 
     if(found_task) { // Found one! Have at it...
       func();
+      spins = 0;
+
+      continue;
+    }
+
+    // Give the other threads a chance for a little bit, since 
+    // tasks usually come in bursts...
+
+    if(spins < WORKER_SPIN_COUNT) {
+      std::this_thread::yield();
+      spins++;
+
+      continue;
     }
+
+    // ...and then just go to sleep until more work comes in
+
+    std::unique_lock<std::mutex> lock(pool->wait_mutex);
+    pool->wait_condition.wait(lock, [pool]() {
+      return !pool->is_active || pool->tasks.size_approx() > 0;
+    });
+
+    spins = 0;
   }
 
   // Worker done...
@@ -52,6 +106,8 @@ void thread_pool_destroy(ThreadPool& pool) {
   // done so that we can get rid of them.
 
   pool.is_active = false;
+  wake_workers(pool);
+
   for(auto& worker : pool.workers) {
     worker->join(); 
     delete worker;
@@ -60,12 +116,63 @@ void thread_pool_destroy(ThreadPool& pool) {
 
 void thread_pool_push_task(ThreadPool& pool, const ThreadTaskFn& task) {
   pool.tasks.enqueue(task);
+  wake_workers(pool);
 }
 
 const sizei thread_pool_get_approx_size(const ThreadPool& pool) {
   return pool.tasks.size_approx();
 }
 
+void thread_pool_parallel_for(ThreadPool& pool, const sizei count, const sizei chunk_size, const ThreadRangeFn& task) {
+  if(count == 0) {
+    return;
+  }
+
+  sizei chunk        = (chunk_size > 0) ? chunk_size : 1;
+  sizei chunks_count = (count + chunk - 1) / chunk;
+
+  // Not worth going wide...
+
+  if(pool.workers.empty() || chunks_count == 1) {
+    task(0, count);
+    return;
+  }
+
+  // Hand out every chunk but the first one to the workers
+
+  std::atomic<sizei> chunks_left = chunks_count;
+
+  for(sizei i = 1; i < chunks_count; i++) {
+    sizei begin = i * chunk;
+    sizei end   = (begin + chunk) < count ? (begin + chunk) : count;
+
+    pool.tasks.enqueue([&task, &chunks_left, begin, end]() {
+      task(begin, end);
+      chunks_left.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  wake_workers(pool);
+
+  // The calling thread takes the first chunk...
+
+  task(0, chunk);
+  chunks_left.fetch_sub(1, std::memory_order_release);
+
+  // ...and then helps out with whatever is left, since 
+  // everything references this stack frame.
+
+  while(chunks_left.load(std::memory_order_acquire) > 0) {
+    ThreadTaskFn func;
+
+    if(pool.tasks.try_dequeue(func)) {
+      func();
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+}
+
 /// ThreadPool functions
 /// ----------------------------------------------------------------------
 
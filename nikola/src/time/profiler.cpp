@@ -0,0 +1,248 @@
+#include "nikola/nikola_timer.h"
+#include "nikola/nikola_base.h"
+#include "nikola/nikola_file.h"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace nikola { // Start of nikola
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Consts
+
+/// The maximum depth of nested zones the profiler can keep track of.
+const sizei PROFILER_STACK_MAX = 32;
+
+/// Consts
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// ProfilerStackEntry
+struct ProfilerStackEntry {
+  sizei zone_index;
+  std::chrono::high_resolution_clock::time_point start;
+};
+/// ProfilerStackEntry
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler
+struct Profiler {
+  ProfilerFrame frames[PROFILER_FRAMES_MAX];
+  sizei frames_head  = 0; // The index of the oldest frame
+  sizei frames_count = 0;
+
+  ProfilerFrame current_frame;
+  std::chrono::high_resolution_clock::time_point frame_start;
+  sizei frame_allocations = 0;
+
+  ProfilerStackEntry stack[PROFILER_STACK_MAX];
+  sizei stack_count = 0;
+
+  // @NOTE: Any thread can check these (zones might be opened from worker threads), 
+  // while only the recording thread writes them.
+
+  std::atomic<std::thread::id> recording_thread;
+  std::atomic<bool> is_recording = false;
+};
+
+static Profiler s_profiler;
+/// Profiler
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Private functions
+
+static bool can_record() {
+  return s_profiler.is_recording.load(std::memory_order_acquire) && 
+         (std::this_thread::get_id() == s_profiler.recording_thread.load(std::memory_order_relaxed));
+}
+
+static sizei find_or_add_zone(const char* name) {
+  ProfilerFrame& frame = s_profiler.current_frame;
+
+  // Most names are string literals, so comparing the pointers first saves the `strcmp`
+
+  for(sizei i = 0; i < frame.zones_count; i++) {
+    if(frame.zones[i].name == name || std::strcmp(frame.zones[i].name, name) == 0) {
+      return i;
+    }
+  }
+
+  if(frame.zones_count >= PROFILER_ZONES_MAX) {
+    return PROFILER_ZONES_MAX;
+  }
+
+  frame.zones[frame.zones_count] = ProfilerZone {
+    .name  = name,
+    .depth = (u32)s_profiler.stack_count,
+  };
+
+  return frame.zones_count++;
+}
+
+/// Private functions
+///---------------------------------------------------------------------------------------------------------------------
+
+///---------------------------------------------------------------------------------------------------------------------
+/// Profiler functions
+
+void profiler_begin_frame() {
+  s_profiler.current_frame    = ProfilerFrame{};
+  s_profiler.stack_count      = 0;
+  s_profiler.recording_thread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+  s_profiler.is_recording.store(true, std::memory_order_release);
+
+  s_profiler.frame_start       = std::chrono::high_resolution_clock::now();
+  s_profiler.frame_allocations = memory_get_allocations_count();
+}
+
+void profiler_end_frame() {
+  if(!can_record()) {
+    return;
+  }
+
+  ProfilerFrame& frame = s_profiler.current_frame;
+
+  // Frame time
+
+  std::chrono::duration<f32, std::milli> frame_time = std::chrono::high_resolution_clock::now() - s_profiler.frame_start;
+  frame.time_ms = frame_time.count();
+
+  // Allocations
+  frame.counters[PROFILER_COUNTER_ALLOCATIONS] = memory_get_allocations_count() - s_profiler.frame_allocations;
+
+  // Push the frame into the history, overwriting the oldest frame if full
+
+  sizei index = (s_profiler.frames_head + s_profiler.frames_count) % PROFILER_FRAMES_MAX;
+  s_profiler.frames[index] = frame;
+
+  if(s_profiler.frames_count < PROFILER_FRAMES_MAX) {
+    s_profiler.frames_count++;
+  }
+  else {
+    s_profiler.frames_head = (s_profiler.frames_head + 1) % PROFILER_FRAMES_MAX;
+  }
+
+  s_profiler.is_recording.store(false, std::memory_order_release);
+}
+
+void profiler_zone_begin(const char* name) {
+  if(!can_record() || s_profiler.stack_count >= PROFILER_STACK_MAX) {
+    return;
+  }
+
+  // @NOTE: Zones that could not fit in the frame are still pushed
+  // onto the stack (with an invalid index) to keep the stack balanced.
+
+  s_profiler.stack[s_profiler.stack_count] = ProfilerStackEntry {
+    .zone_index = find_or_add_zone(name),
+    .start      = std::chrono::high_resolution_clock::now(),
+  };
+  s_profiler.stack_count++;
+}
+
+void profiler_zone_end() {
+  if(!can_record() || s_profiler.stack_count == 0) {
+    return;
+  }
+
+  s_profiler.stack_count--;
+  ProfilerStackEntry& entry = s_profiler.stack[s_profiler.stack_count];
+
+  if(entry.zone_index >= PROFILER_ZONES_MAX) {
+    return;
+  }
+
+  std::chrono::duration<f32, std::milli> zone_time = std::chrono::high_resolution_clock::now() - entry.start;
+
+  ProfilerZone& zone = s_profiler.current_frame.zones[entry.zone_index];
+  zone.time_ms      += zone_time.count();
+  zone.calls++;
+}
+
+void profiler_set_counter(const ProfilerCounter counter, const u64 value) {
+  NIKOLA_ASSERT((counter >= PROFILER_COUNTER_DRAW_CALLS && counter < PROFILER_COUNTERS_MAX),
+                "Invalid counter given to profiler_set_counter");
+
+  s_profiler.current_frame.counters[counter] = value;
+}
+
+const sizei profiler_get_frames_count() {
+  return s_profiler.frames_count;
+}
+
+const ProfilerFrame& profiler_get_frame(const sizei index) {
+  NIKOLA_ASSERT((index >= 0 && index < s_profiler.frames_count), "Invalid index given to profiler_get_frame");
+  return s_profiler.frames[(s_profiler.frames_head + index) % PROFILER_FRAMES_MAX];
+}
+
+bool profiler_dump(const String& path) {
+  File file;
+  if(!file_open(&file, path.c_str(), (i32)(FILE_OPEN_WRITE | FILE_OPEN_TRUNCATE))) {
+    NIKOLA_LOG_ERROR("Could not open the profiler dump file at \'%s\'", path.c_str());
+    return false;
+  }
+
+  const char* counter_names[PROFILER_COUNTERS_MAX] = {
+    "draw_calls",
+    "state_calls",
+    "triangles",
+    "uploaded_bytes",
+    "allocations",
+  };
+
+  String json = "{\n  \"frames\": [\n";
+  char buffer[256];
+
+  for(sizei i = 0; i < s_profiler.frames_count; i++) {
+    const ProfilerFrame& frame = profiler_get_frame(i);
+
+    // Frame time and counters
+
+    std::snprintf(buffer, sizeof(buffer), "    {\"time_ms\": %.4f", frame.time_ms);
+    json += buffer;
+
+    for(sizei j = 0; j < PROFILER_COUNTERS_MAX; j++) {
+      std::snprintf(buffer, sizeof(buffer), ", \"%s\": %llu", counter_names[j], (unsigned long long)frame.counters[j]);
+      json += buffer;
+    }
+
+    // Zones
+
+    json += ", \"zones\": [";
+    for(sizei j = 0; j < frame.zones_count; j++) {
+      const ProfilerZone& zone = frame.zones[j];
+
+      std::snprintf(buffer, sizeof(buffer), "%s{\"name\": \"%s\", \"depth\": %u, \"calls\": %u, \"time_ms\": %.4f}",
+                    (j == 0) ? "" : ", ",
+                    zone.name,
+                    zone.depth,
+                    zone.calls,
+                    zone.time_ms);
+      json += buffer;
+    }
+
+    json += (i == s_profiler.frames_count - 1) ? "]}\n" : "]},\n";
+  }
+
+  json += "  ]\n}\n";
+
+  file_write_bytes(file, json.data(), json.size());
+  file_close(file);
+
+  NIKOLA_LOG_INFO("Dumped %zu profiler frames to \'%s\'", s_profiler.frames_count, path.c_str());
+  return true;
+}
+
+/// Profiler functions
+///---------------------------------------------------------------------------------------------------------------------
+
+} // End of nikola
+
+//////////////////////////////////////////////////////////////////////////
@@ -8,6 +8,7 @@
 #include "nikola/nikola_input.h"
 #include "nikola/nikola_event.h"
 #include "nikola/nikola_entity.h"
+#include "nikola/nikola_timer.h"
 
 #include <GLFW/glfw3.h>
 
@@ -153,6 +154,8 @@ void gui_begin() {
 }
 
 void gui_end() {
+  NIKOLA_PROFILE_FUNCTION();
+
   ImGui::Render();
   ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
@@ -196,6 +199,69 @@ void gui_renderer_info() {
     renderer_set_clear_color(clear_color);
   }
 
+  // Stats
+
+  if(ImGui::CollapsingHeader("Stats")) {
+    const GfxContextStats& stats = gfx_context_get_stats(renderer_get_context());
+
+    ImGui::Text("Draw calls: %u", stats.draw_calls);
+    ImGui::Text("State calls: %u (elided = %u)", stats.state_calls, stats.elided_calls);
+    ImGui::Text("Triangles: %llu", (unsigned long long)stats.triangles);
+    ImGui::Text("Uploaded: %.2fKiB", stats.uploaded_bytes / 1024.0f);
+  }
+
+  // GPU timings
+
+  if(ImGui::CollapsingHeader("GPU Timings")) {
+    f64 total_time = 0.0;
+
+    if(ImGui::BeginTable("GPU Timings", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+      ImGui::TableSetupColumn("Pass");
+      ImGui::TableSetupColumn("Time (ms)");
+      ImGui::TableHeadersRow();
+
+      // Render passes
+
+      for(sizei i = 0; i < RENDER_PASSES_MAX; i++) {
+        RenderPass* pass = renderer_peek_pass(i);
+        if(!pass->gpu_timer) {
+          continue;
+        }
+
+        f64 pass_time = gfx_query_get_elapsed(pass->gpu_timer);
+        total_time   += pass_time;
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", pass->debug_name.c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", pass_time);
+      }
+
+      // Batch and UI renderers
+
+      f64 batch_time = batch_renderer_get_gpu_time();
+      f64 ui_time    = ui_renderer_get_gpu_time();
+      total_time    += batch_time + ui_time;
+
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("Batch renderer");
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", batch_time);
+      
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("UI renderer");
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", ui_time);
+
+      ImGui::EndTable();
+    }
+
+    ImGui::Text("Total: %.3fms", total_time);
+  }
+
   gui_end_panel();
 }
 
@@ -251,6 +317,55 @@ void gui_debug_info() {
   ImGui::Text("FPS: %.3lf", niclock_get_fps());
   ImGui::Separator();
 
+  // Profiler
+
+  if(ImGui::CollapsingHeader("Profiler") && profiler_get_frames_count() > 0) {
+    sizei frames_count = profiler_get_frames_count();
+    
+    // Frame times graph 
+
+    f32 frame_times[PROFILER_FRAMES_MAX];
+    f32 max_time = 0.0f;
+
+    for(sizei i = 0; i < frames_count; i++) {
+      frame_times[i] = profiler_get_frame(i).time_ms;
+      max_time       = max_float(max_time, frame_times[i]);
+    }
+
+    const ProfilerFrame& latest = profiler_get_frame(frames_count - 1);
+    String overlay              = std::to_string(latest.time_ms) + "ms";
+
+    ImGui::PlotLines("Frame time", frame_times, (i32)frames_count, 0, overlay.c_str(), 0.0f, max_time, ImVec2(0.0f, 80.0f));
+    ImGui::Text("Allocations: %llu", (unsigned long long)latest.counters[PROFILER_COUNTER_ALLOCATIONS]);
+
+    // Zones of the latest frame
+
+    if(ImGui::BeginTable("Zones", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+      ImGui::TableSetupColumn("Zone");
+      ImGui::TableSetupColumn("Calls");
+      ImGui::TableSetupColumn("Time (ms)");
+      ImGui::TableHeadersRow();
+
+      for(sizei i = 0; i < latest.zones_count; i++) {
+        const ProfilerZone& zone = latest.zones[i];
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%*s%s", (i32)(zone.depth * 2), "", zone.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", zone.calls);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", zone.time_ms);
+      }
+
+      ImGui::EndTable();
+    }
+
+    if(ImGui::Button("Dump")) {
+      profiler_dump("profiler_dump.json");
+    }
+  }
+
   // Mouse
  
   if(ImGui::CollapsingHeader("Mouse")) {
@@ -656,7 +771,7 @@ void gui_edit_timer(const char* name, Timer* timer) {
   ImGui::PopID(); 
 }
 
-void gui_edit_physics_body(const char* name, PhysicsBody* body) {
+void gui_edit_physics_body(const char* name, const PhysicsBodyID& body) {
   ImGui::SeparatorText(name); 
   ImGui::PushID(name); 
  
@@ -935,9 +1050,9 @@ void gui_edit_entity(const char* name, EntityWorld& world, EntityID& entt) {
   
   // Animation sampler 
 
-  if(entity_has_component<AnimationSampler*>(world, entt)) {
+  if(entity_has_component<AnimationSamplerComponent>(world, entt)) {
     if(ImGui::TreeNode("Animation sampler")) {
-      AnimationSampler* sampler = entity_get_component<AnimationSampler*>(world, entt);
+      AnimationSampler* sampler = entity_get_animation_sampler(world, entt);
       gui_edit_animation_sampler("", sampler);
 
       ImGui::TreePop();
@@ -946,9 +1061,9 @@ void gui_edit_entity(const char* name, EntityWorld& world, EntityID& entt) {
   
   // Animation blender 
 
-  if(entity_has_component<AnimationBlender*>(world, entt)) {
+  if(entity_has_component<AnimationBlenderComponent>(world, entt)) {
     if(ImGui::TreeNode("Animation blender")) {
-      AnimationBlender* blender = entity_get_component<AnimationBlender*>(world, entt);
+      AnimationBlender* blender = entity_get_animation_blender(world, entt);
       gui_edit_animation_blender("", blender);
 
       ImGui::TreePop();
@@ -122,6 +122,7 @@ nikola::App* app_init(const nikola::Args& args, nikola::Window* window) {
 }
 
 void app_shutdown(nikola::App* app) {
+  nikola::particle_emitter_destroy(app->particle_emitter);
   nikola::resources_destroy_group(app->res_group_id);
   nikola::gui_shutdown();
 
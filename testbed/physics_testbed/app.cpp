@@ -22,7 +22,7 @@ struct nikola::App {
   nikola::ResourceID materials[2];
   nikola::Font* font;
 
-  nikola::PhysicsBody* tiles[TILES_MAX];
+  nikola::PhysicsBodyID tiles[TILES_MAX];
   nikola::Transform transforms[TILES_MAX];
 
   nikola::Character* cube_body;
@@ -81,6 +81,8 @@ static void init_bodies_slow(nikola::App* app) {
       .layers = nikola::PHYSICS_OBJECT_LAYER_0,
 
       .collider = nikola::collider_create(coll_desc),
+
+      .has_contact_events = true,
     };
     app->tiles[i] = nikola::physics_world_create_and_add_body(body_desc);
 
@@ -125,6 +127,8 @@ static void init_bodies_fast(nikola::App* app) {
       .layers = nikola::PHYSICS_OBJECT_LAYER_0,
 
       .collider = nikola::collider_create(coll_desc),
+
+      .has_contact_events = true,
     };
     app->tiles[i] = nikola::physics_world_create_body(body_desc);
     
@@ -182,7 +186,7 @@ static bool on_raycast_event(const nikola::Event& event, const void* dispatcher,
 
   nikola::physics_world_set_safe_mode(false);
 
-  nikola::PhysicsBody* body  = event.cast_result.body;
+  nikola::PhysicsBodyID body = event.cast_result.body;
   nikola::Vec3 body_position = nikola::physics_body_get_position(body);
   nikola::Vec3 hit_position  = event.cast_result.point;
 